@@ -0,0 +1,132 @@
+#include "alloc_tracker.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_bytes{0};
+
+inline void record(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+}  // namespace
+
+namespace bench {
+AllocationSnapshot allocation_snapshot() {
+    return AllocationSnapshot{g_allocations.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed)};
+}
+}  // namespace bench
+
+#if defined(__GLIBC__)
+// glibc 中 `operator new` 最终调用 `malloc`，带对齐参数的 `operator new` 调用 `aligned_alloc`，替换 malloc 系列
+// 与对齐分配函数即可同时统计 C 与 C++ 的分配
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(size_t size) {
+    record(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    record(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    record(size);
+    return __libc_realloc(ptr, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    record(size);
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    record(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **out, size_t alignment, size_t size) {
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0) {
+        return EINVAL;
+    }
+    record(size);
+    void *ptr = __libc_memalign(alignment, size);
+    if (ptr == nullptr) {
+        return ENOMEM;
+    }
+    *out = ptr;
+    return 0;
+}
+
+void *valloc(size_t size) {
+    record(size);
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size) {
+    record(size);
+    return __libc_pvalloc(size);
+}
+
+void free(void *ptr) { __libc_free(ptr); }
+}
+#else
+void *operator new(size_t size) {
+    record(size);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    record(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+
+// 带对齐参数的版本（超过 `__STDCPP_DEFAULT_NEW_ALIGNMENT__` 的类型），`aligned_alloc` 要求大小是对齐的整数倍
+void *operator new(size_t size, std::align_val_t alignment) {
+    record(size);
+    auto align = static_cast<size_t>(alignment);
+    size_t rounded = (size + align - 1) / align * align;
+    if (void *ptr = std::aligned_alloc(align, rounded == 0 ? align : rounded)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    try {
+        return operator new(size, alignment);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &tag) noexcept {
+    return operator new(size, alignment, tag);
+}
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+#endif
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace bench {
+
+// 自进程启动以来的内存分配次数与请求字节数（所有线程合计）
+struct AllocationSnapshot {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * @brief 获取当前的内存分配计数。
+ *
+ * 计数由 alloc_tracker.cpp 中替换的 `malloc`/`calloc`/`realloc` 与 `aligned_alloc`/`memalign`/`posix_memalign`
+ * 等对齐分配函数（glibc），或全局 `operator new` 的所有版本（其他平台，包括带 `std::align_val_t` 的版本）累加，
+ * 因此需要将 alloc_tracker.cpp 链接到可执行文件中。
+ */
+AllocationSnapshot allocation_snapshot();
+
+}  // namespace bench
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "alloc_tracker.h"
+#include "perf_counters.h"
+
+namespace bench {
+
+/**
+ * @brief 阻止编译器将基准测试中计算得到但未使用的结果优化掉。
+ */
+template <typename T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// 单个基准测试用例：`body` 执行一轮工作并返回这一轮完成的操作数，`unit` 为操作的单位（例如 point、segment）
+struct Case {
+    std::string name;
+    std::function<size_t()> body;
+    std::string unit;
+    double max_allocs_per_op = -1.;  // 每个操作允许的内存分配次数，负数表示使用 `--max-allocs` 的默认值
+
+    // 设置每个操作允许的内存分配次数，热路径上新增的分配会在 `--check-allocs` 时导致失败
+    Case &allocs(double limit) {
+        max_allocs_per_op = limit;
+        return *this;
+    }
+};
+
+// 单个用例的测量结果
+struct Result {
+    std::string name;
+    std::string unit;
+    size_t runs = 0;     // 执行 `body` 的轮数
+    size_t ops = 0;      // 总操作数
+    double seconds = 0;  // 总耗时
+    uint64_t allocations = 0;  // 测量期间所有线程的内存分配次数
+    uint64_t allocated_bytes = 0;  // 测量期间所有线程请求分配的字节数
+    std::vector<PerfCounters::Reading> counters;  // 性能计数器读数（总量），未开启时为空
+
+    // 每个操作的计数器读数，计数器不可用时返回负数
+    double counter_per_op(const std::string &counter) const {
+        for (const auto &reading : counters) {
+            if (reading.name == counter) {
+                return reading.available && ops > 0 ? reading.value / ops : -1.;
+            }
+        }
+        return -1.;
+    }
+
+    // 每周期指令数，计数器不可用时返回负数
+    double ipc() const {
+        double cycles = counter_per_op("cycles"), instructions = counter_per_op("instructions");
+        return cycles > 0. && instructions >= 0. ? instructions / cycles : -1.;
+    }
+
+    double ns_per_op() const { return ops == 0 ? 0. : seconds * 1e9 / ops; }
+    double allocs_per_op() const { return ops == 0 ? 0. : static_cast<double>(allocations) / ops; }
+    double bytes_per_op() const { return ops == 0 ? 0. : static_cast<double>(allocated_bytes) / ops; }
+    double ops_per_second() const { return seconds == 0. ? 0. : ops / seconds; }
+};
+
+/**
+ * @brief 基准测试套件。
+ *
+ * 每个用例先执行一轮预热，然后重复执行直到累计耗时超过 `--min-time`，按操作数给出平均耗时、
+ * 平均内存分配次数和分配字节数（预热轮中的一次性初始化不计入）。
+ * 命令行参数：
+ *   --filter=<子串>     只运行名称包含该子串的用例
+ *   --min-time=<秒>     每个用例的最短测量时间，默认 0.2 秒
+ *   --json=<路径>       将结果以 JSON 格式写入文件
+ *   --perf              同时记录硬件性能计数器，并按操作数折算
+ *   --check-allocs      检查每个用例的分配次数上限（见 `Case::allocs`），超出时返回非零值
+ *   --max-allocs=<次数> 未设置上限的用例使用的默认上限，同时开启检查
+ *   --list              只列出用例名称
+ */
+class Suite {
+public:
+    /**
+     * @brief 注册一个用例。
+     *
+     * @return 用例的引用，可以继续设置分配次数上限，例如 `suite.add(...).allocs(0)`。
+     */
+    Case &add(std::string name, std::function<size_t()> body, std::string unit = "op") {
+        cases_.push_back({std::move(name), std::move(body), std::move(unit)});
+        return cases_.back();
+    }
+
+    int run(int argc, char **argv) {
+        std::string filter, json_path;
+        double min_time = 0.2, default_max_allocs = -1.;
+        bool list = false, perf = false, check_allocs = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--filter=", 0) == 0) {
+                filter = arg.substr(9);
+            } else if (arg.rfind("--min-time=", 0) == 0) {
+                min_time = std::stod(arg.substr(11));
+            } else if (arg.rfind("--json=", 0) == 0) {
+                json_path = arg.substr(7);
+            } else if (arg == "--perf") {
+                perf = true;
+            } else if (arg == "--check-allocs") {
+                check_allocs = true;
+            } else if (arg.rfind("--max-allocs=", 0) == 0) {
+                default_max_allocs = std::stod(arg.substr(13));
+                check_allocs = true;
+            } else if (arg == "--list") {
+                list = true;
+            } else {
+                std::cerr << "unknown argument: " << arg << std::endl;
+                return 2;
+            }
+        }
+
+        std::unique_ptr<PerfCounters> counters;
+        if (perf && !list) {
+            counters = std::make_unique<PerfCounters>();
+            if (!counters->hardware_available()) {
+                std::cerr << "hardware performance counters are not available, only software counters are recorded"
+                          << std::endl;
+            }
+        }
+
+        std::vector<Result> results;
+        size_t failures = 0;
+        if (!list) {
+            std::printf("%-40s %10s %12s %14s %16s %12s %12s\n", "benchmark", "unit", "runs", "ns/op", "ops/s",
+                        "allocs/op", "bytes/op");
+        }
+        for (const auto &c : cases_) {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            if (list) {
+                std::cout << c.name << std::endl;
+                continue;
+            }
+            results.push_back(measure(c, min_time, counters.get()));
+            const auto &r = results.back();
+            std::printf("%-40s %10s %12zu %14.1f %16.0f %12.3g %12.3g\n", r.name.c_str(), r.unit.c_str(), r.runs,
+                        r.ns_per_op(), r.ops_per_second(), r.allocs_per_op(), r.bytes_per_op());
+            if (counters) {
+                print_counters(r);
+            }
+            double limit = c.max_allocs_per_op >= 0. ? c.max_allocs_per_op : default_max_allocs;
+            if (check_allocs && limit >= 0. && r.allocs_per_op() > limit) {
+                std::printf("    FAIL: %.3g allocations per %s exceeds the limit of %.3g\n", r.allocs_per_op(),
+                            r.unit.c_str(), limit);
+                ++failures;
+            }
+            std::fflush(stdout);
+        }
+
+        if (!json_path.empty()) {
+            write_json(json_path, results);
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+private:
+    static Result measure(const Case &c, double min_time, PerfCounters *counters) {
+        do_not_optimize(c.body());  // 预热
+
+        Result result;
+        result.name = c.name;
+        result.unit = c.unit;
+        if (counters) {
+            counters->start();
+        }
+        auto allocations = allocation_snapshot();
+        auto start = std::chrono::steady_clock::now();
+        do {
+            result.ops += c.body();
+            ++result.runs;
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (result.seconds < min_time);
+        auto end_allocations = allocation_snapshot();
+        if (counters) {
+            result.counters = counters->stop();
+        }
+        result.allocations = end_allocations.allocations - allocations.allocations;
+        result.allocated_bytes = end_allocations.bytes - allocations.bytes;
+        return result;
+    }
+
+    static void print_counters(const Result &r) {
+        std::printf("    ");
+        for (const auto &reading : r.counters) {
+            double per_op = r.counter_per_op(reading.name);
+            if (per_op >= 0.) {
+                std::printf(" %s/%s=%.2f", reading.name.c_str(), r.unit.c_str(), per_op);
+            } else {
+                std::printf(" %s/%s=n/a", reading.name.c_str(), r.unit.c_str());
+            }
+        }
+        if (r.ipc() >= 0.) {
+            std::printf(" ipc=%.2f", r.ipc());
+        }
+        std::printf("\n");
+    }
+
+    static void write_json(const std::string &path, const std::vector<Result> &results) {
+        std::ofstream out(path);
+        out << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto &r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"unit\": \"" << r.unit << "\", \"runs\": " << r.runs
+                << ", \"ops\": " << r.ops << ", \"seconds\": " << r.seconds << ", \"ns_per_op\": " << r.ns_per_op()
+                << ", \"allocs_per_op\": " << r.allocs_per_op() << ", \"bytes_per_op\": " << r.bytes_per_op();
+            if (!r.counters.empty()) {
+                out << ", \"counters_per_op\": {";
+                for (size_t k = 0; k < r.counters.size(); ++k) {
+                    double per_op = r.counter_per_op(r.counters[k].name);
+                    out << (k > 0 ? ", " : "") << "\"" << r.counters[k].name << "\": ";
+                    if (per_op >= 0.) {
+                        out << per_op;
+                    } else {
+                        out << "null";
+                    }
+                }
+                out << "}, \"ipc\": ";
+                if (r.ipc() >= 0.) {
+                    out << r.ipc();
+                } else {
+                    out << "null";
+                }
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    std::deque<Case> cases_;  // 使用 deque 保证 `add` 返回的引用在继续添加用例后仍然有效
+};
+
+}  // namespace bench
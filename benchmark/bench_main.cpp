@@ -0,0 +1,991 @@
+#include <cstdio>
+#include <random>
+
+#include "bench.h"
+#include "simplegeom/buffer.h"
+#include "simplegeom/clean.h"
+#include "simplegeom/coverage.h"
+#include "simplegeom/delaunay.h"
+#include "simplegeom/hull.h"
+#include "simplegeom/kinematics.h"
+#include "simplegeom/moving_index.h"
+#include "simplegeom/polygon.h"
+#include "simplegeom/proximity.h"
+#include "simplegeom/raster.h"
+#include "simplegeom/trajectory.h"
+#include "simplegeom/trajectory_store.h"
+#include "simplegeom/simplegeom.h"
+#include "simplegeom/stay_point.h"
+#include "simplegeom/synthetic.h"
+
+using namespace simplegeom;
+
+namespace {
+
+// 基准测试共用的数据集：10km x 10km 的网格路网以及路网附近的查询点
+struct Dataset {
+    std::vector<LineString<PointGeo2>> lines;
+    std::vector<PointGeo2> queries;
+    LineString<PointGeo2> long_line;
+    LineNetwork<PointGeo2> network;
+
+    Dataset() {
+        RoadNetworkOptions options;
+        lines = generate_grid_network(options);
+        queries = generate_query_points(lines, 4096, 50.);
+
+        // 一条较长的折线，用于单条折线投影
+        options.max_line_meters = 1e9;
+        options.keep_ratio = 1.;
+        auto roads = generate_organic_network(options);
+        long_line = *std::max_element(roads.begin(), roads.end(),
+                                      [](const auto &a, const auto &b) { return a.size() < b.size(); });
+
+        network = LineNetwork<PointGeo2>(lines);
+    }
+};
+
+const Dataset &dataset() {
+    static const Dataset kDataset;
+    return kDataset;
+}
+
+// 移动对象基准测试共用的车队：10 万辆车分布在路网区域内，每次更新在初始位置附近移动
+struct Fleet {
+    static constexpr size_t kVehicles = 100000;
+
+    std::vector<PointGeo2> home;
+    MovingObjectIndex<PointGeo2> index;
+
+    Fleet() {
+        std::mt19937_64 rng(7);
+        std::uniform_real_distribution<double> lon(116.3, 116.41), lat(39.9, 39.99);
+        for (size_t i = 0; i < kVehicles; ++i) {
+            home.emplace_back(lon(rng), lat(rng));
+            index.update(i, home.back());
+        }
+    }
+
+    // 第 `step` 次更新时车辆的位置，偏离初始位置不超过约 500 米
+    PointGeo2 position(size_t id, size_t step) const {
+        double phase = static_cast<double>(step % 1024) * 0.0061 + static_cast<double>(id);
+        return PointGeo2(bg::get<0>(home[id]) + 0.005 * std::sin(phase),
+                         bg::get<1>(home[id]) + 0.004 * std::cos(phase));
+    }
+};
+
+Fleet &fleet() {
+    static Fleet kFleet;
+    return kFleet;
+}
+
+// 邻近检测基准测试的点群：密度为每平方公里 1000 个点，每个时刻沿各自的速度方向移动约 1 米
+template <typename Point>
+struct Swarm {
+    std::vector<Point> points;
+    std::vector<std::pair<double, double>> velocity;
+    double step = 0.;
+
+    Swarm(size_t n, const Point &origin, double meters_per_unit) : step(1. / meters_per_unit) {
+        std::mt19937_64 rng(3);
+        double extent = std::sqrt(static_cast<double>(n) / 1000.) * 1000. / meters_per_unit;
+        std::uniform_real_distribution<double> unit(0., 1.);
+        for (size_t i = 0; i < n; ++i) {
+            double heading = unit(rng) * 2 * M_PI;
+            points.emplace_back(bg::get<0>(origin) + unit(rng) * extent, bg::get<1>(origin) + unit(rng) * extent);
+            velocity.emplace_back(std::cos(heading) * step, std::sin(heading) * step);
+        }
+    }
+
+    void tick() {
+        for (size_t i = 0; i < points.size(); ++i) {
+            bg::set<0>(points[i], bg::get<0>(points[i]) + velocity[i].first);
+            bg::set<1>(points[i], bg::get<1>(points[i]) + velocity[i].second);
+        }
+    }
+};
+
+// 沿路网行驶的 GPS 轨迹，每条最多 600 个点，采样间隔 1 秒，所有轨迹从同一时刻出发
+const std::vector<Trajectory<PointGeo2>> &trajectories() {
+    static const auto kTrajectories = [] {
+        std::vector<Trajectory<PointGeo2>> result;
+        for (auto &trace : generate_traces(dataset().lines, 512, TraceOptions{})) {
+            result.push_back({std::move(trace.points), std::move(trace.timestamps)});
+        }
+        return result;
+    }();
+    return kTrajectories;
+}
+
+// 热力图基准测试的输入：`trajectories()` 的全部 GPS 点，以及覆盖路网的外包框
+struct HeatmapData {
+    std::vector<PointGeo2> points;
+    Box<PointGeo2> extent;
+
+    HeatmapData() {
+        for (const auto &line : trajectories()) {
+            points.insert(points.end(), line.points.begin(), line.points.end());
+        }
+        bg::envelope(dataset().lines.front(), extent);
+        for (const auto &line : dataset().lines) {
+            bg::expand(extent, bg::return_envelope<Box<PointGeo2>>(line));
+        }
+    }
+};
+
+const HeatmapData &heatmap_data() {
+    static const HeatmapData kHeatmapData;
+    return kHeatmapData;
+}
+
+// 在 `trajectories()` 中每行驶 150 秒插入一次 5 分钟的停留，停留期间在停留点附近约 20 米内抖动
+const std::vector<Trajectory<PointGeo2>> &stop_trajectories() {
+    static const auto kTrajectories = [] {
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> jitter(-0.0002, 0.0002);
+        std::vector<Trajectory<PointGeo2>> result;
+        for (const auto &line : trajectories()) {
+            Trajectory<PointGeo2> stopped;
+            double shift = 0.;
+            for (size_t i = 0; i < line.size(); ++i) {
+                stopped.points.push_back(line.points[i]);
+                stopped.timestamps.push_back(line.timestamps[i] + shift);
+                if (i % 150 != 149) {
+                    continue;
+                }
+                for (size_t k = 0; k < 300; ++k) {
+                    shift += 1.;
+                    stopped.points.emplace_back(bg::get<0>(line.points[i]) + jitter(rng),
+                                                bg::get<1>(line.points[i]) + jitter(rng));
+                    stopped.timestamps.push_back(line.timestamps[i] + shift);
+                }
+            }
+            result.push_back(std::move(stopped));
+        }
+        return result;
+    }();
+    return kTrajectories;
+}
+
+// 城市范围内的 20000 个地块：每个地块为 8～40 个顶点的星形多边形，半径 20～200 米
+struct ParcelData {
+    std::vector<Polygon<PointGeo2>> polygons;
+    size_t vertices = 0;
+
+    ParcelData() {
+        std::mt19937_64 rng(13);
+        std::uniform_real_distribution<double> unit(0., 1.);
+        for (size_t i = 0; i < 20000; ++i) {
+            double lon = 116.2 + unit(rng) * 0.4, lat = 39.8 + unit(rng) * 0.3;
+            double radius = (20. + unit(rng) * 180.) / 111000.;
+            size_t n = 8 + rng() % 33;
+            Polygon<PointGeo2> polygon;
+            for (size_t k = 0; k < n; ++k) {
+                double angle = -2 * M_PI * k / n, r = radius * (0.6 + 0.4 * unit(rng));
+                polygon.outer().emplace_back(lon + r * std::cos(angle) / std::cos(lat * M_PI / 180.),
+                                             lat + r * std::sin(angle));
+            }
+            polygon.outer().push_back(polygon.outer().front());
+            vertices += polygon.outer().size();
+            polygons.push_back(std::move(polygon));
+        }
+    }
+};
+
+const ParcelData &parcel_data() {
+    static const ParcelData kParcelData;
+    return kParcelData;
+}
+
+// 100 万个二维正态分布的点，以及 100 万个圆周上的点（都是凸包顶点，预筛选无法删除）
+const std::vector<Point2> &hull_points(bool circle = false) {
+    static const auto kPoints = [] {
+        std::mt19937_64 rng(17);
+        std::normal_distribution<double> normal(0., 1000.);
+        std::uniform_real_distribution<double> unit(0., 2 * M_PI);
+        std::vector<Point2> normal_points, circle_points;
+        for (size_t i = 0; i < 1000000; ++i) {
+            normal_points.emplace_back(normal(rng), normal(rng));
+            double angle = unit(rng);
+            circle_points.emplace_back(1000. * std::cos(angle), 1000. * std::sin(angle));
+        }
+        return std::make_pair(normal_points, circle_points);
+    }();
+    return circle ? kPoints.second : kPoints.first;
+}
+
+// 一天的轨迹数据：2048 条轨迹依次在一天中均匀错开出发，按时间顺序逐点写入，模拟实时接入
+struct StoreData {
+    std::vector<std::pair<uint64_t, size_t>> order;  // 写入顺序：(轨迹序号, 点序号)
+    std::vector<double> offsets;                      // 各轨迹的出发时刻
+    std::unique_ptr<TrajectoryStore<PointGeo2>> store;
+
+    StoreData() {
+        const auto &lines = trajectories();
+        std::vector<std::tuple<double, uint64_t, size_t>> events;
+        for (size_t k = 0; k < 2048; ++k) {
+            const auto &line = lines[k % lines.size()];
+            offsets.push_back(static_cast<double>(k) * 42.);
+            for (size_t i = 0; i < line.size(); ++i) {
+                events.emplace_back(offsets.back() + line.timestamps[i], k, i);
+            }
+        }
+        std::sort(events.begin(), events.end());
+        for (const auto &[t, k, i] : events) {
+            order.emplace_back(k, i);
+        }
+        store = std::make_unique<TrajectoryStore<PointGeo2>>();
+        append(*store, 0, order.size());
+    }
+
+    void append(TrajectoryStore<PointGeo2> &target, size_t begin, size_t end) const {
+        const auto &lines = trajectories();
+        for (size_t e = begin; e < end; ++e) {
+            auto [k, i] = order[e];
+            const auto &line = lines[k % lines.size()];
+            target.append(k, line.points[i], offsets[k] + line.timestamps[i]);
+        }
+    }
+};
+
+const StoreData &store_data() {
+    static const StoreData kStoreData;
+    return kStoreData;
+}
+
+// 缓冲区与偏移线基准测试的输入：`trajectories()` 的前 64 条轨迹，以及投影到同一局部平面（米）中的折线
+struct BufferData {
+    std::vector<LineString<PointGeo2>> lines;
+    std::vector<LineString<Point2>> metric;
+    size_t vertices = 0;
+
+    BufferData() {
+        const auto &source = trajectories();
+        std::vector<PointGeo2> all;
+        for (size_t i = 0; i < 64 && i < source.size(); ++i) {
+            lines.push_back(source[i].points);
+            all.insert(all.end(), source[i].points.begin(), source[i].points.end());
+            vertices += source[i].points.size();
+        }
+        LocalFrame<PointGeo2> frame(all);
+        for (const auto &line : lines) {
+            metric.emplace_back();
+            for (const auto &p : line) {
+                auto q = frame.to_local(p);
+                metric.back().emplace_back(q.x, q.y);
+            }
+        }
+    }
+};
+
+const BufferData &buffer_data() {
+    static const BufferData kBufferData;
+    return kBufferData;
+}
+
+// 16 × 16 个区划（含飞地）的覆盖，`metric` 为换算到同一个局部平面（米）的副本
+struct CoverageData {
+    std::vector<Polygon<PointGeo2>> polygons;
+    std::vector<Polygon<Point2>> metric;
+    size_t vertices = 0;
+
+    CoverageData() : polygons(generate_coverage(CoverageOptions{})) {
+        std::vector<PointGeo2> all;
+        for (const auto &polygon : polygons) {
+            all.insert(all.end(), polygon.outer().begin(), polygon.outer().end());
+            for (const auto &inner : polygon.inners()) {
+                all.insert(all.end(), inner.begin(), inner.end());
+            }
+        }
+        vertices = all.size();
+        LocalFrame<PointGeo2> frame(all);
+        auto convert = [&](const auto &ring, auto &out) {
+            for (const auto &p : ring) {
+                auto q = frame.to_local(p);
+                out.emplace_back(q.x, q.y);
+            }
+        };
+        for (const auto &polygon : polygons) {
+            metric.emplace_back();
+            convert(polygon.outer(), metric.back().outer());
+            for (const auto &inner : polygon.inners()) {
+                metric.back().inners().emplace_back();
+                convert(inner, metric.back().inners().back());
+            }
+        }
+    }
+};
+
+const CoverageData &coverage_data() {
+    static const CoverageData kCoverageData;
+    return kCoverageData;
+}
+
+// 路网折线的含噪副本：每条线段约每 5 米插入一个横向抖动 0.2 米以内的顶点，并以 20% 的概率重复顶点；
+// `long_line` 为 `dataset().long_line` 的含噪副本，`cleaned` 为其按 `kOptions` 清理的结果
+struct CleanData {
+    static constexpr CleanOptions kOptions{0.5, 1e-7};  // 容差 0.5 米，网格约 1 厘米
+
+    std::vector<LineString<PointGeo2>> lines;
+    LineString<PointGeo2> long_line;
+    LineString<PointGeo2> cleaned;
+    size_t vertices = 0;
+
+    CleanData() {
+        std::mt19937_64 rng(5);
+        std::uniform_real_distribution<double> jitter(-0.2, 0.2);
+        auto noisy = [&](const LineString<PointGeo2> &line) {
+            LineString<PointGeo2> result;
+            for (size_t i = 0; i + 1 < line.size(); ++i) {
+                double lon = bg::get<0>(line[i]), lat = bg::get<1>(line[i]);
+                double dlon = bg::get<0>(line[i + 1]) - lon, dlat = bg::get<1>(line[i + 1]) - lat;
+                double meters_per_lon = 111195. * std::cos(lat * M_PI / 180.);
+                double dx = dlon * meters_per_lon, dy = dlat * 111195., length = std::hypot(dx, dy);
+                auto pieces = static_cast<size_t>(std::max(1., length / 5.));
+                for (size_t k = 0; k < pieces; ++k) {
+                    double t = static_cast<double>(k) / pieces, offset = k == 0 ? 0. : jitter(rng);
+                    double nx = length > 0. ? -dy / length : 0., ny = length > 0. ? dx / length : 0.;
+                    result.emplace_back(lon + t * dlon + offset * nx / meters_per_lon,
+                                        lat + t * dlat + offset * ny / 111195.);
+                    if (rng() % 5 == 0) {
+                        result.push_back(result.back());
+                    }
+                }
+            }
+            result.push_back(line.back());
+            return result;
+        };
+        for (const auto &line : dataset().lines) {
+            lines.push_back(noisy(line));
+            vertices += lines.back().size();
+        }
+        long_line = noisy(dataset().long_line);
+        cleaned = clean_line(long_line, kOptions);
+    }
+};
+
+const CleanData &clean_data() {
+    static const CleanData kCleanData;
+    return kCleanData;
+}
+
+std::vector<Point2> random_points2(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1000.);
+    std::vector<Point2> points;
+    for (size_t i = 0; i < n; ++i) {
+        points.emplace_back(unit(rng), unit(rng));
+    }
+    return points;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    bench::Suite suite;
+
+    suite.add("distance/point2", [] {
+        static const auto points = random_points2(1024, 1);
+        for (size_t i = 0; i + 1 < points.size(); ++i) {
+            bench::do_not_optimize(simplegeom::distance(points[i], points[i + 1]));
+        }
+        return points.size() - 1;
+    }, "pair").allocs(0);
+
+    suite.add("distance/geo2_vincenty", [] {
+        const auto &queries = dataset().queries;
+        for (size_t i = 0; i + 1 < 256; ++i) {
+            bench::do_not_optimize(simplegeom::distance(queries[i], queries[i + 1]));
+        }
+        return size_t(255);
+    }, "pair").allocs(0);
+
+    suite.add("closest_point/point2", [] {
+        static const auto points = random_points2(1024, 2);
+        Segment<Point2> seg(Point2(0, 0), Point2(1000, 500));
+        for (const auto &p : points) {
+            bench::do_not_optimize(closest_point(p, seg));
+        }
+        return points.size();
+    }, "point").allocs(0);
+
+    suite.add("project/line_point2", [] {
+        static const auto queries = random_points2(64, 3);
+        static const auto line = [] {
+            LineString<Point2> l;
+            for (int i = 0; i < 1000; ++i) {
+                l.emplace_back(i, (i % 7) * 0.5);
+            }
+            return l;
+        }();
+        for (const auto &p : queries) {
+            bench::do_not_optimize(simplegeom::distance(p, line, ProjectionMode::kAccumulate));
+        }
+        return queries.size() * (line.size() - 1);
+    }, "segment").allocs(0);
+
+    // 直接在交错坐标数组上投影，不构造 `LineString`
+    suite.add("project/strided_point2", [] {
+        static const auto queries = random_points2(64, 3);
+        static const auto coords = [] {
+            std::vector<double> c;
+            for (int i = 0; i < 1000; ++i) {
+                c.push_back(i);
+                c.push_back((i % 7) * 0.5);
+            }
+            return c;
+        }();
+        auto view = StridedPointView<Point2>::interleaved(coords.data(), coords.size() / 2);
+        for (const auto &p : queries) {
+            bench::do_not_optimize(simplegeom::distance(p, view, ProjectionMode::kAccumulate));
+        }
+        return queries.size() * (view.size() - 1);
+    }, "segment").allocs(0);
+
+    suite.add("project/line_geo2", [] {
+        const auto &data = dataset();
+        for (size_t i = 0; i < 16; ++i) {
+            const auto &p = data.long_line[(i * 37) % data.long_line.size()];
+            bench::do_not_optimize(simplegeom::distance(p, data.long_line, ProjectionMode::kAccumulate));
+        }
+        return 16 * (data.long_line.size() - 1);
+    }, "segment").allocs(0);
+
+    // 同一条折线的句柄：线段索引与累积长度只计算一次
+    suite.add("project/line_handle_geo2", [] {
+        const auto &data = dataset();
+        static const LineHandle<PointGeo2> handle(data.long_line);
+        for (size_t i = 0; i < 16; ++i) {
+            const auto &p = handle[(i * 37) % handle.size()];
+            bench::do_not_optimize(simplegeom::distance(p, handle, ProjectionMode::kAccumulate));
+        }
+        return 16 * (handle.size() - 1);
+    }, "segment").allocs(0.02);  // R 树查询迭代器
+
+    // 按块读取的折线文件，一次遍历投影 256 个查询点
+    suite.add("line_file/project_batch_geo2", [] {
+        const auto &data = dataset();
+        static const auto file = [&data] {
+            std::string path = "/tmp/simplegeom_bench.line";
+            {
+                LineFileWriter<PointGeo2> writer(path, 256);
+                writer.append(data.long_line.begin(), data.long_line.end());
+            }
+            auto f = std::make_unique<LineFile<PointGeo2>>(path);
+            std::remove(path.c_str());  // 已打开的文件在关闭前仍然可以读取
+            return f;
+        }();
+        static const auto queries = [&data] {
+            std::vector<PointGeo2> points;
+            for (size_t i = 0; i < 256; ++i) {
+                points.push_back(data.long_line[(i * 37) % data.long_line.size()]);
+            }
+            return points;
+        }();
+        auto results = file->project(queries, ProjectionMode::kAccumulate);
+        bench::do_not_optimize(results.data());
+        return results.size();
+    }, "point");
+
+    suite.add("network/project_geo2", [] {
+        const auto &data = dataset();
+        for (size_t i = 0; i < 64; ++i) {
+            bench::do_not_optimize(data.network.project(data.queries[i], ProjectionMode::kAccumulate));
+        }
+        return size_t(64);
+    }, "point").allocs(4);  // R 树查询迭代器与候选列表
+
+    suite.add("network/project_batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &data = dataset();
+        auto results = project_batch(data.network, data.queries, ProjectionMode::kAccumulate, &pool);
+        bench::do_not_optimize(results.data());
+        return results.size();
+    }, "point").allocs(5);
+
+    suite.add("moving/update_geo2", [] {
+        static size_t step = 0;
+        auto &f = fleet();
+        ++step;
+        for (size_t i = 0; i < 1024; ++i) {
+            size_t id = (step * 1024 + i) * 7919 % Fleet::kVehicles;
+            f.index.update(id, f.position(id, step));
+        }
+        return size_t(1024);
+    }, "update").allocs(0.05);  // 跨网格移动时桶扩容
+
+    suite.add("moving/radius_query_geo2", [] {
+        auto &f = fleet();
+        const auto &queries = dataset().queries;
+        for (size_t i = 0; i < 64; ++i) {
+            bench::do_not_optimize(f.index.radius_query(queries[i], 200.).size());
+        }
+        return size_t(64);
+    }, "query").allocs(10);  // 结果列表扩容
+
+    suite.add("moving/knn_geo2", [] {
+        auto &f = fleet();
+        const auto &queries = dataset().queries;
+        for (size_t i = 0; i < 64; ++i) {
+            bench::do_not_optimize(f.index.knn(queries[i], 8, 5000.).size());
+        }
+        return size_t(64);
+    }, "query").allocs(12);
+
+    // 更新与查询混合（每 16 个操作中 1 个半径查询），在线程池中并发执行
+    suite.add("moving/mixed_geo2", [] {
+        static ThreadPool pool;
+        static std::atomic<size_t> step{0};
+        auto &f = fleet();
+        const auto &queries = dataset().queries;
+        size_t s = ++step;
+        parallel_for(&pool, 4096, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (i % 16 == 0) {
+                    bench::do_not_optimize(f.index.radius_query(queries[i % queries.size()], 200.).size());
+                } else {
+                    size_t id = (s * 4096 + i) * 7919 % Fleet::kVehicles;
+                    f.index.update(id, f.position(id, s));
+                }
+            }
+        });
+        return size_t(4096);
+    }, "op");
+
+    // 每个时刻移动全部点并检测 10 米以内的点对，检测器在时刻之间增量更新网格
+    suite.add("proximity/tick_point2_100k", [] {
+        static ThreadPool pool;
+        static Swarm<Point2> swarm(100000, Point2(0., 0.), 1.);
+        static ProximityDetector<Point2> detector(10., &pool);
+        swarm.tick();
+        bench::do_not_optimize(detector.detect(swarm.points, 0.).size());
+        return swarm.points.size();
+    }, "point");
+
+    suite.add("proximity/tick_point2_1m", [] {
+        static ThreadPool pool;
+        static Swarm<Point2> swarm(1000000, Point2(0., 0.), 1.);
+        static ProximityDetector<Point2> detector(10., &pool);
+        swarm.tick();
+        bench::do_not_optimize(detector.detect(swarm.points, 0.).size());
+        return swarm.points.size();
+    }, "point");
+
+    suite.add("proximity/tick_geo2_100k", [] {
+        static ThreadPool pool;
+        static Swarm<PointGeo2> swarm(100000, PointGeo2(116.3, 39.9), 1e5);
+        static ProximityDetector<PointGeo2> detector(10., &pool);
+        swarm.tick();
+        bench::do_not_optimize(detector.detect(swarm.points, 0.).size());
+        return swarm.points.size();
+    }, "point");
+
+    suite.add("cpa/pair_geo2", [] {
+        const auto &lines = trajectories();
+        size_t segments = 0;
+        for (size_t i = 0; i + 1 < 64; ++i) {
+            bench::do_not_optimize(closest_approach(lines[i], lines[i + 1]).distance);
+            segments += lines[i].size() + lines[i + 1].size();
+        }
+        return segments;
+    }, "vertex");
+
+    suite.add("cpa/batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &lines = trajectories();
+        static const auto pairs = [&lines] {
+            std::vector<std::pair<size_t, size_t>> result;
+            for (size_t i = 0; i + 1 < lines.size(); ++i) {
+                result.emplace_back(i, i + 1);
+            }
+            return result;
+        }();
+        auto results = closest_approach_batch(lines, pairs, &pool);
+        bench::do_not_optimize(results.data());
+        return results.size();
+    }, "pair");
+
+    // 实时写入：每次迭代追加 65536 个点，写满后换一个新的存储
+    suite.add("store/append_geo2", [] {
+        static std::unique_ptr<TrajectoryStore<PointGeo2>> store;
+        static size_t next = 0;
+        const auto &data = store_data();
+        if (!store || next + 65536 > data.order.size()) {
+            store = std::make_unique<TrajectoryStore<PointGeo2>>();
+            next = 0;
+        }
+        data.append(*store, next, next + 65536);
+        next += 65536;
+        return size_t(65536);
+    }, "point");
+
+    // 覆盖全部数据的查询，衡量解码扫描速度
+    suite.add("store/scan_geo2", [] {
+        static ThreadPool pool;
+        const auto &store = *store_data().store;
+        Box<PointGeo2> everything(PointGeo2(-180., -90.), PointGeo2(180., 90.));
+        return store.query(everything, -1e18, 1e18, &pool).size();
+    }, "point");
+
+    // 1 平方公里 x 1 小时的查询，返回经过的对象
+    suite.add("store/query_geo2", [] {
+        static ThreadPool pool;
+        const auto &store = *store_data().store;
+        auto box = create_box(PointGeo2(116.35, 39.945), 1000.);
+        bench::do_not_optimize(store.query_objects(box, 8 * 3600., 9 * 3600., &pool).size());
+        return size_t(1);
+    }, "query");
+
+    suite.add("kinematics/trajectory_geo2", [] {
+        const auto &lines = trajectories();
+        size_t points = 0;
+        for (size_t i = 0; i < 64; ++i) {
+            bench::do_not_optimize(compute_kinematics(lines[i]).speed.data());
+            points += lines[i].size();
+        }
+        return points;
+    }, "point");
+
+    // 逐段调用 `distance` 的对照，衡量局部平面近似的收益
+    suite.add("kinematics/vincenty_geo2", [] {
+        const auto &lines = trajectories();
+        size_t points = 0;
+        for (size_t i = 0; i < 64; ++i) {
+            const auto &line = lines[i];
+            for (size_t k = 1; k < line.size(); ++k) {
+                bench::do_not_optimize(simplegeom::distance(line.points[k - 1], line.points[k]));
+            }
+            points += line.size();
+        }
+        return points;
+    }, "point");
+
+    suite.add("kinematics/batch_filter_geo2", [] {
+        static ThreadPool pool;
+        const auto &lines = trajectories();
+        auto results = compute_kinematics_batch(lines, KinematicsOptions{60., 10000.}, &pool);
+        bench::do_not_optimize(results.data());
+        size_t points = 0;
+        for (const auto &line : lines) {
+            points += line.size();
+        }
+        return points;
+    }, "point");
+
+    suite.add("stay/stay_points_batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &lines = stop_trajectories();
+        auto stays = detect_stay_points_batch(lines, StayPointOptions{}, &pool);
+        bench::do_not_optimize(stays.data());
+        size_t points = 0;
+        for (const auto &line : lines) {
+            points += line.size();
+        }
+        return points;
+    }, "point");
+
+    suite.add("stay/density_batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &lines = stop_trajectories();
+        auto stays = detect_stops_density_batch(lines, DensityStopOptions{}, &pool);
+        bench::do_not_optimize(stays.data());
+        size_t points = 0;
+        for (const auto &line : lines) {
+            points += line.size();
+        }
+        return points;
+    }, "point");
+
+    suite.add("raster/points_geo2", [] {
+        const auto &data = heatmap_data();
+        static Heatmap<PointGeo2> heatmap(data.extent, 1024, 1024);
+        for (const auto &p : data.points) {
+            heatmap.add(p);
+        }
+        bench::do_not_optimize(heatmap.cells().data());
+        return data.points.size();
+    }, "point");
+
+    suite.add("raster/points_batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &data = heatmap_data();
+        static Heatmap<PointGeo2> heatmap(data.extent, 1024, 1024);
+        rasterize_points(heatmap, data.points, {}, &pool);
+        bench::do_not_optimize(heatmap.cells().data());
+        return data.points.size();
+    }, "point");
+
+    suite.add("raster/lines_coverage_geo2", [] {
+        static ThreadPool pool;
+        const auto &data = heatmap_data();
+        const auto &lines = dataset().lines;
+        static Heatmap<PointGeo2> heatmap(data.extent, 1024, 1024);
+        rasterize_lines(heatmap, lines, {}, LineRasterMode::kCoverage, &pool);
+        bench::do_not_optimize(heatmap.cells().data());
+        size_t vertices = 0;
+        for (const auto &line : lines) {
+            vertices += line.size();
+        }
+        return vertices;
+    }, "vertex");
+
+    suite.add("polygon/metrics_geo2", [] {
+        const auto &data = parcel_data();
+        double sum = 0.;
+        for (const auto &polygon : data.polygons) {
+            auto metrics = polygon_metrics(polygon);
+            sum += metrics.area + metrics.perimeter + bg::get<0>(metrics.centroid);
+        }
+        bench::do_not_optimize(sum);
+        return data.vertices;
+    }, "vertex");
+
+    // 对照：Boost.Geometry 的椭球面积（只计算面积）
+    suite.add("boost/area_geo2", [] {
+        const auto &data = parcel_data();
+        double sum = 0.;
+        for (const auto &polygon : data.polygons) {
+            sum += bg::area(polygon);
+        }
+        bench::do_not_optimize(sum);
+        return data.vertices;
+    }, "vertex");
+
+    suite.add("polygon/metrics_batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &data = parcel_data();
+        auto results = polygon_metrics_batch(data.polygons, &pool);
+        bench::do_not_optimize(results.data());
+        return data.vertices;
+    }, "vertex");
+
+    suite.add("hull/monotone_chain_point2", [] {
+        const auto &points = hull_points();
+        auto hull = convex_hull(points);
+        bench::do_not_optimize(hull.outer().data());
+        return points.size();
+    }, "point");
+
+    suite.add("hull/monotone_chain_circle_point2", [] {
+        const auto &points = hull_points(true);
+        auto hull = convex_hull(points);
+        bench::do_not_optimize(hull.outer().data());
+        return points.size();
+    }, "point");
+
+    suite.add("hull/parallel_circle_point2", [] {
+        static ThreadPool pool;
+        const auto &points = hull_points(true);
+        auto hull = convex_hull(points, HullAlgorithm::kMonotoneChain, &pool);
+        bench::do_not_optimize(hull.outer().data());
+        return points.size();
+    }, "point");
+
+    suite.add("hull/quickhull_point2", [] {
+        const auto &points = hull_points();
+        auto hull = convex_hull(points, HullAlgorithm::kQuickhull);
+        bench::do_not_optimize(hull.outer().data());
+        return points.size();
+    }, "point");
+
+    // 对照：Boost.Geometry 的凸包
+    suite.add("boost/convex_hull_point2", [] {
+        static const bg::model::multi_point<Point2> kPoints(hull_points().begin(), hull_points().end());
+        Polygon<Point2> hull;
+        bg::convex_hull(kPoints, hull);
+        bench::do_not_optimize(hull.outer().data());
+        return kPoints.size();
+    }, "point");
+
+    // 每条轨迹的凸包、最小外接矩形与最小外接圆
+    suite.add("hull/batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &lines = trajectories();
+        static const auto kSets = [&] {
+            std::vector<LineString<PointGeo2>> sets;
+            for (const auto &line : lines) {
+                sets.push_back(line.points);
+            }
+            return sets;
+        }();
+        auto hulls = convex_hull_batch(kSets, HullAlgorithm::kMonotoneChain, &pool);
+        auto rectangles = minimum_bounding_rectangle_batch(kSets, &pool);
+        auto circles = minimum_bounding_circle_batch(kSets, &pool);
+        bench::do_not_optimize(hulls.data());
+        bench::do_not_optimize(rectangles.data());
+        bench::do_not_optimize(circles.data());
+        size_t points = 0;
+        for (const auto &set : kSets) {
+            points += set.size();
+        }
+        return points;
+    }, "point");
+
+    suite.add("delaunay/triangulation_point2", [] {
+        const auto &points = hull_points();
+        auto triangulation = delaunay_triangulation(points);
+        bench::do_not_optimize(triangulation.triangles.data());
+        return points.size();
+    }, "point");
+
+    // 城市范围内的 100 万个地理坐标点，在局部平面中剖分
+    suite.add("delaunay/triangulation_geo2", [] {
+        static const auto kPoints = [] {
+            std::vector<PointGeo2> points;
+            for (const auto &p : hull_points()) {
+                points.emplace_back(116.4 + bg::get<0>(p) * 1e-5, 39.9 + bg::get<1>(p) * 1e-5);
+            }
+            return points;
+        }();
+        auto triangulation = delaunay_triangulation(kPoints);
+        bench::do_not_optimize(triangulation.triangles.data());
+        return kPoints.size();
+    }, "point");
+
+    // 10 万个站点的 Voronoi 单元，裁剪到站点的外包矩形
+    suite.add("voronoi/cells_point2", [] {
+        static ThreadPool pool;
+        static const std::vector<Point2> kSites(hull_points().begin(), hull_points().begin() + 100000);
+        static const auto kBox =
+            bg::return_envelope<Box<Point2>>(bg::model::multi_point<Point2>(kSites.begin(), kSites.end()));
+        auto cells = voronoi_cells(kSites, kBox, &pool);
+        bench::do_not_optimize(cells.data());
+        return kSites.size();
+    }, "site");
+
+    // 轨迹两侧 20 米的走廊
+    suite.add("buffer/corridor_geo2", [] {
+        const auto &data = buffer_data();
+        size_t polygons = 0;
+        for (const auto &line : data.lines) {
+            polygons += buffer_line(line, 20.).size();
+        }
+        bench::do_not_optimize(polygons);
+        return data.vertices;
+    }, "vertex");
+
+    suite.add("buffer/corridor_batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &data = buffer_data();
+        auto corridors = buffer_line_batch(data.lines, 20., {}, &pool);
+        bench::do_not_optimize(corridors.data());
+        return data.vertices;
+    }, "vertex");
+
+    // 对照：Boost.Geometry 在局部平面中计算整条折线的缓冲区（Boost 1.74 不支持地理坐标折线的缓冲区）
+    suite.add("boost/buffer_point2", [] {
+        const auto &data = buffer_data();
+        bg::strategy::buffer::distance_symmetric<double> distance(20.);
+        size_t polygons = 0;
+        for (const auto &line : data.metric) {
+            MultiPolygon<Point2> corridor;
+            bg::buffer(line, corridor, distance, bg::strategy::buffer::side_straight(),
+                       bg::strategy::buffer::join_round(36), bg::strategy::buffer::end_round(36),
+                       bg::strategy::buffer::point_circle(36));
+            polygons += corridor.size();
+        }
+        bench::do_not_optimize(polygons);
+        return data.vertices;
+    }, "vertex");
+
+    // 轨迹左侧 3.5 米的偏移线
+    suite.add("offset/line_geo2", [] {
+        const auto &data = buffer_data();
+        size_t points = 0;
+        for (const auto &line : data.lines) {
+            points += offset_line(line, 3.5).size();
+        }
+        bench::do_not_optimize(points);
+        return data.vertices;
+    }, "vertex");
+
+    // 以 30 米容差化简覆盖，公共边界只化简一次
+    suite.add("coverage/simplify_geo2", [] {
+        const auto &data = coverage_data();
+        auto simplified = simplify_coverage(data.polygons, 30.);
+        bench::do_not_optimize(simplified.data());
+        return data.vertices;
+    }, "vertex");
+
+    suite.add("coverage/simplify_parallel_geo2", [] {
+        static ThreadPool pool;
+        const auto &data = coverage_data();
+        auto simplified = simplify_coverage(data.polygons, 30., &pool);
+        bench::do_not_optimize(simplified.data());
+        return data.vertices;
+    }, "vertex");
+
+    // 对照：Boost.Geometry 在局部平面中逐个化简多边形，相邻多边形的公共边界各自化简，会产生缝隙与重叠
+    suite.add("boost/simplify_point2", [] {
+        const auto &data = coverage_data();
+        std::vector<Polygon<Point2>> simplified(data.metric.size());
+        for (size_t i = 0; i < data.metric.size(); ++i) {
+            bg::simplify(data.metric[i], simplified[i], 30.);
+        }
+        bench::do_not_optimize(simplified.data());
+        return data.vertices;
+    }, "vertex");
+
+    // 含噪路网的清理，`project/*_line_geo2` 对比清理前后单条折线的投影耗时
+    suite.add("clean/line_geo2", [] {
+        const auto &data = clean_data();
+        size_t points = 0;
+        for (const auto &line : data.lines) {
+            points += clean_line(line, CleanData::kOptions).size();
+        }
+        bench::do_not_optimize(points);
+        return data.vertices;
+    }, "vertex");
+
+    suite.add("clean/line_batch_geo2", [] {
+        static ThreadPool pool;
+        const auto &data = clean_data();
+        auto cleaned = clean_line_batch(data.lines, CleanData::kOptions, &pool);
+        bench::do_not_optimize(cleaned.data());
+        return data.vertices;
+    }, "vertex");
+
+    suite.add("project/noisy_line_geo2", [] {
+        const auto &data = clean_data();
+        const auto &queries = dataset().queries;
+        for (size_t i = 0; i < 16; ++i) {
+            bench::do_not_optimize(simplegeom::distance(queries[i], data.long_line, ProjectionMode::kAccumulate));
+        }
+        return size_t(16);
+    }, "point").allocs(0);
+
+    suite.add("project/cleaned_line_geo2", [] {
+        const auto &data = clean_data();
+        const auto &queries = dataset().queries;
+        for (size_t i = 0; i < 16; ++i) {
+            bench::do_not_optimize(simplegeom::distance(queries[i], data.cleaned, ProjectionMode::kAccumulate));
+        }
+        return size_t(16);
+    }, "point").allocs(0);
+
+    suite.add("io/wkt_str_point", [] {
+        const auto &queries = dataset().queries;
+        for (size_t i = 0; i < 256; ++i) {
+            bench::do_not_optimize(wkt_str(queries[i]));
+        }
+        return size_t(256);
+    });
+
+    suite.add("io/wkt_str_line", [] {
+        const auto &lines = dataset().lines;
+        for (size_t i = 0; i < 16; ++i) {
+            bench::do_not_optimize(wkt_str(lines[i]));
+        }
+        return size_t(16);
+    });
+
+    suite.add("io/from_wkt_line", [] {
+        static const auto wkt = wkt_str(dataset().lines.front());
+        for (size_t i = 0; i < 16; ++i) {
+            bench::do_not_optimize(from_wkt<LineString<PointGeo2>>(wkt));
+        }
+        return size_t(16);
+    });
+
+    return suite.run(argc, argv);
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+namespace bench {
+
+// 单个内核的差分测试统计
+struct DifferentialStats {
+    std::string name;
+    size_t samples = 0;
+    double max_error = 0.;
+    double mean_error = 0.;
+    double bound = 0.;
+    size_t worst_index = 0;  // 误差最大的输入序号
+    double reference_seconds = 0.;
+    double candidate_seconds = 0.;
+    bool timed = true;  // 为 false 时参考实现只用于校验，不报告参考耗时与加速比
+
+    bool passed() const { return max_error <= bound; }
+    double speedup() const { return candidate_seconds > 0. ? reference_seconds / candidate_seconds : 0.; }
+};
+
+/**
+ * @brief 差分测试套件：在大量随机和对抗性输入上，将加速内核与参考实现逐一比较。
+ *
+ * 每个内核注册一个输入生成函数、参考实现、待测实现、误差函数和误差上界。运行时先生成输入，
+ * 分别计时执行参考实现和待测实现，再逐个比较输出，报告最大误差、平均误差和加速比，
+ * 任意内核的最大误差超过上界时返回非零值，便于在持续集成中使用。
+ *
+ * 命令行参数：
+ *   --profile=<名称>   quick（默认）每个内核 10000 个输入，用于日常检查；full 每个内核一百万个输入，
+ *                      用于发布前或夜间的完整检查（`differential_full` 构建目标），耗时以小时计
+ *   --samples=<数量>   每个内核的输入数量，覆盖 `--profile` 的设置
+ *   --seed=<种子>      输入生成的随机数种子，默认 1
+ *   --filter=<子串>    只运行名称包含该子串的内核
+ *
+ * 计算量很大的内核会在生成函数中按比例减少输入数量，输出中的 samples 列为实际比较的数量。
+ * 由 `add_check` 注册的内核只校验正确性，ref ns 与 speedup 列显示为 `-`。
+ */
+class DifferentialSuite {
+public:
+    /**
+     * @brief 注册一个内核。
+     *
+     * @tparam Input 输入类型。
+     * @tparam Output 输出类型。
+     * @param [in] name 内核名称。
+     * @param [in] generate 输入生成函数，参数为数量与种子，应同时覆盖随机与退化情况。
+     * @param [in] reference 参考实现。
+     * @param [in] candidate 待测的加速实现。
+     * @param [in] error 误差函数，参数依次为参考输出与待测输出。
+     * @param [in] bound 允许的最大误差。
+     * @param [in] describe 可选，将输入转换为字符串，用于输出误差最大的输入。
+     */
+    template <typename Input, typename Output>
+    void add(std::string name, std::function<std::vector<Input>(size_t, uint64_t)> generate,
+             std::function<Output(const Input &)> reference, std::function<Output(const Input &)> candidate,
+             std::function<double(const Output &, const Output &)> error, double bound,
+             std::function<std::string(const Input &)> describe = nullptr) {
+        kernels_.push_back({name, [=](size_t samples, uint64_t seed, std::string &worst) {
+                                auto inputs = generate(samples, seed);
+                                auto stats = evaluate(inputs, reference, candidate, error, worst, describe);
+                                stats.name = name;
+                                stats.bound = bound;
+                                return stats;
+                            }});
+    }
+
+    /**
+     * @brief 注册一个只校验正确性的内核，参数与 `add` 相同。
+     *
+     * 用于参考实现不是同一问题的另一种解法的情况（例如由输入直接构造期望输出的往返测试），
+     * 参考耗时与加速比没有意义，输出中显示为 `-`，只报告待测实现的耗时。
+     */
+    template <typename Input, typename Output>
+    void add_check(std::string name, std::function<std::vector<Input>(size_t, uint64_t)> generate,
+                   std::function<Output(const Input &)> reference, std::function<Output(const Input &)> candidate,
+                   std::function<double(const Output &, const Output &)> error, double bound,
+                   std::function<std::string(const Input &)> describe = nullptr) {
+        add<Input, Output>(name, generate, reference, candidate, error, bound, describe);
+        auto run = kernels_.back().run;
+        kernels_.back().run = [run](size_t samples, uint64_t seed, std::string &worst) {
+            auto stats = run(samples, seed, worst);
+            stats.timed = false;
+            return stats;
+        };
+    }
+
+    int run(int argc, char **argv) {
+        static constexpr size_t kQuickSamples = 10000;
+        static constexpr size_t kFullSamples = 1000000;
+
+        size_t samples = kQuickSamples;
+        uint64_t seed = 1;
+        std::string filter;
+        bool explicit_samples = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--samples=", 0) == 0) {
+                samples = std::stoull(arg.substr(10));
+                explicit_samples = true;
+            } else if (arg.rfind("--profile=", 0) == 0) {
+                std::string profile = arg.substr(10);
+                if (profile != "quick" && profile != "full") {
+                    std::cerr << "unknown profile: " << profile << std::endl;
+                    return 2;
+                }
+                if (!explicit_samples) {
+                    samples = profile == "full" ? kFullSamples : kQuickSamples;
+                }
+            } else if (arg.rfind("--seed=", 0) == 0) {
+                seed = std::stoull(arg.substr(7));
+            } else if (arg.rfind("--filter=", 0) == 0) {
+                filter = arg.substr(9);
+            } else {
+                std::cerr << "unknown argument: " << arg << std::endl;
+                return 2;
+            }
+        }
+
+        size_t failures = 0;
+        std::printf("%-36s %10s %12s %12s %12s %12s %12s %9s %6s\n", "kernel", "samples", "max_err", "mean_err",
+                    "bound", "ref ns", "fast ns", "speedup", "status");
+        for (const auto &kernel : kernels_) {
+            if (!filter.empty() && kernel.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            std::string worst;
+            auto stats = kernel.run(samples, seed, worst);
+            double n = std::max<size_t>(1, stats.samples);
+            char reference_ns[32] = "-", speedup[32] = "-";
+            if (stats.timed) {
+                std::snprintf(reference_ns, sizeof(reference_ns), "%.1f", stats.reference_seconds * 1e9 / n);
+                std::snprintf(speedup, sizeof(speedup), "%.2fx", stats.speedup());
+            }
+            std::printf("%-36s %10zu %12.3g %12.3g %12.3g %12s %12.1f %9s %6s\n", stats.name.c_str(), stats.samples,
+                        stats.max_error, stats.mean_error, stats.bound, reference_ns, stats.candidate_seconds * 1e9 / n,
+                        speedup, stats.passed() ? "ok" : "FAIL");
+            if (!stats.passed()) {
+                ++failures;
+                if (!worst.empty()) {
+                    std::printf("    worst input #%zu: %s\n", stats.worst_index, worst.c_str());
+                }
+            }
+            std::fflush(stdout);
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+private:
+    template <typename Input, typename Output>
+    static DifferentialStats evaluate(const std::vector<Input> &inputs,
+                                      const std::function<Output(const Input &)> &reference,
+                                      const std::function<Output(const Input &)> &candidate,
+                                      const std::function<double(const Output &, const Output &)> &error,
+                                      std::string &worst, const std::function<std::string(const Input &)> &describe) {
+        DifferentialStats stats;
+        stats.samples = inputs.size();
+
+        std::vector<Output> expected, actual;
+        expected.reserve(inputs.size());
+        actual.reserve(inputs.size());
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto &input : inputs) {
+            expected.push_back(reference(input));
+        }
+        auto middle = std::chrono::steady_clock::now();
+        for (const auto &input : inputs) {
+            actual.push_back(candidate(input));
+        }
+        auto end = std::chrono::steady_clock::now();
+        stats.reference_seconds = std::chrono::duration<double>(middle - start).count();
+        stats.candidate_seconds = std::chrono::duration<double>(end - middle).count();
+
+        double sum = 0.;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            double e = error(expected[i], actual[i]);
+            // NaN 视为无穷大误差
+            if (std::isnan(e)) {
+                e = std::numeric_limits<double>::infinity();
+            }
+            sum += e;
+            if (e > stats.max_error || i == 0) {
+                stats.max_error = e;
+                stats.worst_index = i;
+            }
+        }
+        stats.mean_error = inputs.empty() ? 0. : sum / inputs.size();
+        if (describe && !inputs.empty()) {
+            worst = describe(inputs[stats.worst_index]);
+        }
+        return stats;
+    }
+
+    struct Kernel {
+        std::string name;
+        std::function<DifferentialStats(size_t, uint64_t, std::string &)> run;
+    };
+
+    std::vector<Kernel> kernels_;
+};
+
+}  // namespace bench
@@ -0,0 +1,2898 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+
+#include <boost/geometry/formulas/thomas_inverse.hpp>
+#include <boost/geometry/formulas/vincenty_direct.hpp>
+
+#include "differential.h"
+#include "simplegeom/async.h"
+#include "simplegeom/buffer.h"
+#include "simplegeom/clean.h"
+#include "simplegeom/coverage.h"
+#include "simplegeom/delaunay.h"
+#include "simplegeom/hull.h"
+#include "simplegeom/kinematics.h"
+#include "simplegeom/moving_index.h"
+#include "simplegeom/partition.h"
+#include "simplegeom/polygon.h"
+#include "simplegeom/proximity.h"
+#include "simplegeom/raster.h"
+#include "simplegeom/shared_network.h"
+#include "simplegeom/simplegeom.h"
+#include "simplegeom/stay_point.h"
+#include "simplegeom/synthetic.h"
+#include "simplegeom/trace.h"
+#include "simplegeom/trajectory.h"
+#include "simplegeom/trajectory_store.h"
+
+using namespace simplegeom;
+
+namespace {
+
+// 点与折线组成的输入，`kind` 标记输入的类别，便于定位误差来源
+template <typename Point>
+struct LineCase {
+    Point point;
+    std::shared_ptr<const LineString<Point>> line;
+    const char *kind;
+};
+
+template <typename Point>
+std::string describe(const LineCase<Point> &c) {
+    return std::string(c.kind) + " " + wkt_str(c.point) + " " + wkt_str(*c.line);
+}
+
+// 在局部平面中以米为单位偏移地理点
+PointGeo2 offset(const PointGeo2 &p, double dx, double dy) {
+    double lat = bg::get<1>(p);
+    double lon = bg::get<0>(p) + dx / (kMetersPerDegree * std::max(1e-6, std::cos(lat * M_PI / 180.)));
+    lon = lon > 180. ? lon - 360. : (lon < -180. ? lon + 360. : lon);
+    return PointGeo2(lon, std::clamp(lat + dy / kMetersPerDegree, -90., 90.));
+}
+
+// 以 `start` 为起点、沿 `heading` 方向生成一条折线，可选地重复顶点以产生零长度线段
+std::shared_ptr<LineString<PointGeo2>> walk(const PointGeo2 &start, double heading, size_t n, double step,
+                                            bool duplicate, std::mt19937_64 &rng) {
+    std::normal_distribution<double> turn(0., 0.3);
+    auto line = std::make_shared<LineString<PointGeo2>>();
+    line->push_back(start);
+    for (size_t i = 1; i < n; ++i) {
+        if (duplicate && rng() % 3 == 0) {
+            line->push_back(line->back());
+            continue;
+        }
+        heading += turn(rng);
+        line->push_back(offset(line->back(), step * std::cos(heading), step * std::sin(heading)));
+    }
+    return line;
+}
+
+/**
+ * @brief 生成地理折线投影的输入：随机路网折线、含零长度线段的退化折线、跨越反子午线的折线和极点附近的折线。
+ *
+ * 查询点位于折线附近（默认搜索框范围内），部分查询点与顶点重合。`vertices` 大于 0 时随机折线也由随机游走生成，
+ * 并且所有折线都包含 `vertices` 个顶点，用于覆盖依赖线段数量的代码路径。
+ */
+std::vector<LineCase<PointGeo2>> make_geo_line_cases(size_t n, uint64_t seed, size_t vertices) {
+    static const auto kNetwork = generate_grid_network(RoadNetworkOptions{});
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+
+    std::vector<LineCase<PointGeo2>> cases;
+    cases.reserve(n);
+    std::shared_ptr<const LineString<PointGeo2>> line;
+    const char *kind = "";
+    for (size_t i = 0; i < n; ++i) {
+        // 每 16 个查询点更换一条折线
+        if (i % 16 == 0) {
+            size_t m = vertices > 0 ? vertices : 20;
+            switch (rng() % 10) {
+                case 0:
+                    line = walk(PointGeo2(116.4, 39.9), unit(rng) * 2 * M_PI, m, 30., true, rng);
+                    kind = "degenerate";
+                    break;
+                case 1:
+                    line = walk(PointGeo2(179.999, -16.8), unit(rng) < 0.5 ? 0. : M_PI, m, 20., false, rng);
+                    kind = "antimeridian";
+                    break;
+                case 2:
+                    line = walk(PointGeo2(unit(rng) * 360. - 180., 89.99), unit(rng) * 2 * M_PI, m, 20., false, rng);
+                    kind = "pole";
+                    break;
+                default:
+                    if (vertices > 0) {
+                        line = walk(PointGeo2(116.3 + unit(rng) * 0.2, 39.8 + unit(rng) * 0.2), unit(rng) * 2 * M_PI,
+                                    m, 30., false, rng);
+                    } else {
+                        line = std::make_shared<LineString<PointGeo2>>(kNetwork[rng() % kNetwork.size()]);
+                    }
+                    kind = "random";
+                    break;
+            }
+        }
+        const auto &vertex = (*line)[rng() % line->size()];
+        PointGeo2 point = rng() % 8 == 0 ? vertex : offset(vertex, (unit(rng) - 0.5) * 200., (unit(rng) - 0.5) * 200.);
+        cases.push_back({point, line, kind});
+    }
+    return cases;
+}
+
+std::vector<LineCase<PointGeo2>> generate_geo_line_cases(size_t n, uint64_t seed) {
+    return make_geo_line_cases(n, seed, 0);
+}
+
+/**
+ * @brief 生成平面折线投影的输入：随机折线、含零长度线段的折线以及共线折线。
+ */
+std::vector<LineCase<Point2>> generate_cartesian_line_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+
+    std::vector<LineCase<Point2>> cases;
+    cases.reserve(n);
+    std::shared_ptr<LineString<Point2>> line;
+    const char *kind = "";
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 16 == 0) {
+            line = std::make_shared<LineString<Point2>>();
+            size_t type = rng() % 4;
+            double x = unit(rng) * 1000., y = unit(rng) * 1000.;
+            for (size_t k = 0; k < 30; ++k) {
+                line->emplace_back(x, y);
+                if (type == 0 && rng() % 3 == 0) {
+                    continue;  // 重复顶点
+                }
+                x += type == 1 ? 10. : (unit(rng) - 0.5) * 40.;
+                y += type == 1 ? 0. : (unit(rng) - 0.5) * 40.;
+            }
+            kind = type == 0 ? "degenerate" : (type == 1 ? "collinear" : "random");
+        }
+        const auto &vertex = (*line)[rng() % line->size()];
+        Point2 point = rng() % 8 == 0 ? vertex
+                                      : Point2(bg::get<0>(vertex) + (unit(rng) - 0.5) * 100.,
+                                               bg::get<1>(vertex) + (unit(rng) - 0.5) * 100.);
+        cases.push_back({point, line, kind});
+    }
+    return cases;
+}
+
+// 点与折线句柄组成的输入，连续的输入共享同一个句柄
+struct HandleCase {
+    PointGeo2 point;
+    LineHandle<PointGeo2> line;
+    const char *kind;
+};
+
+// 四分之一的折线换成 `band` 折线：第一段远离其余沿纬线排列的顶点，查询点到纬线段的距离在 [1000, 1570] 米，
+// 落在初始搜索框（边长 2000 米）的内切圆之外、框角之内。线性扫描在这个距离上不接受任何线段，退回第一段
+std::vector<HandleCase> generate_handle_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed ^ 0x2545f4914f6cdd1dull);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::vector<HandleCase> cases;
+    cases.reserve(n);
+    const LineString<PointGeo2> *previous = nullptr;
+    LineHandle<PointGeo2> handle;
+    bool band = false;
+    for (const auto &c : make_geo_line_cases(n, seed, 200)) {
+        if (cases.size() % 16 == 0) {
+            band = rng() % 4 == 0;
+            if (band) {
+                double lon = unit(rng) * 330. - 170., lat = unit(rng) * 120. - 60.;
+                LineString<PointGeo2> line{PointGeo2(lon, lat), PointGeo2(lon, lat + 1e-3)};
+                for (size_t k = 0; k < 200; ++k) {
+                    line.emplace_back(lon + 10. + k * 1e-3, lat);
+                }
+                handle = LineHandle<PointGeo2>(std::move(line));
+            }
+        }
+        if (band) {
+            const auto &vertex = handle[3 + rng() % 197];
+            double r = 1000. + unit(rng) * 570.;
+            cases.push_back({offset(vertex, 0., rng() % 2 == 0 ? r : -r), handle, "band"});
+            previous = nullptr;
+            continue;
+        }
+        if (c.line.get() != previous) {
+            handle = LineHandle<PointGeo2>(*c.line);
+            previous = c.line.get();
+        }
+        cases.push_back({c.point, handle, c.kind});
+    }
+    return cases;
+}
+
+// 以交错坐标数组 `[x0, y0, x1, y1, ...]` 存放的折线，模拟调用方自己的缓冲区
+template <typename Point>
+struct CoordinateCase {
+    Point point;
+    std::shared_ptr<const std::vector<double>> coords;
+    std::shared_ptr<const LineString<Point>> line;
+
+    StridedPointView<Point> view() const { return StridedPointView<Point>::interleaved(coords->data(), line->size()); }
+};
+
+template <typename Point>
+std::function<std::vector<CoordinateCase<Point>>(size_t, uint64_t)> coordinate_cases(
+    std::vector<LineCase<Point>> (*generate)(size_t, uint64_t)) {
+    return [generate](size_t n, uint64_t seed) {
+        std::vector<CoordinateCase<Point>> cases;
+        cases.reserve(n);
+        std::shared_ptr<std::vector<double>> coords;
+        for (const auto &c : generate(n, seed)) {
+            if (cases.empty() || cases.back().line != c.line) {
+                coords = std::make_shared<std::vector<double>>();
+                for (const auto &p : *c.line) {
+                    coords->push_back(bg::get<0>(p));
+                    coords->push_back(bg::get<1>(p));
+                }
+            }
+            cases.push_back({c.point, coords, c.line});
+        }
+        return cases;
+    };
+}
+
+// 搜索框覆盖检查的输入：中心点、边长与中心点周围的采样点。采样点沿随机方位角取大地线距离，最多略超过边长的
+// 一半，不经过局部平面近似，靠近极点的一侧经度展开得比中心点纬度估计的更宽
+struct BoxCase {
+    PointGeo2 center;
+    double edge;
+    std::vector<PointGeo2> samples;
+};
+
+// 中心点纬度的绝对值在 [min_lat, max_lat] 内，南北半球各半，四分之一的中心点紧靠反子午线
+std::vector<BoxCase> generate_box_cases(size_t n, uint64_t seed, double min_lat, double max_lat, double max_edge) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    bg::srs::spheroid<double> spheroid;
+    std::vector<BoxCase> cases;
+    for (size_t i = 0; i < n; ++i) {
+        double lat = min_lat + unit(rng) * (max_lat - min_lat);
+        double lon = rng() % 4 == 0 ? 180. - unit(rng) * 1e-3 : unit(rng) * 360. - 180.;
+        BoxCase c{PointGeo2(lon, rng() % 2 == 0 ? lat : -lat), 10. + unit(rng) * max_edge, {}};
+        for (size_t k = 0; k < 64; ++k) {
+            double azimuth = unit(rng) * 2 * M_PI, r = unit(rng) * 0.525 * c.edge;
+            auto direct = bg::formula::vincenty_direct<double>::apply(
+                lon * M_PI / 180., bg::get<1>(c.center) * M_PI / 180., r, azimuth, spheroid);
+            c.samples.emplace_back(std::remainder(direct.lon2 * 180. / M_PI, 360.), direct.lat2 * 180. / M_PI);
+        }
+        cases.push_back(std::move(c));
+    }
+    return cases;
+}
+
+std::string describe_box(const BoxCase &c) { return wkt_str(c.center) + " edge=" + std::to_string(c.edge); }
+
+// 到中心点的距离不超过边长一半的采样点数。`pruned` 为 true 时只检查落在 `create_box` 搜索框内的采样点，经度按
+// 360 度的周期比较
+double box_hits(const BoxCase &c, bool pruned) {
+    auto box = create_box(c.center, c.edge);
+    double min_lon = bg::get<bg::min_corner, 0>(box), max_lon = bg::get<bg::max_corner, 0>(box);
+    double min_lat = bg::get<bg::min_corner, 1>(box), max_lat = bg::get<bg::max_corner, 1>(box);
+    double hits = 0.;
+    for (const auto &p : c.samples) {
+        double lon = min_lon + std::fmod(std::fmod(bg::get<0>(p) - min_lon, 360.) + 360., 360.);
+        bool inside = lon <= max_lon && bg::get<1>(p) >= min_lat && bg::get<1>(p) <= max_lat;
+        hits += (!pruned || inside) && simplegeom::distance(c.center, p) <= c.edge / 2. ? 1. : 0.;
+    }
+    return hits;
+}
+
+// 参考实现：逐段计算距离，取第一个最近线段，累积距离由 Vincenty 长度逐段相加
+std::pair<double, double> reference_projection(const PointGeo2 &point, const LineString<PointGeo2> &line) {
+    double best = std::numeric_limits<double>::max();
+    size_t index = 0;
+    Segment<PointGeo2> seg;
+    for (size_t i = 0; i + 1 < line.size(); ++i) {
+        assign_segment(line[i], line[i + 1], seg);
+        double d = bg::distance(point, seg);
+        if (d < best) {
+            best = d;
+            index = i;
+        }
+    }
+    double measure = 0.;
+    for (size_t i = 0; i < index; ++i) {
+        measure += simplegeom::distance(line[i], line[i + 1]);
+    }
+    assign_segment(line[index], line[index + 1], seg);
+    return std::make_pair(best, measure + simplegeom::distance(seg.first, closest_point(point, seg)));
+}
+
+// 网络投影的误差：最近折线不同时只比较距离（可能是等距的并列情况），相同时同时比较距离与投影距离
+double network_error(const NetworkProjection &expected, const NetworkProjection &actual) {
+    if (expected.valid() != actual.valid()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double e = std::abs(expected.distance - actual.distance);
+    if (expected.line_id == actual.line_id) {
+        e = std::max(e, std::abs(expected.project_distance - actual.project_distance));
+    }
+    return e;
+}
+
+// 同一条折线的 WKT 与 WKB 表示，`expect_error` 为真时 WKB 是伪造或截断的数据，解析应抛出 `std::runtime_error`
+struct WkbCase {
+    const char *kind;
+    std::string wkt;
+    std::vector<uint8_t> wkb;
+    bool expect_error = false;
+};
+
+// 按指定字节序写入 WKB 的整数与浮点数
+struct WkbWriter {
+    std::vector<uint8_t> bytes;
+    bool big_endian = false;
+
+    template <typename T>
+    void put(T value) {
+        uint8_t raw[sizeof(T)];
+        std::memcpy(raw, &value, sizeof(T));
+        if (big_endian) {
+            std::reverse(raw, raw + sizeof(T));
+        }
+        bytes.insert(bytes.end(), raw, raw + sizeof(T));
+    }
+};
+
+/**
+ * @brief 将折线编码为 WKB。`variant` 依次为小端 ISO WKB、大端 ISO WKB、带 Z 值的 ISO WKB（类型 1002）与带 SRID
+ * 的 PostGIS EWKB，Z 值在二维点上解析时应被忽略。
+ */
+std::vector<uint8_t> encode_wkb(const LineString<PointGeo2> &line, size_t variant) {
+    WkbWriter writer;
+    writer.big_endian = variant == 1;
+    writer.bytes.push_back(writer.big_endian ? 0 : 1);
+    if (variant == 2) {
+        writer.put<uint32_t>(1002);
+    } else if (variant == 3) {
+        writer.put<uint32_t>(0x20000000u | 2);
+        writer.put<uint32_t>(4326);
+    } else {
+        writer.put<uint32_t>(2);
+    }
+    writer.put<uint32_t>(static_cast<uint32_t>(line.size()));
+    for (const auto &p : line) {
+        writer.put(bg::get<0>(p));
+        writer.put(bg::get<1>(p));
+        if (variant == 2) {
+            writer.put(12.5);
+        }
+    }
+    return std::move(writer.bytes);
+}
+
+// 按最短的往返精度输出 WKT，与 WKB 中的坐标逐位一致
+std::string exact_wkt(const LineString<PointGeo2> &line) {
+    std::string wkt = "LINESTRING(";
+    char buffer[64];
+    for (size_t i = 0; i < line.size(); ++i) {
+        std::snprintf(buffer, sizeof(buffer), "%s%.17g %.17g", i == 0 ? "" : ",", bg::get<0>(line[i]),
+                      bg::get<1>(line[i]));
+        wkt += buffer;
+    }
+    return wkt + ")";
+}
+
+/**
+ * @brief 从道路折线生成 WKB 输入：四种编码各占一部分，另有少量截断的数据与点数伪造为 0x7fffffff 的 9 字节数据。
+ */
+std::vector<WkbCase> generate_wkb_cases(const std::vector<LineString<PointGeo2>> &lines, size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<WkbCase> cases;
+    static const char *kKinds[] = {"wkb_le", "wkb_be", "wkb_z", "ewkb_srid"};
+    for (size_t i = 0; i < n; ++i) {
+        const auto &line = lines[rng() % lines.size()];
+        WkbCase c{kKinds[i % 4], exact_wkt(line), encode_wkb(line, i % 4)};
+        if (i % 97 == 0) {
+            c.kind = "truncated";
+            c.wkb.resize(c.wkb.size() - 1 - rng() % 8);
+            c.expect_error = true;
+        } else if (i % 101 == 0) {
+            c.kind = "forged_count";
+            c.wkb = {1, 2, 0, 0, 0, 0xff, 0xff, 0xff, 0x7f};
+            c.expect_error = true;
+        }
+        cases.push_back(std::move(c));
+    }
+    return cases;
+}
+
+// 解析结果：`error` 为异常类别（没有异常时为空），便于比较伪造数据是否抛出了约定的异常
+struct WkbDecoded {
+    std::string error;
+    LineString<PointGeo2> line;
+};
+
+double wkb_error(const WkbDecoded &expected, const WkbDecoded &actual) {
+    if (expected.error != actual.error || expected.line.size() != actual.line.size()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double e = 0.;
+    for (size_t i = 0; i < expected.line.size(); ++i) {
+        e = std::max(e, std::abs(bg::get<0>(expected.line[i]) - bg::get<0>(actual.line[i])));
+        e = std::max(e, std::abs(bg::get<1>(expected.line[i]) - bg::get<1>(actual.line[i])));
+    }
+    return e;
+}
+
+// 通过 `TracedNetwork` 发起的一次调用，`line_id` 超出线网范围时调用抛出异常但仍被记录
+struct TraceCall {
+    TraceOp op;
+    ProjectionMode mode;
+    size_t line_id;
+    PointGeo2 point, other;
+};
+
+std::vector<std::vector<TraceCall>> generate_trace_batches(const std::vector<LineString<PointGeo2>> &lines, size_t n,
+                                                           uint64_t seed) {
+    // 每批 64 次调用写入一个轨迹文件，总调用数与其他线网内核相同
+    auto points = generate_query_points(lines, std::max<size_t>(n, 64), 100., seed);
+    std::mt19937_64 rng(seed ^ 0x5347543155ULL);
+    std::vector<std::vector<TraceCall>> batches((points.size() + 63) / 64);
+    for (size_t i = 0; i < points.size(); ++i) {
+        TraceCall call;
+        call.op = static_cast<TraceOp>(rng() % 3);
+        call.mode = rng() % 2 ? ProjectionMode::kAccumulate : ProjectionMode::kSimple;
+        call.line_id = rng() % (lines.size() + 2);
+        call.point = points[i];
+        call.other = points[(i * 7 + 1) % points.size()];
+        batches[i / 64].push_back(call);
+    }
+    return batches;
+}
+
+// 记录的调用参数，时间戳不参与比较
+TraceEvent expected_trace_event(const TraceCall &call) {
+    TraceEvent event;
+    event.op = static_cast<uint32_t>(call.op);
+    event.x = bg::get<0>(call.point);
+    event.y = bg::get<1>(call.point);
+    if (call.op != TraceOp::kPointDistance) {
+        event.mode = static_cast<uint32_t>(call.mode);
+    }
+    if (call.op == TraceOp::kLineDistance) {
+        event.line_id = call.line_id;
+    }
+    if (call.op == TraceOp::kPointDistance) {
+        event.x2 = bg::get<0>(call.other);
+        event.y2 = bg::get<1>(call.other);
+    }
+    return event;
+}
+
+// 逐字节不一致的记录数，记录数不同时计入差值
+double trace_error(const std::vector<TraceEvent> &expected, const std::vector<TraceEvent> &actual) {
+    size_t n = std::min(expected.size(), actual.size());
+    double e = static_cast<double>(std::max(expected.size(), actual.size()) - n);
+    for (size_t i = 0; i < n; ++i) {
+        e += std::memcmp(&expected[i], &actual[i], sizeof(TraceEvent)) != 0 ? 1. : 0.;
+    }
+    return e;
+}
+
+// 移动对象：北京、反子午线两侧与北极附近的三个车队，先插入初始位置，再移动到最终位置并删除其中一部分
+struct Fleet {
+    std::vector<PointGeo2> positions;
+    std::vector<bool> removed;
+    MovingObjectIndex<PointGeo2> index;
+
+    Fleet() {
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> unit(-1., 1.);
+        const PointGeo2 centers[] = {PointGeo2(116.4, 39.9), PointGeo2(180., -16.8), PointGeo2(30., 89.98)};
+        for (size_t i = 0; i < 6000; ++i) {
+            auto start = offset(centers[i % 3], unit(rng) * 1500., unit(rng) * 1500.);
+            index.update(i, start);
+            positions.push_back(offset(start, unit(rng) * 1000., unit(rng) * 1000.));
+            removed.push_back(i % 10 == 0);
+        }
+        for (size_t i = 0; i < positions.size(); ++i) {
+            if (removed[i]) {
+                index.remove(i);
+            } else {
+                index.update(i, positions[i]);
+            }
+        }
+    }
+};
+
+const Fleet &moving_fleet() {
+    static const Fleet kFleet;
+    return kFleet;
+}
+
+// 邻近检测的一个时刻：同一组点每 8 个时刻重新生成一次，其余时刻在上一时刻的基础上移动，以覆盖增量更新
+struct ProximityTick {
+    std::shared_ptr<const std::vector<PointGeo2>> points;
+    size_t tick;
+};
+
+std::vector<ProximityTick> generate_proximity_ticks(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(-1., 1.);
+    const PointGeo2 centers[] = {PointGeo2(116.4, 39.9), PointGeo2(180., -16.8), PointGeo2(30., 89.999)};
+    std::vector<ProximityTick> ticks;
+    std::shared_ptr<std::vector<PointGeo2>> points;
+    for (size_t i = 0; i < n; ++i) {
+        auto next = std::make_shared<std::vector<PointGeo2>>();
+        for (size_t k = 0; k < 100; ++k) {
+            if (i % 8 == 0) {
+                next->push_back(offset(centers[(i / 8 + k) % 3], unit(rng) * 300., unit(rng) * 300.));
+            } else {
+                next->push_back(offset((*points)[k], unit(rng) * 10., unit(rng) * 10.));
+            }
+        }
+        points = next;
+        ticks.push_back({points, i});
+    }
+    return ticks;
+}
+
+// 两条带时间戳的随机游走轨迹，时间范围部分重叠，部分相邻顶点的时间戳相同
+struct ApproachCase {
+    std::shared_ptr<const Trajectory<PointGeo2>> a, b;
+    const char *kind;
+};
+
+std::vector<ApproachCase> generate_approach_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    auto make = [&](const PointGeo2 &start, double t0) {
+        auto line = std::make_shared<Trajectory<PointGeo2>>();
+        line->points = *walk(start, unit(rng) * 2 * M_PI, 100 + rng() % 100, 30., false, rng);
+        double t = t0;
+        for (size_t i = 0; i < line->points.size(); ++i) {
+            line->timestamps.push_back(t);
+            t += rng() % 10 == 0 ? 0. : 0.5 + unit(rng) * 2.;
+        }
+        return line;
+    };
+    std::vector<ApproachCase> cases;
+    for (size_t i = 0; i < n; ++i) {
+        const char *kind;
+        PointGeo2 origin;
+        double separation = 500.;
+        switch (rng() % 4) {
+            case 0:
+                kind = "antimeridian";
+                origin = PointGeo2(179.99, -16.8);
+                break;
+            case 1:
+                kind = "polar";
+                origin = PointGeo2(unit(rng) * 360. - 180., 89.99);
+                break;
+            case 2:
+                kind = "far";
+                origin = PointGeo2(116.4, 39.9);
+                separation = 50000.;
+                break;
+            default:
+                kind = "city";
+                origin = PointGeo2(116.4, 39.9);
+                break;
+        }
+        auto a = make(origin, unit(rng) * 100.);
+        auto b = make(offset(origin, (unit(rng) - 0.5) * separation, (unit(rng) - 0.5) * separation), unit(rng) * 100.);
+        cases.push_back({a, b, kind});
+    }
+    return cases;
+}
+
+// 轨迹在 [u, v] 内所在的线段：时间戳不超过 u 的最后一个点，`v` 之前没有其他顶点时刻
+size_t sample_segment(const Trajectory<PointGeo2> &line, double u) {
+    size_t i = std::upper_bound(line.timestamps.begin(), line.timestamps.end(), u) - line.timestamps.begin();
+    return std::min(i == 0 ? 0 : i - 1, line.size() - 1);
+}
+
+// 第 i 个点之后的线段上时刻 t 的位置，经纬度按时间线性插值，经度沿较短的方向；i 为最后一个点时返回该点
+PointGeo2 sample_position(const Trajectory<PointGeo2> &line, size_t i, double t) {
+    if (i + 1 >= line.size()) {
+        return line.points[i];
+    }
+    double f = std::clamp((t - line.timestamps[i]) / (line.timestamps[i + 1] - line.timestamps[i]), 0., 1.);
+    double x0 = bg::get<0>(line.points[i]), y0 = bg::get<1>(line.points[i]);
+    double x = x0 + std::remainder(bg::get<0>(line.points[i + 1]) - x0, 360.) * f;
+    return PointGeo2(std::remainder(x, 360.), y0 + (bg::get<1>(line.points[i + 1]) - y0) * f);
+}
+
+// 采样得到的最近会遇：`approach` 为采样点中的最小距离与时刻，`lower_bound` 为真实最近距离的下界
+struct SampledApproach {
+    ClosestApproach approach;
+    double lower_bound;
+};
+
+// 在共同时间范围内按时间采样两条轨迹，位置与距离只使用 `sample_position` 与 `distance`。两条轨迹的顶点时刻把时间
+// 范围划分为区间，每个区间内两个对象都在同一线段上移动，区间再按 1 秒的步长划分。一个区间内的距离不小于两端距离
+// 的平均值减去两个对象位移之和的一半（区间足够短时位移近似为直线），下界比当前最小值小 1 毫米以上的区间二分细化
+SampledApproach sample_approach(const Trajectory<PointGeo2> &a, const Trajectory<PointGeo2> &b) {
+    static constexpr double kStep = 1.;     // 初始采样步长（秒）
+    static constexpr double kSlack = 1e-3;  // 下界与最小值之差的目标（米）
+
+    SampledApproach result{{}, -1.};
+    if (a.empty() || b.empty()) {
+        return result;
+    }
+    double lo = std::max(a.start_time(), b.start_time()), hi = std::min(a.end_time(), b.end_time());
+    if (lo > hi) {
+        return result;
+    }
+    auto &best = result.approach;
+    auto visit = [&](const PointGeo2 &p, const PointGeo2 &q, double t) {
+        double d = simplegeom::distance(p, q);
+        if (!best.valid() || d < best.distance) {
+            best.distance = d;
+            best.time = t;
+        }
+        return d;
+    };
+    // 右连续：时刻 hi 位于时间戳不超过 hi 的最后一个点之后的线段上
+    visit(sample_position(a, sample_segment(a, hi), hi), sample_position(b, sample_segment(b, hi), hi), hi);
+
+    struct Interval {
+        double u, v;
+        size_t i, j;
+        double du, dv;
+        double lower;
+    };
+    auto make = [&](double u, double v, size_t i, size_t j, double du, double dv) {
+        double moved = simplegeom::distance(sample_position(a, i, u), sample_position(a, i, v)) +
+                       simplegeom::distance(sample_position(b, j, u), sample_position(b, j, v));
+        return Interval{u, v, i, j, du, dv, (du + dv - moved) * 0.5};
+    };
+    std::vector<double> times{lo, hi};
+    for (const auto *line : {&a, &b}) {
+        for (double t : line->timestamps) {
+            if (t > lo && t < hi) {
+                times.push_back(t);
+            }
+        }
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    std::vector<Interval> pending;
+    for (size_t k = 0; k + 1 < times.size(); ++k) {
+        size_t i = sample_segment(a, times[k]), j = sample_segment(b, times[k]);
+        auto steps = static_cast<size_t>(std::ceil((times[k + 1] - times[k]) / kStep));
+        double u = times[k];
+        double du = visit(sample_position(a, i, u), sample_position(b, j, u), u);
+        for (size_t s = 1; s <= steps; ++s) {
+            double v = s == steps ? times[k + 1] : times[k] + (times[k + 1] - times[k]) * s / steps;
+            double dv = visit(sample_position(a, i, v), sample_position(b, j, v), v);
+            pending.push_back(make(u, v, i, j, du, dv));
+            u = v;
+            du = dv;
+        }
+    }
+
+    result.lower_bound = best.distance;
+    while (!pending.empty()) {
+        auto c = pending.back();
+        pending.pop_back();
+        if (c.lower >= best.distance - kSlack) {
+            result.lower_bound = std::min(result.lower_bound, c.lower);
+            continue;
+        }
+        double m = (c.u + c.v) * 0.5;
+        if (m <= c.u || m >= c.v) {
+            result.lower_bound = std::min(result.lower_bound, c.lower);
+            continue;
+        }
+        double dm = visit(sample_position(a, c.i, m), sample_position(b, c.j, m), m);
+        pending.push_back(make(c.u, m, c.i, c.j, c.du, dm));
+        pending.push_back(make(m, c.v, c.i, c.j, dm, c.dv));
+    }
+    result.lower_bound = std::min(result.lower_bound, best.distance);
+    return result;
+}
+
+// 时空范围查询：300 条随机游走轨迹写入小块（64 点）存储，最后一个块不封装，保留在写入缓冲区中
+struct StoreCase {
+    Box<PointGeo2> box;
+    double t0, t1;
+};
+
+struct StoreFixture {
+    std::vector<Trajectory<PointGeo2>> lines;
+    TrajectoryStore<PointGeo2> store{TrajectoryStoreOptions{64, 1e7, 1e3}};
+
+    StoreFixture() {
+        std::mt19937_64 rng(5);
+        std::uniform_real_distribution<double> unit(0., 1.);
+        for (size_t k = 0; k < 300; ++k) {
+            Trajectory<PointGeo2> line;
+            line.points = *walk(offset(PointGeo2(116.4, 39.9), (unit(rng) - 0.5) * 5000., (unit(rng) - 0.5) * 5000.),
+                                unit(rng) * 2 * M_PI, 700, 15., true, rng);
+            double t = unit(rng) * 3600.;
+            for (size_t i = 0; i < line.points.size(); ++i) {
+                line.timestamps.push_back(t);
+                t += unit(rng) * 3.;
+            }
+            store.append(k, line);
+            lines.push_back(std::move(line));
+        }
+    }
+};
+
+const StoreFixture &store_fixture() {
+    static const StoreFixture kFixture;
+    return kFixture;
+}
+
+using StoreKey = std::tuple<uint64_t, int64_t, int64_t, int64_t>;
+
+// 按存储的量化规则（坐标 1e7，时间 1e3）表示的命中点
+StoreKey store_key(uint64_t id, double t, const PointGeo2 &p) {
+    return StoreKey(id, std::llround(t * 1e3), std::llround(bg::get<0>(p) * 1e7), std::llround(bg::get<1>(p) * 1e7));
+}
+
+// 移动与停留交替的轨迹：停留期间在停留点附近 30 米内随机抖动，部分相邻点的时间戳相同
+struct StopCase {
+    std::shared_ptr<const Trajectory<PointGeo2>> line;
+    const char *kind;
+};
+
+std::vector<StopCase> generate_stop_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::vector<StopCase> cases;
+    for (size_t c = 0; c < n; ++c) {
+        const char *kind;
+        PointGeo2 origin;
+        double drift = 0.;  // 停留期间的缓慢移动（米/秒）
+        switch (rng() % 3) {
+            case 0:
+                kind = "antimeridian";
+                origin = PointGeo2(179.9998, -16.8);
+                break;
+            case 1:
+                kind = "drift";
+                origin = PointGeo2(116.4, 39.9);
+                drift = 1.;
+                break;
+            default:
+                kind = "city";
+                origin = PointGeo2(116.4, 39.9);
+                break;
+        }
+        auto line = std::make_shared<Trajectory<PointGeo2>>();
+        double t = 0.;
+        auto push = [&](const PointGeo2 &p) {
+            line->points.push_back(p);
+            line->timestamps.push_back(t);
+            t += rng() % 10 == 0 ? 0. : 1.;
+        };
+        PointGeo2 anchor = origin;
+        while (line->size() < 150) {
+            for (const auto &p : *walk(anchor, unit(rng) * 2 * M_PI, 5 + rng() % 30, 12., false, rng)) {
+                push(p);
+            }
+            anchor = line->points.back();
+            double heading = unit(rng) * 2 * M_PI;
+            for (size_t i = 0, dwell = rng() % 120; i < dwell; ++i) {
+                anchor = offset(anchor, drift * std::cos(heading), drift * std::sin(heading));
+                push(offset(anchor, (unit(rng) - 0.5) * 60., (unit(rng) - 0.5) * 60.));
+            }
+        }
+        cases.push_back({line, kind});
+    }
+    return cases;
+}
+
+// 轨迹中连续一段点的中心：经度相对第一个点展开后求坐标平均
+PointGeo2 reference_center(const Trajectory<PointGeo2> &line, size_t first, size_t last) {
+    double ref = bg::get<0>(line.points[first]), x = 0., y = 0.;
+    for (size_t i = first; i <= last; ++i) {
+        x += ref + wrap_lon(bg::get<0>(line.points[i]) - ref);
+        y += bg::get<1>(line.points[i]);
+    }
+    x /= static_cast<double>(last - first + 1);
+    return PointGeo2(x > 180. ? x - 360. : (x < -180. ? x + 360. : x), y / static_cast<double>(last - first + 1));
+}
+
+// 停留的参考值，半径为各点到中心的最大距离
+StayPoint<PointGeo2> reference_stay(const Trajectory<PointGeo2> &line, size_t first, size_t last) {
+    StayPoint<PointGeo2> stay;
+    stay.center = reference_center(line, first, last);
+    stay.arrival = line.timestamps[first];
+    stay.departure = line.timestamps[last];
+    stay.first = first;
+    stay.last = last;
+    for (size_t i = first; i <= last; ++i) {
+        stay.radius = std::max(stay.radius, simplegeom::distance(stay.center, line.points[i]));
+    }
+    return stay;
+}
+
+// 两组停留的差异：划分不同时为无穷大，否则为中心距离与半径之差的最大值
+double stay_error(const std::vector<StayPoint<PointGeo2>> &a, const std::vector<StayPoint<PointGeo2>> &b) {
+    if (a.size() != b.size()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double error = 0.;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].first != b[i].first || a[i].last != b[i].last) {
+            return std::numeric_limits<double>::infinity();
+        }
+        error = std::max(error, simplegeom::distance(a[i].center, b[i].center));
+        error = std::max(error, std::abs(a[i].radius - b[i].radius));
+    }
+    return error;
+}
+
+std::string describe_stop(const StopCase &c) {
+    return std::string(c.kind) + " " + std::to_string(c.line->size()) + " " + wkt_str(c.line->points.front());
+}
+
+// 带跳点的轨迹：每秒一个点，约 3% 的点偏移 2 公里，偶尔间隔半小时后出现在 20 公里外
+struct KinematicsCase {
+    std::shared_ptr<const Trajectory<PointGeo2>> line;
+    const char *kind;
+};
+
+std::vector<KinematicsCase> generate_kinematics_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::vector<KinematicsCase> cases;
+    for (size_t c = 0; c < n; ++c) {
+        const char *kind;
+        PointGeo2 origin;
+        switch (rng() % 4) {
+            case 0:
+                kind = "antimeridian";
+                origin = PointGeo2(179.999, -16.8);
+                break;
+            case 1:
+                kind = "polar";
+                origin = PointGeo2(unit(rng) * 360. - 180., 88.95);
+                break;
+            case 2:
+                kind = "high";
+                origin = PointGeo2(unit(rng) * 360. - 180., 80.);
+                break;
+            default:
+                kind = "city";
+                origin = PointGeo2(116.4, 39.9);
+                break;
+        }
+        auto line = std::make_shared<Trajectory<PointGeo2>>();
+        line->points = *walk(origin, unit(rng) * 2 * M_PI, 20 + rng() % 100, 12., true, rng);
+        double t = 0.;
+        for (auto &p : line->points) {
+            if (rng() % 100 == 0) {
+                t += 1800.;
+                p = offset(p, 20000., 0.);
+            } else if (rng() % 32 == 0) {
+                p = offset(p, 0., 2000.);
+            }
+            line->timestamps.push_back(t);
+            t += rng() % 10 == 0 ? 0. : 1.;
+        }
+        cases.push_back({line, kind});
+    }
+    return cases;
+}
+
+// 运动参数的参考值：距离取 simplegeom::distance，航向取 Thomas 公式起点方位角与终点反方位角的平均（度，[0, 360)）
+kinematics_detail::Hop reference_hop(const PointGeo2 &p1, const PointGeo2 &p2) {
+    static constexpr double kRad = M_PI / 180.;
+
+    auto r = bg::formula::thomas_inverse<double, false, true, true>::apply(
+        p1.get<0>() * kRad, p1.get<1>() * kRad, p2.get<0>() * kRad, p2.get<1>() * kRad, bg::srs::spheroid<double>());
+    double heading = (r.azimuth + std::remainder(r.reverse_azimuth - r.azimuth, 2 * M_PI) / 2) / kRad;
+    return {simplegeom::distance(p1, p2), heading < 0. ? heading + 360. : heading};
+}
+
+// 热力图输入：城市范围或跨越反子午线的范围（经度 [170, 190]），随机折线有一部分位于范围之外
+struct RasterCase {
+    Box<PointGeo2> extent;
+    size_t width, height;
+    std::shared_ptr<const std::vector<LineString<PointGeo2>>> lines;
+    std::shared_ptr<const std::vector<PointGeo2>> points;
+};
+
+std::vector<RasterCase> generate_raster_cases(size_t n, size_t points_per_case, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::vector<RasterCase> cases;
+    for (size_t c = 0; c < n; ++c) {
+        RasterCase rc;
+        bool wrap = rng() % 2 == 0;
+        rc.extent = wrap ? Box<PointGeo2>(PointGeo2(170., -10.), PointGeo2(190., 10.))
+                         : Box<PointGeo2>(PointGeo2(116.2, 39.8), PointGeo2(116.6, 40.1));
+        rc.width = 8 + rng() % 32;
+        rc.height = 8 + rng() % 32;
+        double min_x = rc.extent.min_corner().get<0>(), max_x = rc.extent.max_corner().get<0>();
+        double min_y = rc.extent.min_corner().get<1>(), max_y = rc.extent.max_corner().get<1>();
+        auto random_point = [&] {
+            double x = min_x + (unit(rng) * 1.2 - 0.1) * (max_x - min_x);
+            return PointGeo2(x > 180. ? x - 360. : x, min_y + (unit(rng) * 1.2 - 0.1) * (max_y - min_y));
+        };
+        auto lines = std::make_shared<std::vector<LineString<PointGeo2>>>();
+        double step = (max_y - min_y) * 111000. / 20.;
+        for (size_t k = 0; k < 4; ++k) {
+            lines->push_back(*walk(random_point(), unit(rng) * 2 * M_PI, 2 + rng() % 20, step, true, rng));
+        }
+        auto points = std::make_shared<std::vector<PointGeo2>>();
+        for (size_t k = 0; k < points_per_case; ++k) {
+            points->push_back(random_point());
+        }
+        rc.lines = lines;
+        rc.points = points;
+        cases.push_back(rc);
+    }
+    return cases;
+}
+
+/**
+ * @brief 逐像素裁剪的折线栅格化：每条线段与每个像素分别求交，得到线段在像素内的参数区间。
+ *
+ * `kCount` 按进入像素的先后顺序计数，相邻的同一像素只计一次，与 `Heatmap` 的语义相同。
+ */
+std::vector<double> rasterize_lines_by_cell(const RasterCase &c, LineRasterMode mode) {
+    size_t w = c.width, h = c.height;
+    double min_x = c.extent.min_corner().get<0>(), max_x = c.extent.max_corner().get<0>();
+    double min_y = c.extent.min_corner().get<1>(), max_y = c.extent.max_corner().get<1>();
+    double sx = static_cast<double>(w) / (max_x - min_x), sy = static_cast<double>(h) / (max_y - min_y);
+    std::vector<double> cells(w * h, 0.);
+    for (const auto &line : *c.lines) {
+        size_t last = cells.size();
+        for (size_t i = 0; i + 1 < line.size(); ++i) {
+            double x0 = bg::get<0>(line[i]), y0 = bg::get<1>(line[i]);
+            double x1 = x0 + wrap_lon(bg::get<0>(line[i + 1]) - x0), y1 = bg::get<1>(line[i + 1]);
+            for (double shift : {-360., 0., 360.}) {
+                double px0 = (x0 + shift - min_x) * sx, py0 = (max_y - y0) * sy;
+                double dx = (x1 + shift - min_x) * sx - px0, dy = (max_y - y1) * sy - py0;
+                double length = std::sqrt(dx * dx + dy * dy);
+                std::vector<std::pair<double, size_t>> entered;
+                for (size_t row = 0; row < h; ++row) {
+                    for (size_t col = 0; col < w; ++col) {
+                        if (length == 0.) {
+                            if (px0 >= col && px0 < col + 1. && py0 >= row && py0 < row + 1.) {
+                                entered.emplace_back(0., row * w + col);
+                            }
+                            continue;
+                        }
+                        double t0 = 0., t1 = 1.;
+                        for (auto [p, q] : {std::pair<double, double>(-dx, px0 - col), {dx, col + 1. - px0},
+                                            {-dy, py0 - row}, {dy, row + 1. - py0}}) {
+                            if (p == 0.) {
+                                t1 = q < 0. ? -1. : t1;
+                            } else if (p < 0.) {
+                                t0 = std::max(t0, q / p);
+                            } else {
+                                t1 = std::min(t1, q / p);
+                            }
+                        }
+                        if (t1 > t0) {
+                            if (mode == LineRasterMode::kCoverage) {
+                                cells[row * w + col] += (t1 - t0) * length;
+                            }
+                            entered.emplace_back(t0, row * w + col);
+                        }
+                    }
+                }
+                std::sort(entered.begin(), entered.end());
+                for (const auto &[t, index] : entered) {
+                    if (mode == LineRasterMode::kCount && index != last) {
+                        cells[index] += 1.;
+                    }
+                    last = index;
+                }
+            }
+        }
+    }
+    return cells;
+}
+
+double max_cell_error(const std::vector<double> &a, const std::vector<double> &b) {
+    double error = 0.;
+    for (size_t i = 0; i < a.size(); ++i) {
+        error = std::max(error, std::abs(a[i] - b[i]));
+    }
+    return error;
+}
+
+// 多边形输入：星形的外环，部分带有一个内环；尺寸从数米的地块到数十公里的区域，覆盖高纬度与反子午线
+struct PolygonCase {
+    std::shared_ptr<const Polygon<PointGeo2>> polygon;
+    const char *kind;
+};
+
+std::vector<PolygonCase> generate_polygon_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::vector<PolygonCase> cases;
+    for (size_t i = 0; i < n; ++i) {
+        const char *kind;
+        double size, lat = unit(rng) * 140. - 70.;
+        double lon = unit(rng) * 360. - 180.;
+        switch (rng() % 4) {
+            case 0:
+                kind = "parcel";
+                size = std::pow(10., 1. + unit(rng) * 2.);
+                break;
+            case 1:
+                kind = "district";
+                size = std::pow(10., 3. + unit(rng) * 1.3);
+                break;
+            case 2:
+                kind = "high";
+                size = std::pow(10., 1. + unit(rng) * 3.);
+                lat = (rng() % 2 == 0 ? 1. : -1.) * (75. + unit(rng) * 10.);
+                break;
+            default:
+                kind = "antimeridian";
+                size = std::pow(10., 2. + unit(rng) * 2.);
+                lon = 180.;
+                break;
+        }
+        PointGeo2 center(lon, lat);
+        auto polygon = std::make_shared<Polygon<PointGeo2>>();
+        auto ring = [&](double radius, size_t vertices, auto &out) {
+            for (size_t k = 0; k < vertices; ++k) {
+                double angle = 2 * M_PI * k / vertices, r = radius * (0.5 + 0.5 * unit(rng));
+                out.push_back(offset(center, r * std::cos(angle), r * std::sin(angle)));
+            }
+            out.push_back(out.front());
+        };
+        ring(size, 3 + rng() % 30, polygon->outer());
+        if (rng() % 3 == 0) {
+            polygon->inners().emplace_back();
+            ring(size * 0.2, 3 + rng() % 8, polygon->inners().back());
+        }
+        bg::correct(*polygon);
+        cases.push_back({polygon, kind});
+    }
+    return cases;
+}
+
+/**
+ * @brief 多边形面积、周长与质心的参考实现。
+ *
+ * 每条边用 Vincenty 正反解加密为 32 段测地线，在等面积圆柱投影中以 long double 计算鞋带公式与一阶矩，q(φ)
+ * 使用含对数的精确公式，质心的纬度用牛顿迭代求 q(φ) 的反函数；周长为各边 Vincenty 距离之和。
+ */
+PolygonMetrics<PointGeo2> reference_polygon_metrics(const Polygon<PointGeo2> &polygon) {
+    using Real = long double;
+    static constexpr int kDivisions = 32;
+    static const bg::srs::spheroid<double> spheroid;
+    static const Real a = 6378137.L, f = 1.L / 298.257223563L, e2 = f * (2.L - f), e = std::sqrt(e2);
+    const double rad = M_PI / 180.;
+    auto q = [&](Real phi) {
+        Real s = std::sin(phi);
+        return (1.L - e2) * (s / (1.L - e2 * s * s) - std::log((1.L - e * s) / (1.L + e * s)) / (2.L * e));
+    };
+    Real lon0 = bg::get<0>(polygon.outer()[0]) * rad, q0 = q(bg::get<1>(polygon.outer()[0]) * rad);
+    Real cross = 0.L, moment_x = 0.L, moment_y = 0.L;
+    double perimeter = 0.;
+    auto add_ring = [&](const Polygon<PointGeo2>::ring_type &ring) {
+        for (size_t i = 0; i + 1 < ring.size(); ++i) {
+            double lon1 = bg::get<0>(ring[i]) * rad, lat1 = bg::get<1>(ring[i]) * rad;
+            double lon2 = bg::get<0>(ring[i + 1]) * rad, lat2 = bg::get<1>(ring[i + 1]) * rad;
+            auto inverse = bg::formula::vincenty_inverse<double, true, true>::apply(lon1, lat1, lon2, lat2, spheroid);
+            perimeter += inverse.distance;
+            Real px = 0.L, py = 0.L;
+            for (int k = 0; k <= kDivisions; ++k) {
+                double lon = lon2, lat = lat2;
+                if (k == 0) {
+                    lon = lon1;
+                    lat = lat1;
+                } else if (k < kDivisions) {
+                    auto direct = bg::formula::vincenty_direct<double, true>::apply(
+                        lon1, lat1, inverse.distance * k / kDivisions, inverse.azimuth, spheroid);
+                    lon = direct.lon2;
+                    lat = direct.lat2;
+                }
+                Real x = std::remainder(static_cast<Real>(lon) - lon0, 2.L * M_PI), y = q(lat) - q0;
+                if (k > 0) {
+                    Real c = px * y - x * py;
+                    cross += c;
+                    moment_x += (px + x) * c;
+                    moment_y += (py + y) * c;
+                }
+                px = x;
+                py = y;
+            }
+        }
+    };
+    add_ring(polygon.outer());
+    for (const auto &inner : polygon.inners()) {
+        add_ring(inner);
+    }
+
+    PolygonMetrics<PointGeo2> metrics;
+    metrics.area = static_cast<double>(-cross * a * a / 4.L);  // y 为 q，带面积为 a²q/2；多边形为顺时针
+    metrics.perimeter = perimeter;
+    Real target = q0 + moment_y / (3.L * cross), phi = std::asin(std::clamp(target / q(M_PI / 2), -1.L, 1.L));
+    for (int k = 0; k < 8; ++k) {
+        Real s = std::sin(phi), w = 1.L - e2 * s * s;
+        phi -= (q(phi) - target) / (2.L * (1.L - e2) * std::cos(phi) / (w * w));
+    }
+    double lon = static_cast<double>(std::remainder(lon0 + moment_x / (3.L * cross), 2.L * M_PI)) / rad;
+    metrics.centroid = PointGeo2(lon, static_cast<double>(phi) / rad);
+    return metrics;
+}
+
+// 面积与周长为相对误差，质心误差为两个质心的距离与多边形尺度（面积的平方根）之比
+template <typename Point>
+double polygon_error(const PolygonMetrics<Point> &a, const PolygonMetrics<Point> &b) {
+    double scale = std::sqrt(std::abs(a.area));
+    return std::max({std::abs(a.area - b.area) / std::abs(a.area), std::abs(a.perimeter - b.perimeter) / a.perimeter,
+                     simplegeom::distance(a.centroid, b.centroid) / scale});
+}
+
+// 凸包输入：均匀分布、高斯簇、圆周上的点（凸包顶点多），以及含大量重复与共线点的整数网格
+struct HullCase {
+    std::shared_ptr<const std::vector<Point2>> points;
+    const char *kind;
+};
+
+std::vector<HullCase> generate_hull_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::normal_distribution<double> normal(0., 1.);
+    std::vector<HullCase> cases;
+    for (size_t i = 0; i < n; ++i) {
+        const char *kind;
+        size_t count = 1 + rng() % 200;
+        auto points = std::make_shared<std::vector<Point2>>();
+        double cx = unit(rng) * 1e4, cy = unit(rng) * 1e4, scale = std::pow(10., unit(rng) * 4.);
+        switch (rng() % 4) {
+            case 0:
+                kind = "uniform";
+                for (size_t k = 0; k < count; ++k) {
+                    points->emplace_back(cx + unit(rng) * scale, cy + unit(rng) * scale * unit(rng));
+                }
+                break;
+            case 1:
+                kind = "gaussian";
+                for (size_t k = 0; k < count; ++k) {
+                    points->emplace_back(cx + normal(rng) * scale, cy + normal(rng) * scale * 0.2);
+                }
+                break;
+            case 2:
+                kind = "circle";
+                for (size_t k = 0; k < count; ++k) {
+                    double angle = unit(rng) * 2 * M_PI, r = scale * (rng() % 4 == 0 ? unit(rng) : 1.);
+                    points->emplace_back(cx + r * std::cos(angle), cy + r * std::sin(angle));
+                }
+                break;
+            default:
+                kind = "grid";
+                for (size_t k = 0; k < count; ++k) {
+                    points->emplace_back(std::floor(cx) + rng() % 6, std::floor(cy) + rng() % 3);
+                }
+                break;
+        }
+        cases.push_back({points, kind});
+    }
+    return cases;
+}
+
+std::string describe_hull(const HullCase &c) {
+    LineString<Point2> line(c.points->begin(), c.points->end());
+    return std::string(c.kind) + " " + wkt_str(line);
+}
+
+// Voronoi 单元的裁剪范围：点集的外包矩形绕中心缩放，按点数交替地小于或大于外包矩形
+Box<Point2> voronoi_box(const std::vector<Point2> &points) {
+    auto box = bg::return_envelope<Box<Point2>>(bg::model::multi_point<Point2>(points.begin(), points.end()));
+    double cx = (bg::get<bg::min_corner, 0>(box) + bg::get<bg::max_corner, 0>(box)) / 2.;
+    double cy = (bg::get<bg::min_corner, 1>(box) + bg::get<bg::max_corner, 1>(box)) / 2.;
+    double factor = points.size() % 2 == 0 ? 0.6 : 1.3;
+    double hx = (bg::get<bg::max_corner, 0>(box) - cx) * factor + 1.;
+    double hy = (bg::get<bg::max_corner, 1>(box) - cy) * factor + 1.;
+    return {{cx - hx, cy - hy}, {cx + hx, cy + hy}};
+}
+
+// 缓冲区与偏移线的输入（米），连接方式、端点样式与分块大小在各个输入之间轮换
+struct BufferCase {
+    std::shared_ptr<const LineString<Point2>> line;
+    double distance;
+    BufferOptions options;
+    const char *kind;
+};
+
+std::vector<BufferCase> generate_buffer_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::normal_distribution<double> turn(0., 0.6);
+    std::vector<BufferCase> cases;
+    for (size_t i = 0; i < n; ++i) {
+        BufferCase c;
+        auto line = std::make_shared<LineString<Point2>>();
+        size_t count = 2 + rng() % 300;
+        double step = 10. + unit(rng) * 190., x = unit(rng) * 1e4, y = unit(rng) * 1e4, heading = unit(rng) * 2 * M_PI;
+        switch (rng() % 3) {
+            case 0:
+                c.kind = "walk";
+                break;
+            case 1:
+                c.kind = "monotone";
+                break;
+            default:
+                c.kind = "zigzag";
+                break;
+        }
+        for (size_t k = 0; k < count; ++k) {
+            line->emplace_back(x, y);
+            if (rng() % 10 == 0) {
+                line->emplace_back(x, y);  // 重复的顶点
+            }
+            double length = step * (0.5 + unit(rng));
+            if (c.kind[0] == 'w') {
+                heading += turn(rng);
+            } else if (c.kind[0] == 'm') {
+                heading = (unit(rng) - 0.5) * 2.;
+            } else {
+                heading = (k % 2 == 0 ? 0.3 : M_PI - 0.3) + (unit(rng) - 0.5) * 0.2;
+            }
+            x += length * std::cos(heading);
+            y += length * std::sin(heading);
+        }
+        c.line = line;
+        c.distance = step * (0.05 + unit(rng) * 2.);
+        c.options.join = static_cast<JoinStyle>(i % 3);
+        c.options.end = static_cast<EndStyle>(i / 3 % 2);
+        c.options.chunk_segments = 8 + rng() % 32;
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+std::string describe_buffer(const BufferCase &c) {
+    static const char *kJoins[] = {"round", "mitre", "flat"};
+    const char *join = kJoins[static_cast<int>(c.options.join)];
+    return std::string(c.kind) + " d=" + std::to_string(c.distance) + " join=" + join +
+           (c.options.end == EndStyle::kRound ? " end=round " : " end=flat ") + wkt_str(*c.line);
+}
+
+// 折线换算到随机选取的起点附近的地理坐标（含反子午线与高纬度），`probes` 为折线附近用于检查的点
+struct GeoBufferCase {
+    BufferCase planar;
+    LineString<PointGeo2> line;
+    std::vector<PointGeo2> probes;
+};
+
+std::vector<GeoBufferCase> generate_geo_buffer_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::vector<GeoBufferCase> cases;
+    for (auto &c : generate_buffer_cases(n, seed)) {
+        GeoBufferCase g{c, {}, {}};
+        PointGeo2 origin(rng() % 4 == 0 ? 180. : unit(rng) * 360. - 180., unit(rng) * 140. - 70.);
+        const auto &line = *c.line;
+        auto to_geo = [&](double x, double y) {
+            return offset(origin, x - bg::get<0>(line[0]), y - bg::get<1>(line[0]));
+        };
+        for (const auto &p : line) {
+            g.line.push_back(to_geo(bg::get<0>(p), bg::get<1>(p)));
+        }
+        for (size_t k = 0; k < 64; ++k) {
+            size_t i = rng() % (line.size() - 1);
+            double t = unit(rng), angle = unit(rng) * 2 * M_PI, r = unit(rng) * 2. * c.distance;
+            double x = bg::get<0>(line[i]) + t * (bg::get<0>(line[i + 1]) - bg::get<0>(line[i]));
+            double y = bg::get<1>(line[i]) + t * (bg::get<1>(line[i + 1]) - bg::get<1>(line[i]));
+            g.probes.push_back(to_geo(x + r * std::cos(angle), y + r * std::sin(angle)));
+        }
+        cases.push_back(std::move(g));
+    }
+    return cases;
+}
+
+// 落在缓冲区内外错误一侧的探测点数，`corridor` 为换算到 `UnionPlane` 中的缓冲区
+double corridor_violations(const GeoBufferCase &c, const MultiPolygon<Point2> &corridor) {
+    buffer_detail::UnionPlane<PointGeo2> plane(c.line.front());
+    double violations = 0.;
+    for (const auto &p : c.probes) {
+        double d = simplegeom::distance(p, c.line);
+        bool inside = bg::within(plane.to_plane(p), corridor);
+        violations += (inside && d > c.planar.distance * 1.01) || (!inside && d < c.planar.distance * 0.99);
+    }
+    return violations;
+}
+
+// 偏移线与生成它的折线和偏移距离
+struct OffsetCurve {
+    LineString<Point2> curve;
+    const LineString<Point2> *line;
+    double distance;
+};
+
+// 逐段平移折线后在相邻的偏移线段之间求交（内侧）或补圆弧（外侧），不使用 `offset_vertex` 的法向公式，
+// 圆弧的分段数与 `offset_line` 的约定相同。要求折线没有连续重复的顶点与折返
+OffsetCurve offset_by_segments(const BufferCase &c) {
+    const auto &line = *c.line;
+    double d = c.distance;
+    OffsetCurve result{{}, c.line.get(), d};
+    std::vector<std::array<double, 4>> segments;  // 偏移线段的起点与方向
+    for (size_t i = 0; i + 1 < line.size(); ++i) {
+        double x = bg::get<0>(line[i]), y = bg::get<1>(line[i]);
+        double ux = bg::get<0>(line[i + 1]) - x, uy = bg::get<1>(line[i + 1]) - y, length = std::hypot(ux, uy);
+        segments.push_back({x - d * uy / length, y + d * ux / length, ux, uy});
+    }
+    result.curve.emplace_back(segments[0][0], segments[0][1]);
+    for (size_t i = 1; i < segments.size(); ++i) {
+        const auto &a = segments[i - 1], &b = segments[i];
+        double cross = a[2] * b[3] - a[3] * b[2], dot = a[2] * b[2] + a[3] * b[3];
+        if (cross == 0.) {
+            result.curve.emplace_back(b[0], b[1]);
+        } else if (cross * d > 0.) {
+            double t = ((b[0] - a[0]) * b[3] - (b[1] - a[1]) * b[2]) / cross;
+            result.curve.emplace_back(a[0] + t * a[2], a[1] + t * a[3]);
+        } else {
+            double x = bg::get<0>(line[i]), y = bg::get<1>(line[i]);
+            double from = std::atan2(a[1] + a[3] - y, a[0] + a[2] - x), delta = std::atan2(cross, dot);
+            auto steps = static_cast<size_t>(std::ceil(std::abs(delta) * c.options.points_per_circle / (2. * M_PI)));
+            steps = std::max<size_t>(steps, 1);
+            for (size_t k = 0; k <= steps; ++k) {
+                double angle = from + delta * static_cast<double>(k) / static_cast<double>(steps);
+                result.curve.emplace_back(x + std::abs(d) * std::cos(angle), y + std::abs(d) * std::sin(angle));
+            }
+        }
+    }
+    const auto &last = segments.back();
+    result.curve.emplace_back(last[0] + last[2], last[1] + last[3]);
+    return result;
+}
+
+// 两条偏移线的对称 Hausdorff 距离（顶点到对方折线）与待测偏移线顶点到原折线距离的误差，均相对于偏移距离
+double offset_error(const OffsetCurve &expected, const OffsetCurve &actual) {
+    if (expected.curve.size() < 2 || actual.curve.size() < 2) {
+        return expected.curve.size() == actual.curve.size() ? 0. : std::numeric_limits<double>::infinity();
+    }
+    double error = 0., d = std::abs(actual.distance);
+    for (const auto &p : expected.curve) {
+        error = std::max(error, bg::distance(p, actual.curve) / d);
+    }
+    for (const auto &p : actual.curve) {
+        error = std::max(error, bg::distance(p, expected.curve) / d);
+        error = std::max(error, std::abs(bg::distance(p, *actual.line) / d - 1.));
+    }
+    return error;
+}
+
+// 折线清理的输入：随机游走的折线，含重复的顶点、共线的顶点与来回的小锯齿，容差与网格间距在输入之间轮换（0 表示
+// 不使用）
+struct CleanCase {
+    std::shared_ptr<const LineString<Point2>> line;
+    CleanOptions options;
+};
+
+std::vector<CleanCase> generate_clean_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::normal_distribution<double> turn(0., 0.5);
+    std::vector<CleanCase> cases;
+    for (size_t i = 0; i < n; ++i) {
+        auto line = std::make_shared<LineString<Point2>>();
+        double x = unit(rng) * 1e4, y = unit(rng) * 1e4, heading = unit(rng) * 2 * M_PI, step = 1. + unit(rng) * 20.;
+        for (size_t k = 0, count = 1 + rng() % 300; k < count; ++k) {
+            line->emplace_back(x, y);
+            switch (rng() % 6) {
+                case 0:
+                    line->emplace_back(x, y);  // 重复的顶点
+                    break;
+                case 1: {
+                    // 来回的小锯齿
+                    double d = step * 0.05 * unit(rng);
+                    line->emplace_back(x + d * std::cos(heading + 2.), y + d * std::sin(heading + 2.));
+                    line->emplace_back(x, y);
+                    break;
+                }
+                case 2:
+                    break;  // 沿原方向继续，产生共线的顶点
+                default:
+                    heading += turn(rng);
+                    break;
+            }
+            double length = step * (0.2 + unit(rng));
+            x += length * std::cos(heading);
+            y += length * std::sin(heading);
+        }
+        CleanCase c{line, {}};
+        c.options.tolerance = i % 3 == 0 ? 0. : step * 0.2 * unit(rng);
+        c.options.grid = i % 2 == 0 ? 0. : step * 0.05 * unit(rng);
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+std::string describe_clean(const CleanCase &c) {
+    return "tolerance=" + std::to_string(c.options.tolerance) + " grid=" + std::to_string(c.options.grid) + " " +
+           wkt_str(*c.line);
+}
+
+// 折线清理的结果与对应的输入
+struct CleanedLine {
+    LineString<Point2> line;
+    const CleanCase *input;
+};
+
+// 折线清理结果违反约定的次数：首尾两点不是吸附后的输入首尾点；顶点不在网格上或不是吸附后的输入顶点；相邻
+// 顶点重合，或最后一段以外的相邻顶点距离不超过容差；吸附后的输入顶点到结果的距离超过容差
+double clean_violations(const CleanCase &c, const LineString<Point2> &cleaned) {
+    const auto &line = *c.line;
+    double grid = c.options.grid, tolerance = c.options.tolerance;
+    auto snapped = [&](const Point2 &p) {
+        if (grid <= 0.) {
+            return p;
+        }
+        return Point2(std::nearbyint(bg::get<0>(p) / grid) * grid, std::nearbyint(bg::get<1>(p) / grid) * grid);
+    };
+    LineString<Point2> input;
+    for (const auto &p : line) {
+        input.push_back(snapped(p));
+    }
+    if (cleaned.empty() || !bg::equals(cleaned.front(), input.front()) || !bg::equals(cleaned.back(), input.back())) {
+        return 1.;
+    }
+    double violations = 0.;
+    std::set<std::pair<double, double>> vertices;
+    for (const auto &p : input) {
+        vertices.emplace(bg::get<0>(p), bg::get<1>(p));
+    }
+    for (size_t i = 0; i < cleaned.size(); ++i) {
+        violations += vertices.count({bg::get<0>(cleaned[i]), bg::get<1>(cleaned[i])}) ? 0. : 1.;
+        if (i > 0) {
+            double d = bg::distance(cleaned[i - 1], cleaned[i]);
+            violations += d == 0. || (i + 1 < cleaned.size() && d <= tolerance) ? 1. : 0.;
+        }
+    }
+    double slack = tolerance * (1. + 1e-9) + 1e-9;
+    for (const auto &p : input) {
+        double d = cleaned.size() == 1 ? bg::distance(p, cleaned.front()) : bg::distance(p, cleaned);
+        violations += d > slack ? 1. : 0.;
+    }
+    return violations;
+}
+
+// 逐点的参考实现：直接吸附每个顶点，与上一个保留的顶点（或候选顶点）比较距离去重，候选顶点每次从上一个保留的
+// 顶点起重新检查所有被跳过的顶点，两个保留顶点之间跳过的顶点数同样不超过 `clean_detail::kMaxRun`
+CleanedLine clean_by_points(const CleanCase &c) {
+    CleanedLine result{{}, &c};
+    double grid = c.options.grid, tolerance = std::max(c.options.tolerance, 0.);
+    std::vector<Point2> points;
+    for (const auto &p : *c.line) {
+        points.push_back(grid <= 0. ? p
+                                    : Point2(std::nearbyint(bg::get<0>(p) / grid) * grid,
+                                             std::nearbyint(bg::get<1>(p) / grid) * grid));
+    }
+    if (points.empty()) {
+        return result;
+    }
+    size_t n = points.size(), a = 0, b = n;
+    std::vector<size_t> kept{0};
+    for (size_t k = 1; k < n; ++k) {
+        if (bg::distance(points[b == n ? a : b], points[k]) <= tolerance) {
+            continue;
+        }
+        bool covered = k - a <= clean_detail::kMaxRun;
+        for (size_t i = a + 1; covered && i < k; ++i) {
+            covered = bg::distance(points[i], Segment<Point2>(points[a], points[k])) <= tolerance;
+        }
+        if (b != n && !covered) {
+            kept.push_back(b);
+            a = b;
+        }
+        b = k;
+    }
+    if (b != n) {
+        kept.push_back(b);
+    }
+    if (kept.back() != n - 1 && !bg::equals(points[kept.back()], points[n - 1])) {
+        kept.push_back(n - 1);
+    }
+    for (size_t k : kept) {
+        result.line.push_back(points[k]);
+    }
+    return result;
+}
+
+// 待测结果违反约定的次数（见 `clean_violations`），容差大于 0 时加上与参考结果不同的顶点数。容差为 0 时共线
+// 顶点的取舍只取决于两种距离公式的舍入误差，两个结果都满足约定即可
+double clean_error(const CleanedLine &expected, const CleanedLine &actual) {
+    double violations = clean_violations(*actual.input, actual.line);
+    if (actual.input->options.tolerance > 0.) {
+        size_t common = std::min(expected.line.size(), actual.line.size());
+        violations += std::max(expected.line.size(), actual.line.size()) - common;
+        for (size_t i = 0; i < common; ++i) {
+            violations += bg::equals(expected.line[i], actual.line[i]) ? 0. : 1.;
+        }
+    }
+    return violations;
+}
+
+// 覆盖化简的输入：`generate_coverage` 生成的小规模覆盖，换算到以西南角为原点的平面（米）。容差从远小于顶点
+// 间距到接近区划边长，较大的容差会触发拓扑检查与细化
+struct CoverageCase {
+    std::shared_ptr<const std::vector<Polygon<Point2>>> polygons;
+    CoverageOptions options;
+    double tolerance;
+};
+
+std::vector<CoverageCase> generate_coverage_cases(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    std::vector<CoverageCase> cases;
+    for (size_t i = 0; i < n; ++i) {
+        CoverageCase c;
+        c.options.seed = rng();
+        c.options.origin = PointGeo2(unit(rng) * 360. - 180., unit(rng) * 120. - 60.);
+        c.options.columns = 1 + rng() % 4;
+        c.options.rows = 1 + rng() % 4;
+        c.options.cell_meters = 100. + unit(rng) * 700.;
+        c.options.vertex_spacing_meters = 5. + unit(rng) * 35.;
+        c.options.roughness = unit(rng) * 0.15;
+        c.options.enclave_ratio = 0.3;
+        c.tolerance = c.options.vertex_spacing_meters * (0.2 + unit(rng) * 20.);
+        LocalFrame<PointGeo2> frame(c.options.origin);
+        auto polygons = std::make_shared<std::vector<Polygon<Point2>>>();
+        for (const auto &geo : generate_coverage(c.options)) {
+            Polygon<Point2> polygon;
+            auto convert = [&](const auto &ring, auto &out) {
+                for (const auto &p : ring) {
+                    auto q = frame.to_local(p);
+                    out.emplace_back(q.x, q.y);
+                }
+            };
+            convert(geo.outer(), polygon.outer());
+            for (const auto &inner : geo.inners()) {
+                polygon.inners().emplace_back();
+                convert(inner, polygon.inners().back());
+            }
+            polygons->push_back(std::move(polygon));
+        }
+        c.polygons = polygons;
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+std::string describe_coverage(const CoverageCase &c) {
+    const auto &o = c.options;
+    return "seed=" + std::to_string(o.seed) + " columns=" + std::to_string(o.columns) + " rows=" +
+           std::to_string(o.rows) + " cell=" + std::to_string(o.cell_meters) + " spacing=" +
+           std::to_string(o.vertex_spacing_meters) + " roughness=" + std::to_string(o.roughness) +
+           " tolerance=" + std::to_string(c.tolerance);
+}
+
+// 化简后的覆盖违反拓扑的次数：无效的多边形；同向重复的边，或只属于一个环、端点却不在输入外边界上的边（缝隙）；
+// 随机点被两个多边形的内部覆盖（重叠），或在输入内部、离输入外边界超过容差却不被覆盖（缝隙）；输入顶点到对应
+// 多边形边界的距离超过容差
+double coverage_violations(const std::vector<Polygon<Point2>> &input, const std::vector<Polygon<Point2>> &output,
+                           double tolerance, uint64_t seed) {
+    if (input.size() != output.size()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    using XY = std::pair<double, double>;
+    auto for_each_edge = [](const Polygon<Point2> &polygon, auto &&func) {
+        auto ring_edges = [&](const auto &ring) {
+            for (size_t i = 0; i + 1 < ring.size(); ++i) {
+                const auto &a = ring[i], &b = ring[i + 1];
+                func(XY(bg::get<0>(a), bg::get<1>(a)), XY(bg::get<0>(b), bg::get<1>(b)));
+            }
+        };
+        ring_edges(polygon.outer());
+        for (const auto &inner : polygon.inners()) {
+            ring_edges(inner);
+        }
+    };
+    double violations = 0.;
+    for (const auto &polygon : output) {
+        violations += bg::is_valid(polygon) ? 0. : 1.;
+    }
+
+    std::map<std::pair<XY, XY>, int> input_edges;
+    for (const auto &polygon : input) {
+        for_each_edge(polygon, [&](const XY &a, const XY &b) { ++input_edges[std::minmax(a, b)]; });
+    }
+    std::set<XY> boundary;
+    std::vector<Segment<Point2>> boundary_edges;
+    for (const auto &edge : input_edges) {
+        if (edge.second == 1) {
+            boundary.insert(edge.first.first);
+            boundary.insert(edge.first.second);
+            boundary_edges.emplace_back(Point2(edge.first.first.first, edge.first.first.second),
+                                        Point2(edge.first.second.first, edge.first.second.second));
+        }
+    }
+    std::map<std::pair<XY, XY>, int> output_edges;
+    for (const auto &polygon : output) {
+        for_each_edge(polygon, [&](const XY &a, const XY &b) { ++output_edges[{a, b}]; });
+    }
+    for (const auto &edge : output_edges) {
+        bool paired = output_edges.count({edge.first.second, edge.first.first}) > 0;
+        if (edge.second > 1 || (!paired && (!boundary.count(edge.first.first) || !boundary.count(edge.first.second)))) {
+            violations += 1.;
+        }
+    }
+
+    Box<Point2> extent;
+    bg::envelope(input.front(), extent);
+    for (const auto &polygon : input) {
+        bg::expand(extent, bg::return_envelope<Box<Point2>>(polygon));
+    }
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> ux(bg::get<bg::min_corner, 0>(extent), bg::get<bg::max_corner, 0>(extent));
+    std::uniform_real_distribution<double> uy(bg::get<bg::min_corner, 1>(extent), bg::get<bg::max_corner, 1>(extent));
+    double slack = tolerance * (1. + 1e-9) + 1e-9;
+    for (size_t k = 0; k < 200; ++k) {
+        Point2 p(ux(rng), uy(rng));
+        size_t covered = 0, inside = 0;
+        for (size_t i = 0; i < output.size(); ++i) {
+            covered += bg::within(p, output[i]) ? 1 : 0;
+            inside += bg::within(p, input[i]) ? 1 : 0;
+        }
+        if (covered > 1) {
+            violations += 1.;
+        } else if (covered == 0 && inside > 0) {
+            double distance = std::numeric_limits<double>::infinity();
+            for (const auto &edge : boundary_edges) {
+                distance = std::min(distance, bg::distance(p, edge));
+            }
+            violations += distance > slack ? 1. : 0.;
+        }
+    }
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        if (output[i].outer().size() < 4) {
+            violations += 1.;
+            continue;
+        }
+        auto deviation = [&](const Point2 &p) {
+            double distance = bg::distance(p, LineString<Point2>(output[i].outer().begin(), output[i].outer().end()));
+            for (const auto &inner : output[i].inners()) {
+                distance = std::min(distance, bg::distance(p, LineString<Point2>(inner.begin(), inner.end())));
+            }
+            return distance;
+        };
+        for (size_t k = 0; k < input[i].outer().size(); k += 3) {
+            violations += deviation(input[i].outer()[k]) > slack ? 1. : 0.;
+        }
+        for (const auto &inner : input[i].inners()) {
+            for (size_t k = 0; k < inner.size(); k += 3) {
+                violations += deviation(inner[k]) > slack ? 1. : 0.;
+            }
+        }
+    }
+    return violations;
+}
+
+// 覆盖化简的结果与对应的输入
+struct SimplifiedCoverage {
+    std::vector<Polygon<Point2>> polygons;
+    const CoverageCase *input;
+};
+
+// 待测结果违反拓扑的次数（见 `coverage_violations`），加上面积与逐个多边形化简的参考结果不一致的多边形数量。
+// 两者到输入边界的距离都不超过容差，面积之差不超过容差乘以输入多边形边界总长的两倍
+double simplified_coverage_error(const SimplifiedCoverage &expected, const SimplifiedCoverage &actual) {
+    const auto &c = *actual.input;
+    const auto &input = *c.polygons;
+    if (expected.polygons.size() != input.size()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double violations = coverage_violations(input, actual.polygons, c.tolerance, c.options.seed);
+    for (size_t i = 0; i < input.size() && i < actual.polygons.size(); ++i) {
+        double bound = 2. * c.tolerance * bg::perimeter(input[i]) * (1. + 1e-9) + 1e-9;
+        violations += std::abs(bg::area(actual.polygons[i]) - bg::area(expected.polygons[i])) > bound ? 1. : 0.;
+    }
+    return violations;
+}
+
+// 两个环的顶点集合（去掉闭合点）中不一致的顶点数量
+template <typename Point>
+double ring_vertex_mismatch(const Polygon<Point> &a, const Polygon<Point> &b) {
+    auto vertices = [](const Polygon<Point> &p) {
+        std::vector<std::pair<double, double>> v;
+        for (size_t i = 0; i + 1 < p.outer().size() || (i == 0 && p.outer().size() == 1); ++i) {
+            v.emplace_back(bg::get<0>(p.outer()[i]), bg::get<1>(p.outer()[i]));
+        }
+        std::sort(v.begin(), v.end());
+        v.erase(std::unique(v.begin(), v.end()), v.end());
+        return v;
+    };
+    auto va = vertices(a), vb = vertices(b);
+    std::vector<std::pair<double, double>> diff;
+    std::set_symmetric_difference(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(diff));
+    return static_cast<double>(diff.size());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    bench::DifferentialSuite suite;
+
+    // 折线投影（带搜索框剪枝）与 Boost.Geometry 的点到折线距离
+    suite.add<LineCase<PointGeo2>, double>(
+        "line/distance_geo2", generate_geo_line_cases,
+        [](const auto &c) { return bg::distance(c.point, *c.line); },
+        [](const auto &c) { return simplegeom::distance(c.point, *c.line, ProjectionMode::kSimple).first; },
+        [](double a, double b) { return std::abs(a - b); }, 1e-6, describe<PointGeo2>);
+
+    suite.add<LineCase<Point2>, double>(
+        "line/distance_point2", generate_cartesian_line_cases,
+        [](const auto &c) { return bg::distance(c.point, *c.line); },
+        [](const auto &c) { return simplegeom::distance(c.point, *c.line, ProjectionMode::kSimple).first; },
+        [](double a, double b) { return std::abs(a - b); }, 1e-9, describe<Point2>);
+
+    // 累积投影距离与逐段计算的参考实现
+    suite.add<LineCase<PointGeo2>, std::pair<double, double>>(
+        "line/measure_geo2", generate_geo_line_cases,
+        [](const auto &c) { return reference_projection(c.point, *c.line); },
+        [](const auto &c) { return simplegeom::distance(c.point, *c.line, ProjectionMode::kAccumulate); },
+        [](const auto &a, const auto &b) {
+            return std::max(std::abs(a.first - b.first), std::abs(a.second - b.second));
+        },
+        1e-6, describe<PointGeo2>);
+
+    // 按步长读取外部坐标缓冲区的视图与 `LineString` 的投影结果必须完全一致
+    suite.add<CoordinateCase<PointGeo2>, std::pair<double, double>>(
+        "view/strided_measure_geo2", coordinate_cases(generate_geo_line_cases),
+        [](const auto &c) { return simplegeom::distance(c.point, *c.line, ProjectionMode::kAccumulate); },
+        [](const auto &c) { return simplegeom::distance(c.point, c.view(), ProjectionMode::kAccumulate); },
+        [](const auto &a, const auto &b) {
+            return std::max(std::abs(a.first - b.first), std::abs(a.second - b.second));
+        },
+        0.);
+
+    suite.add<CoordinateCase<Point2>, std::pair<double, double>>(
+        "view/strided_measure_point2", coordinate_cases(generate_cartesian_line_cases),
+        [](const auto &c) { return simplegeom::distance(c.point, *c.line, ProjectionMode::kAccumulate); },
+        [](const auto &c) { return simplegeom::distance(c.point, c.view(), ProjectionMode::kAccumulate); },
+        [](const auto &a, const auto &b) {
+            return std::max(std::abs(a.first - b.first), std::abs(a.second - b.second));
+        },
+        0.);
+
+    // 按块流式读取的折线文件与载入内存的折线：一条跨越反子午线的长折线，以及一条较短的平面折线
+    static const auto kFileLine = [] {
+        std::mt19937_64 rng(7);
+        return *walk(PointGeo2(179.5, -16.8), 0., 2000, 30., true, rng);
+    }();
+    std::string line_path = "/tmp/simplegeom_differential_" + std::to_string(::getpid()) + ".line";
+    {
+        LineFileWriter<PointGeo2> writer(line_path, 64);
+        writer.append(kFileLine.begin(), kFileLine.end());
+    }
+    static std::unique_ptr<LineFile<PointGeo2>> line_file;
+    line_file = std::make_unique<LineFile<PointGeo2>>(line_path);
+    suite.add<PointGeo2, std::pair<double, double>>(
+        "line_file/measure_geo2",
+        [](size_t n, uint64_t seed) {
+            std::mt19937_64 rng(seed);
+            std::uniform_real_distribution<double> unit(0., 1.);
+            std::vector<PointGeo2> points;
+            for (size_t i = 0; i < n; ++i) {
+                const auto &vertex = kFileLine[rng() % kFileLine.size()];
+                // 少量查询点远离折线，所有块都被跳过
+                double scale = i % 50 == 0 ? 1e5 : 200.;
+                points.push_back(offset(vertex, (unit(rng) - 0.5) * scale, (unit(rng) - 0.5) * scale));
+            }
+            return points;
+        },
+        [](const PointGeo2 &p) { return simplegeom::distance(p, kFileLine, ProjectionMode::kAccumulate); },
+        [](const PointGeo2 &p) { return line_file->project({p}, ProjectionMode::kAccumulate).front(); },
+        [](const auto &a, const auto &b) {
+            return std::max(std::abs(a.first - b.first), std::abs(a.second - b.second));
+        },
+        0., [](const PointGeo2 &p) { return wkt_str(p); });
+
+    // 折线句柄（线段索引 + 缓存的累积长度）与逐段扫描的折线投影
+    suite.add<HandleCase, std::pair<double, double>>(
+        "line_handle/measure_geo2", generate_handle_cases,
+        [](const HandleCase &c) { return simplegeom::distance(c.point, c.line.line(), ProjectionMode::kAccumulate); },
+        [](const HandleCase &c) { return simplegeom::distance(c.point, c.line, ProjectionMode::kAccumulate); },
+        [](const auto &a, const auto &b) {
+            return std::max(std::abs(a.first - b.first), std::abs(a.second - b.second));
+        },
+        1e-6,
+        [](const HandleCase &c) {
+            return std::string(c.kind) + " " + wkt_str(c.point) + " " + wkt_str(c.line.line());
+        });
+
+    // 搜索框必须覆盖以中心点为圆心、半径为边长一半的圆：框内采样点中落在圆内的数量与全部采样点中的相同。中心点
+    // 纬度覆盖到 85 度，经度方向的缩短超过 `create_box` 的余量时框内会漏掉圆内的点
+    suite.add<BoxCase, double>(
+        "box/cover_geo2", [](size_t n, uint64_t seed) { return generate_box_cases(n, seed, 0., 85., 5000.); },
+        [](const BoxCase &c) { return box_hits(c, false); }, [](const BoxCase &c) { return box_hits(c, true); },
+        [](double a, double b) { return std::abs(a - b); }, 0., describe_box);
+
+    // 极点附近的搜索框：中心点纬度在 88 度以上，边长最大 100 公里，部分圆包含极点
+    suite.add<BoxCase, double>(
+        "box/cover_polar_geo2",
+        [](size_t n, uint64_t seed) { return generate_box_cases(n, seed, 88., 90., 100000.); },
+        [](const BoxCase &c) { return box_hits(c, false); }, [](const BoxCase &c) { return box_hits(c, true); },
+        [](double a, double b) { return std::abs(a - b); }, 0., describe_box);
+
+    // 线网投影（R 树 + 预计算累积长度）与逐条折线的暴力搜索
+    static const auto kLines = generate_grid_network([] {
+        RoadNetworkOptions options;
+        options.width_meters = options.height_meters = 3000.;
+        return options;
+    }());
+    static const LineNetwork<PointGeo2> kNetwork(kLines);
+    auto generate_network_queries = [](size_t n, uint64_t seed) {
+        return generate_query_points(kLines, n, 100., seed);
+    };
+
+    suite.add<PointGeo2, NetworkProjection>(
+        "network/project_geo2", generate_network_queries,
+        [](const PointGeo2 &p) {
+            NetworkProjection best;
+            for (size_t id = 0; id < kLines.size(); ++id) {
+                auto [d, m] = simplegeom::distance(p, kLines[id], ProjectionMode::kAccumulate);
+                if (!best.valid() || d < best.distance) {
+                    best.line_id = id;
+                    best.distance = d;
+                    best.project_distance = m;
+                }
+            }
+            return best;
+        },
+        [](const PointGeo2 &p) { return kNetwork.project(p, ProjectionMode::kAccumulate); }, network_error, 1e-6,
+        [](const PointGeo2 &p) { return wkt_str(p); });
+
+    // 分区线网（路由 + 合并）与完整线网
+    static const PartitionedNetwork<PointGeo2> kPartitioned(kLines, [] {
+        PartitionOptions options;
+        options.partitions = 5;
+        options.halo = 1000.;
+        return options;
+    }());
+    suite.add<PointGeo2, NetworkProjection>(
+        "partition/project_geo2", generate_network_queries,
+        [](const PointGeo2 &p) { return kNetwork.project(p, ProjectionMode::kAccumulate); },
+        [](const PointGeo2 &p) { return kPartitioned.project(p, ProjectionMode::kAccumulate); }, network_error, 0.,
+        [](const PointGeo2 &p) { return wkt_str(p); });
+
+    // 共享内存线网与进程内线网的结果必须完全一致
+    std::string shm_name = "/simplegeom_differential_" + std::to_string(::getpid());
+    publish_shared_network(shm_name, kNetwork);
+    static std::unique_ptr<SharedNetwork<PointGeo2>> shared;
+    shared = std::make_unique<SharedNetwork<PointGeo2>>(shm_name);
+    suite.add<PointGeo2, NetworkProjection>(
+        "shared_network/project_geo2", generate_network_queries,
+        [](const PointGeo2 &p) { return kNetwork.project(p, ProjectionMode::kAccumulate); },
+        [](const PointGeo2 &p) { return shared->project(p, ProjectionMode::kAccumulate); }, network_error, 0.,
+        [](const PointGeo2 &p) { return wkt_str(p); });
+
+    // 跨越反子午线的线网：经度归一化到 [-180, 180]，查询框跨越反子午线时需要找到另一侧的折线
+    static const auto kDatelineLines = [] {
+        RoadNetworkOptions options;
+        options.origin = PointGeo2(179.99, -16.8);
+        options.width_meters = options.height_meters = 2000.;
+        auto lines = generate_grid_network(options);
+        for (auto &line : lines) {
+            for (auto &p : line) {
+                bg::set<0>(p, wrap_lon(bg::get<0>(p)));
+            }
+        }
+        return lines;
+    }();
+    static const LineNetwork<PointGeo2> kDatelineNetwork(kDatelineLines);
+    std::string dateline_name = shm_name + "_dateline";
+    publish_shared_network(dateline_name, kDatelineNetwork);
+    static std::unique_ptr<SharedNetwork<PointGeo2>> dateline;
+    dateline = std::make_unique<SharedNetwork<PointGeo2>>(dateline_name);
+    suite.add<PointGeo2, NetworkProjection>(
+        "shared_network/dateline_geo2",
+        [](size_t n, uint64_t seed) {
+            auto points = generate_query_points(kDatelineLines, n, 100., seed);
+            for (auto &p : points) {
+                bg::set<0>(p, wrap_lon(bg::get<0>(p)));
+            }
+            return points;
+        },
+        [](const PointGeo2 &p) { return kDatelineNetwork.project(p, ProjectionMode::kAccumulate); },
+        [](const PointGeo2 &p) { return dateline->project(p, ProjectionMode::kAccumulate); }, network_error, 0.,
+        [](const PointGeo2 &p) { return wkt_str(p); });
+
+    // 调用轨迹的写入与读取：每批调用经 `TracedNetwork` 记录到文件，读回的 56 字节记录必须与调用参数逐字节一致，
+    // 文件大小必须恰好是文件头加整数条记录，时间戳必须单调不减
+    static const std::string trace_path = "/tmp/simplegeom_differential_" + std::to_string(::getpid()) + ".trace";
+    suite.add_check<std::vector<TraceCall>, std::vector<TraceEvent>>(
+        "trace/round_trip_geo2", [](size_t n, uint64_t seed) { return generate_trace_batches(kLines, n, seed); },
+        [](const std::vector<TraceCall> &batch) {
+            std::vector<TraceEvent> events;
+            for (const auto &call : batch) {
+                events.push_back(expected_trace_event(call));
+            }
+            return events;
+        },
+        [](const std::vector<TraceCall> &batch) {
+            {
+                TraceRecorder recorder(trace_path);
+                TracedNetwork<PointGeo2> traced(kNetwork, recorder);
+                for (const auto &call : batch) {
+                    try {
+                        switch (call.op) {
+                            case TraceOp::kNetworkProject:
+                                traced.project(call.point, call.mode);
+                                break;
+                            case TraceOp::kLineDistance:
+                                traced.distance(call.point, call.line_id, call.mode);
+                                break;
+                            case TraceOp::kPointDistance:
+                                traced.distance(call.point, call.other);
+                                break;
+                        }
+                    } catch (const std::out_of_range &) {
+                    }
+                }
+            }
+            std::ifstream in(trace_path, std::ios::binary | std::ios::ate);
+            auto size = static_cast<size_t>(in.tellg());
+            auto events = read_trace(trace_path);
+            if (size != sizeof(TraceFileHeader) + events.size() * sizeof(TraceEvent)) {
+                return std::vector<TraceEvent>();
+            }
+            for (size_t i = 0; i < events.size(); ++i) {
+                if (i > 0 && events[i].timestamp_ns < events[i - 1].timestamp_ns) {
+                    return std::vector<TraceEvent>();
+                }
+            }
+            for (auto &event : events) {
+                event.timestamp_ns = 0;
+            }
+            return events;
+        },
+        trace_error, 0., [](const std::vector<TraceCall> &batch) { return std::to_string(batch.size()) + " calls"; });
+
+    // WKB 解析与 Boost.Geometry 的 WKT 解析：坐标必须逐位一致，截断与伪造点数的数据必须抛出 `std::runtime_error`
+    suite.add<WkbCase, WkbDecoded>(
+        "io/wkb_line_geo2", [](size_t n, uint64_t seed) { return generate_wkb_cases(kLines, n, seed); },
+        [](const WkbCase &c) {
+            return c.expect_error ? WkbDecoded{"runtime_error", {}}
+                                  : WkbDecoded{"", from_wkt<LineString<PointGeo2>>(c.wkt)};
+        },
+        [](const WkbCase &c) {
+            try {
+                return WkbDecoded{"", from_wkb<LineString<PointGeo2>>(c.wkb)};
+            } catch (const std::runtime_error &) {
+                return WkbDecoded{"runtime_error", {}};
+            } catch (const std::exception &) {
+                return WkbDecoded{"other", {}};
+            }
+        },
+        wkb_error, 0., [](const WkbCase &c) { return std::string(c.kind) + " " + c.wkt; });
+
+    // 异步批量投影与逐点同步投影，完成回调持有 `std::promise`（只能移动）
+    static ThreadPool async_pool;
+    static AsyncContext async_context(async_pool, 1);
+    suite.add<std::vector<PointGeo2>, std::vector<NetworkProjection>>(
+        "async/project_batch_geo2",
+        [](size_t n, uint64_t seed) {
+            // 每批 16 个点，总点数与其他线网内核相同
+            auto points = generate_query_points(kLines, std::max<size_t>(n, 16), 100., seed);
+            std::vector<std::vector<PointGeo2>> batches((points.size() + 15) / 16);
+            for (size_t i = 0; i < points.size(); ++i) {
+                batches[i / 16].push_back(points[i]);
+            }
+            return batches;
+        },
+        [](const std::vector<PointGeo2> &batch) {
+            std::vector<NetworkProjection> results;
+            for (const auto &p : batch) {
+                results.push_back(kNetwork.project(p, ProjectionMode::kAccumulate));
+            }
+            return results;
+        },
+        [](const std::vector<PointGeo2> &batch) {
+            std::promise<std::vector<NetworkProjection>> promise;
+            auto future = promise.get_future();
+            project_batch_async(async_context, kNetwork, batch, ProjectionMode::kAccumulate,
+                                [promise = std::move(promise)](auto &result) mutable {
+                                    if (result.ok()) {
+                                        promise.set_value(std::move(result.get()));
+                                    } else {
+                                        promise.set_exception(result.error());
+                                    }
+                                });
+            async_context.run();
+            return future.get();
+        },
+        [](const auto &expected, const auto &actual) {
+            if (expected.size() != actual.size()) {
+                return std::numeric_limits<double>::infinity();
+            }
+            double e = 0.;
+            for (size_t i = 0; i < expected.size(); ++i) {
+                e = std::max(e, network_error(expected[i], actual[i]));
+            }
+            return e;
+        },
+        0.);
+
+    // 异步解析一批 WKT 与对应的 WKB，与逐个同步解析 WKT 的结果比较
+    suite.add<std::vector<WkbCase>, std::vector<WkbDecoded>>(
+        "async/decode_line_geo2",
+        [](size_t n, uint64_t seed) {
+            auto cases = generate_wkb_cases(kLines, std::max<size_t>(n, 8), seed);
+            std::vector<std::vector<WkbCase>> batches((cases.size() + 7) / 8);
+            for (size_t i = 0; i < cases.size(); ++i) {
+                if (!cases[i].expect_error) {
+                    batches[i / 8].push_back(std::move(cases[i]));
+                }
+            }
+            return batches;
+        },
+        [](const std::vector<WkbCase> &batch) {
+            std::vector<WkbDecoded> results;
+            for (int pass = 0; pass < 2; ++pass) {
+                for (const auto &c : batch) {
+                    results.push_back({"", from_wkt<LineString<PointGeo2>>(c.wkt)});
+                }
+            }
+            return results;
+        },
+        [](const std::vector<WkbCase> &batch) {
+            std::vector<std::string> wkts;
+            std::vector<std::vector<uint8_t>> wkbs;
+            for (const auto &c : batch) {
+                wkts.push_back(c.wkt);
+                wkbs.push_back(c.wkb);
+            }
+            std::vector<WkbDecoded> results;
+            auto collect = [&results](auto &result) {
+                for (auto &line : result.get()) {
+                    results.push_back({"", std::move(line)});
+                }
+            };
+            // 两个批次的完成顺序不确定，分别运行到完成，使结果按 WKT、WKB 的顺序收集
+            decode_wkt_async<LineString<PointGeo2>>(async_context, std::move(wkts), collect);
+            async_context.run();
+            decode_wkb_async<LineString<PointGeo2>>(async_context, std::move(wkbs), collect);
+            async_context.run();
+            return results;
+        },
+        [](const auto &expected, const auto &actual) {
+            if (expected.size() != actual.size()) {
+                return std::numeric_limits<double>::infinity();
+            }
+            double e = 0.;
+            for (size_t i = 0; i < expected.size(); ++i) {
+                e = std::max(e, wkb_error(expected[i], actual[i]));
+            }
+            return e;
+        },
+        0.);
+
+    // 移动对象索引的半径查询与逐个对象的暴力搜索，比较结果中不一致的对象数量
+    static constexpr double kMovingRadius = 300.;
+    suite.add<PointGeo2, std::vector<uint64_t>>(
+        "moving/radius_geo2",
+        [](size_t n, uint64_t seed) {
+            const auto &fleet = moving_fleet();
+            std::mt19937_64 rng(seed);
+            std::uniform_real_distribution<double> unit(-1., 1.);
+            std::vector<PointGeo2> points;
+            for (size_t i = 0; i < n; ++i) {
+                const auto &p = fleet.positions[rng() % fleet.positions.size()];
+                points.push_back(offset(p, unit(rng) * 500., unit(rng) * 500.));
+            }
+            return points;
+        },
+        [](const PointGeo2 &p) {
+            const auto &fleet = moving_fleet();
+            std::vector<uint64_t> ids;
+            for (size_t i = 0; i < fleet.positions.size(); ++i) {
+                // 纬度相差 0.01 度（约 1.1 千米）以上的对象不可能在查询半径内
+                if (fleet.removed[i] || std::abs(bg::get<1>(p) - bg::get<1>(fleet.positions[i])) > 0.01) {
+                    continue;
+                }
+                if (simplegeom::distance(p, fleet.positions[i]) <= kMovingRadius) {
+                    ids.push_back(i);
+                }
+            }
+            return ids;
+        },
+        [](const PointGeo2 &p) {
+            std::vector<uint64_t> ids;
+            for (const auto &hit : moving_fleet().index.radius_query(p, kMovingRadius)) {
+                ids.push_back(hit.id);
+            }
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        },
+        [](const auto &a, const auto &b) {
+            std::vector<uint64_t> diff;
+            std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(diff));
+            return static_cast<double>(diff.size());
+        },
+        0., [](const PointGeo2 &p) { return wkt_str(p); });
+
+    // 增量网格邻近检测与两两比较的暴力搜索，比较结果中不一致的点对数量
+    static constexpr double kProximityThreshold = 50.;
+    suite.add<ProximityTick, std::vector<std::pair<uint32_t, uint32_t>>>(
+        "proximity/pairs_geo2", generate_proximity_ticks,
+        [](const ProximityTick &t) {
+            const auto &points = *t.points;
+            std::vector<std::pair<uint32_t, uint32_t>> pairs;
+            for (uint32_t i = 0; i < points.size(); ++i) {
+                for (uint32_t j = i + 1; j < points.size(); ++j) {
+                    if (std::abs(bg::get<1>(points[i]) - bg::get<1>(points[j])) <= 0.01 &&
+                        simplegeom::distance(points[i], points[j]) <= kProximityThreshold) {
+                        pairs.emplace_back(i, j);
+                    }
+                }
+            }
+            return pairs;
+        },
+        [](const ProximityTick &t) {
+            static ProximityDetector<PointGeo2> detector(kProximityThreshold);
+            std::vector<std::pair<uint32_t, uint32_t>> pairs;
+            for (const auto &pair : detector.detect(*t.points, static_cast<double>(t.tick))) {
+                pairs.emplace_back(pair.a, pair.b);
+            }
+            return pairs;
+        },
+        [](const auto &a, const auto &b) {
+            std::vector<std::pair<uint32_t, uint32_t>> diff;
+            std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(diff));
+            return static_cast<double>(diff.size());
+        },
+        0., [](const ProximityTick &t) { return "tick " + std::to_string(t.tick) + " " + wkt_str(t.points->front()); });
+
+    // 按时间窗口外包框剪枝的最近会遇与密集时间采样的参考值（见 `sample_approach`）。误差为待测距离超出参考值的
+    // 下界与采样得到的最小距离之间的部分（米），`closest_approach` 的最近距离最多比真实值大 2 毫米
+    suite.add<ApproachCase, SampledApproach>(
+        "cpa/closest_approach_geo2", generate_approach_cases,
+        [](const ApproachCase &c) { return sample_approach(*c.a, *c.b); },
+        [](const ApproachCase &c) {
+            auto approach = closest_approach(*c.a, *c.b);
+            return SampledApproach{approach, approach.distance};
+        },
+        [](const SampledApproach &ref, const SampledApproach &fast) {
+            if (ref.approach.valid() != fast.approach.valid()) {
+                return std::numeric_limits<double>::infinity();
+            }
+            double d = fast.approach.distance;
+            return std::max(0., d - ref.approach.distance) + std::max(0., ref.lower_bound - d);
+        },
+        2e-3, [](const ApproachCase &c) { return std::string(c.kind) + " " + wkt_str(c.a->points.front()); });
+
+    // 轨迹存储的时空范围查询（块剪枝 + 解码）与逐点扫描
+    suite.add<StoreCase, std::vector<StoreKey>>(
+        "store/query_geo2",
+        [](size_t n, uint64_t seed) {
+            const auto &fixture = store_fixture();
+            std::mt19937_64 rng(seed);
+            std::uniform_real_distribution<double> unit(0., 1.);
+            std::vector<StoreCase> cases;
+            for (size_t i = 0; i < n; ++i) {
+                const auto &line = fixture.lines[rng() % fixture.lines.size()];
+                size_t k = rng() % line.size();
+                double t0 = line.timestamps[k] - unit(rng) * 600., t1 = t0 + unit(rng) * 1200.;
+                cases.push_back({create_box(line.points[k], 100. + unit(rng) * 2000.), t0, t1});
+            }
+            return cases;
+        },
+        [](const StoreCase &c) {
+            const auto &fixture = store_fixture();
+            auto lo = store_key(0, c.t0, c.box.min_corner()), hi = store_key(0, c.t1, c.box.max_corner());
+            std::vector<StoreKey> keys;
+            for (size_t k = 0; k < fixture.lines.size(); ++k) {
+                const auto &line = fixture.lines[k];
+                for (size_t i = 0; i < line.size(); ++i) {
+                    auto key = store_key(k, line.timestamps[i], line.points[i]);
+                    if (std::get<1>(key) >= std::get<1>(lo) && std::get<1>(key) <= std::get<1>(hi) &&
+                        std::get<2>(key) >= std::get<2>(lo) && std::get<2>(key) <= std::get<2>(hi) &&
+                        std::get<3>(key) >= std::get<3>(lo) && std::get<3>(key) <= std::get<3>(hi)) {
+                        keys.push_back(key);
+                    }
+                }
+            }
+            std::sort(keys.begin(), keys.end());
+            return keys;
+        },
+        [](const StoreCase &c) {
+            std::vector<StoreKey> keys;
+            for (const auto &hit : store_fixture().store.query(c.box, c.t0, c.t1)) {
+                keys.push_back(store_key(hit.object_id, hit.timestamp, hit.point));
+            }
+            std::sort(keys.begin(), keys.end());
+            return keys;
+        },
+        [](const auto &a, const auto &b) {
+            std::vector<StoreKey> diff;
+            std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(diff));
+            return static_cast<double>(diff.size());
+        },
+        0.,
+        [](const StoreCase &c) {
+            return wkt_str(c.box) + " " + std::to_string(c.t0) + " " + std::to_string(c.t1);
+        });
+
+    // 增量维护中心的流式停留检测与每个点都重新计算中心的逐点实现
+    suite.add<StopCase, std::vector<StayPoint<PointGeo2>>>(
+        "stay/stay_points_geo2", generate_stop_cases,
+        [](const StopCase &c) {
+            const StayPointOptions options{100., 60.};
+            const auto &line = *c.line;
+            std::vector<StayPoint<PointGeo2>> stays;
+            auto close = [&](size_t first, size_t last) {
+                if (line.timestamps[last] - line.timestamps[first] >= options.min_duration) {
+                    stays.push_back(reference_stay(line, first, last));
+                }
+            };
+            size_t first = 0;
+            for (size_t i = 1; i < line.size(); ++i) {
+                if (simplegeom::distance(reference_center(line, first, i - 1), line.points[i]) > options.distance) {
+                    close(first, i - 1);
+                    first = i;
+                }
+            }
+            close(first, line.size() - 1);
+            return stays;
+        },
+        [](const StopCase &c) { return detect_stay_points(*c.line, StayPointOptions{100., 60.}); }, stay_error, 1e-6,
+        describe_stop);
+
+    // 双指针维护邻域的密度停留检测与逐点向两侧累加路程的实现
+    suite.add<StopCase, std::vector<StayPoint<PointGeo2>>>(
+        "stay/density_geo2", generate_stop_cases,
+        [](const StopCase &c) {
+            const DensityStopOptions options{50., 30.};
+            const auto &line = *c.line;
+            size_t n = line.size();
+            std::vector<double> segments(n, 0.);  // 第 i 段为第 i - 1 个点到第 i 个点
+            for (size_t i = 1; i < n; ++i) {
+                segments[i] = simplegeom::distance(line.points[i - 1], line.points[i]);
+            }
+            std::vector<bool> core(n);
+            for (size_t i = 0; i < n; ++i) {
+                size_t lo = i, hi = i;
+                for (double length = 0.; lo > 0 && length + segments[lo] <= options.eps; --lo) {
+                    length += segments[lo];
+                }
+                for (double length = 0.; hi + 1 < n && length + segments[hi + 1] <= options.eps; ++hi) {
+                    length += segments[hi + 1];
+                }
+                core[i] = line.timestamps[hi] - line.timestamps[lo] >= options.min_duration;
+            }
+            std::vector<StayPoint<PointGeo2>> stays;
+            for (size_t i = 0; i < n;) {
+                size_t j = i;
+                while (j < n && core[j] == core[i]) {
+                    ++j;
+                }
+                if (core[i]) {
+                    stays.push_back(reference_stay(line, i, j - 1));
+                }
+                i = j;
+            }
+            return stays;
+        },
+        [](const StopCase &c) { return detect_stops_density(*c.line, DensityStopOptions{50., 30.}); }, stay_error,
+        1e-6, describe_stop);
+
+    // 局部平面近似的距离与航向与测地距离和 Thomas 公式方位角比较，误差为两个端点位置之差与距离之比
+    suite.add<std::pair<PointGeo2, PointGeo2>, kinematics_detail::Hop>(
+        "kinematics/hop_geo2",
+        [](size_t n, uint64_t seed) {
+            std::mt19937_64 rng(seed);
+            std::uniform_real_distribution<double> unit(0., 1.);
+            std::vector<std::pair<PointGeo2, PointGeo2>> cases;
+            for (size_t i = 0; i < n; ++i) {
+                PointGeo2 p(rng() % 8 == 0 ? 179.99 : unit(rng) * 360. - 180., unit(rng) * 180. - 90.);
+                double d = std::pow(10., unit(rng) * 4.), heading = unit(rng) * 2 * M_PI;
+                cases.emplace_back(p, offset(p, d * std::sin(heading), d * std::cos(heading)));
+            }
+            return cases;
+        },
+        [](const auto &c) { return reference_hop(c.first, c.second); },
+        [](const auto &c) {
+            LineString<PointGeo2> points{c.first, c.second};
+            kinematics_detail::GeoScales scales(points);
+            return kinematics_detail::hop(points, scales, 0, 1, KinematicsOptions().max_hop);
+        },
+        [](const kinematics_detail::Hop &a, const kinematics_detail::Hop &b) {
+            double angle = std::abs(wrap_lon(a.heading - b.heading)) * M_PI / 180.;
+            return (std::abs(a.distance - b.distance) + angle * a.distance) / std::max(a.distance, 1.);
+        },
+        1e-5, [](const auto &c) { return wkt_str(c.first) + " " + wkt_str(c.second); });
+
+    // 一次遍历的运动参数与离群点过滤，与逐段计算测地距离和方位角的实现比较
+    suite.add<KinematicsCase, TrajectoryKinematics>(
+        "kinematics/trajectory_geo2", generate_kinematics_cases,
+        [](const KinematicsCase &c) {
+            const auto &line = *c.line;
+            size_t n = line.size();
+            const double max_speed = 50.;
+            TrajectoryKinematics k;
+            k.speed.assign(n, std::numeric_limits<double>::quiet_NaN());
+            k.heading = k.acceleration = k.speed;
+            k.outlier.assign(n, 0);
+            auto speed = [&](size_t i, size_t j) {
+                double d = simplegeom::distance(line.points[i], line.points[j]);
+                double dt = line.timestamps[j] - line.timestamps[i];
+                return d == 0. ? 0. : (dt > 0. ? d / dt : std::numeric_limits<double>::infinity());
+            };
+            std::vector<size_t> valid;
+            for (size_t i = 0; i < n; ++i) {
+                bool bad_in = valid.empty() || speed(valid.back(), i) > max_speed;
+                bool bad_out = i + 1 == n || speed(i, i + 1) > max_speed;
+                if (n > 1 && bad_in && bad_out) {
+                    k.outlier[i] = 1;
+                } else {
+                    valid.push_back(i);
+                }
+            }
+            for (size_t v = 0; v < valid.size(); ++v) {
+                size_t i = valid[v];
+                k.speed[i] = k.heading[i] = k.acceleration[i] = 0.;
+                if (v == 0) {
+                    continue;
+                }
+                size_t p = valid[v - 1];
+                auto h = reference_hop(line.points[p], line.points[i]);
+                double dt = line.timestamps[i] - line.timestamps[p];
+                k.speed[i] = dt > 0. ? h.distance / dt : k.speed[p];
+                k.heading[i] = h.distance > 0. ? h.heading : k.heading[p];
+                if (v == 1) {
+                    k.speed[p] = k.speed[i];
+                    k.heading[p] = k.heading[i];
+                }
+                k.acceleration[i] = dt > 0. ? (k.speed[i] - k.speed[p]) / dt : 0.;
+            }
+            return k;
+        },
+        [](const KinematicsCase &c) { return compute_kinematics(*c.line, KinematicsOptions{50., 10000.}); },
+        [](const TrajectoryKinematics &a, const TrajectoryKinematics &b) {
+            double error = 0.;
+            for (size_t i = 0; i < a.speed.size(); ++i) {
+                if (a.outlier[i] != b.outlier[i]) {
+                    return std::numeric_limits<double>::infinity();
+                }
+                if (a.outlier[i]) {
+                    continue;
+                }
+                double heading = std::abs(wrap_lon(a.heading[i] - b.heading[i]));
+                error = std::max({error, std::abs(a.speed[i] - b.speed[i]),
+                                  std::abs(a.acceleration[i] - b.acceleration[i]), heading});
+            }
+            return error;
+        },
+        1e-3, [](const KinematicsCase &c) { return std::string(c.kind) + " " + wkt_str(c.line->points.front()); });
+
+    // 分线程累加后合并的点栅格化与逐点计算像素的实现，每个输入 20 万个点
+    suite.add<RasterCase, std::vector<double>>(
+        "raster/points_geo2",
+        [](size_t n, uint64_t seed) { return generate_raster_cases(std::max<size_t>(1, n / 1000), 200000, seed); },
+        [](const RasterCase &c) {
+            double min_x = c.extent.min_corner().get<0>(), max_x = c.extent.max_corner().get<0>();
+            double min_y = c.extent.min_corner().get<1>(), max_y = c.extent.max_corner().get<1>();
+            std::vector<double> cells(c.width * c.height, 0.);
+            for (const auto &p : *c.points) {
+                double x = bg::get<0>(p), y = bg::get<1>(p);
+                x = x < min_x ? x + 360. : x;
+                if (x < min_x || x > max_x || y < min_y || y > max_y) {
+                    continue;
+                }
+                auto col = std::min(c.width - 1, static_cast<size_t>((x - min_x) * c.width / (max_x - min_x)));
+                auto row = std::min(c.height - 1, static_cast<size_t>((max_y - y) * c.height / (max_y - min_y)));
+                cells[row * c.width + col] += 1.;
+            }
+            return cells;
+        },
+        [](const RasterCase &c) {
+            static ThreadPool pool(4);
+            Heatmap<PointGeo2> heatmap(c.extent, c.width, c.height);
+            rasterize_points(heatmap, *c.points, {}, &pool);
+            return heatmap.cells();
+        },
+        max_cell_error, 0., [](const RasterCase &c) { return wkt_str(c.extent) + " " + std::to_string(c.width); });
+
+    // 沿像素边界遍历的折线栅格化（长度加权与计数）与逐像素裁剪的实现
+    suite.add<RasterCase, std::vector<double>>(
+        "raster/lines_coverage_geo2",
+        [](size_t n, uint64_t seed) { return generate_raster_cases(std::max<size_t>(1, n / 4), 0, seed); },
+        [](const RasterCase &c) { return rasterize_lines_by_cell(c, LineRasterMode::kCoverage); },
+        [](const RasterCase &c) {
+            Heatmap<PointGeo2> heatmap(c.extent, c.width, c.height);
+            rasterize_lines(heatmap, *c.lines);
+            return heatmap.cells();
+        },
+        max_cell_error, 1e-9, [](const RasterCase &c) { return wkt_str(c.extent) + " " + wkt_str(c.lines->front()); });
+
+    suite.add<RasterCase, std::vector<double>>(
+        "raster/lines_count_geo2",
+        [](size_t n, uint64_t seed) { return generate_raster_cases(std::max<size_t>(1, n / 4), 0, seed); },
+        [](const RasterCase &c) { return rasterize_lines_by_cell(c, LineRasterMode::kCount); },
+        [](const RasterCase &c) {
+            Heatmap<PointGeo2> heatmap(c.extent, c.width, c.height);
+            rasterize_lines(heatmap, *c.lines, {}, LineRasterMode::kCount);
+            return heatmap.cells();
+        },
+        max_cell_error, 0., [](const RasterCase &c) { return wkt_str(c.extent) + " " + wkt_str(c.lines->front()); });
+
+    // 等面积投影中一次遍历的面积、周长与质心，与加密为测地线的高精度参考实现比较
+    suite.add<PolygonCase, PolygonMetrics<PointGeo2>>(
+        "polygon/metrics_geo2", generate_polygon_cases,
+        [](const PolygonCase &c) { return reference_polygon_metrics(*c.polygon); },
+        [](const PolygonCase &c) { return polygon_metrics(*c.polygon); }, polygon_error<PointGeo2>, 5e-5,
+        [](const PolygonCase &c) { return std::string(c.kind) + " " + wkt_str(*c.polygon); });
+
+    // 平面坐标与 Boost.Geometry 的面积、周长与质心
+    suite.add<Polygon<Point2>, PolygonMetrics<Point2>>(
+        "polygon/metrics_point2",
+        [](size_t n, uint64_t seed) {
+            std::vector<Polygon<Point2>> polygons;
+            for (const auto &c : generate_polygon_cases(n, seed)) {
+                Polygon<Point2> polygon;
+                bg::convert(*c.polygon, polygon);
+                bg::correct(polygon);
+                polygons.push_back(polygon);
+            }
+            return polygons;
+        },
+        [](const Polygon<Point2> &p) {
+            PolygonMetrics<Point2> metrics;
+            metrics.area = bg::area(p);
+            metrics.perimeter = bg::perimeter(p);
+            bg::centroid(p, metrics.centroid);
+            return metrics;
+        },
+        [](const Polygon<Point2> &p) { return polygon_metrics(p); }, polygon_error<Point2>, 1e-9,
+        [](const Polygon<Point2> &p) { return wkt_str(p); });
+
+    // 单调链凸包与 Boost.Geometry 的凸包，比较顶点集合中不一致的顶点数量
+    suite.add<HullCase, Polygon<Point2>>(
+        "hull/monotone_chain_point2", generate_hull_cases,
+        [](const HullCase &c) {
+            bg::model::multi_point<Point2> points(c.points->begin(), c.points->end());
+            Polygon<Point2> hull;
+            bg::convex_hull(points, hull);
+            return hull;
+        },
+        [](const HullCase &c) { return convex_hull(*c.points); }, ring_vertex_mismatch<Point2>, 0., describe_hull);
+
+    suite.add<HullCase, Polygon<Point2>>(
+        "hull/quickhull_point2", generate_hull_cases, [](const HullCase &c) { return convex_hull(*c.points); },
+        [](const HullCase &c) { return convex_hull(*c.points, HullAlgorithm::kQuickhull); },
+        ring_vertex_mismatch<Point2>, 0., describe_hull);
+
+    // 并行排序（4 个线程）与单线程排序的单调链凸包必须完全一致，点位于圆周附近，预筛选后仍超过并行阈值
+    suite.add<HullCase, Polygon<Point2>>(
+        "hull/parallel_sort_point2",
+        [](size_t n, uint64_t seed) {
+            std::mt19937_64 rng(seed);
+            std::uniform_real_distribution<double> unit(0., 1.);
+            std::vector<HullCase> cases;
+            for (size_t i = 0; i < std::max<size_t>(1, n / 1000); ++i) {
+                auto points = std::make_shared<std::vector<Point2>>();
+                for (size_t k = 0; k < 100000 + rng() % 1000; ++k) {
+                    double angle = unit(rng) * 2 * M_PI, r = std::round(1e4 * (1. - unit(rng) * 1e-3));
+                    points->emplace_back(std::round(r * std::cos(angle)), std::round(r * std::sin(angle)));
+                }
+                cases.push_back({points, "large"});
+            }
+            return cases;
+        },
+        [](const HullCase &c) { return convex_hull(*c.points); },
+        [](const HullCase &c) {
+            static ThreadPool pool(4);
+            return convex_hull(*c.points, HullAlgorithm::kMonotoneChain, &pool);
+        },
+        ring_vertex_mismatch<Point2>, 0., [](const HullCase &c) { return std::to_string(c.points->size()); });
+
+    // 旋转卡壳的最小外接矩形与逐条凸包边计算外接矩形的实现，比较面积的相对误差；矩形未覆盖所有点时误差为无穷大
+    suite.add<HullCase, double>(
+        "hull/rectangle_point2", generate_hull_cases,
+        [](const HullCase &c) {
+            bg::model::multi_point<Point2> points(c.points->begin(), c.points->end());
+            Polygon<Point2> hull;
+            bg::convex_hull(points, hull);
+            const auto &ring = hull.outer();
+            double best = ring.size() < 4 ? 0. : std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i + 1 < ring.size() && ring.size() >= 4; ++i) {
+                double ex = bg::get<0>(ring[i + 1]) - bg::get<0>(ring[i]);
+                double ey = bg::get<1>(ring[i + 1]) - bg::get<1>(ring[i]);
+                double length = std::hypot(ex, ey);
+                double lo = 0., hi = 0., bottom = 0., top = 0.;
+                for (const auto &p : ring) {
+                    double dx = bg::get<0>(p) - bg::get<0>(ring[i]), dy = bg::get<1>(p) - bg::get<1>(ring[i]);
+                    double u = (dx * ex + dy * ey) / length, v = (dx * -ey + dy * ex) / length;
+                    lo = std::min(lo, u);
+                    hi = std::max(hi, u);
+                    bottom = std::min(bottom, v);
+                    top = std::max(top, v);
+                }
+                best = std::min(best, (hi - lo) * (top - bottom));
+            }
+            return best;
+        },
+        [](const HullCase &c) {
+            auto rectangle = minimum_bounding_rectangle(*c.points);
+            double area = rectangle.outer().size() < 4 ? 0. : bg::area(rectangle);
+            double scale = std::sqrt(area) + 1.;
+            for (const auto &p : *c.points) {
+                if (area > 0. && !bg::covered_by(p, rectangle) && bg::distance(p, rectangle) > 1e-9 * scale) {
+                    return std::numeric_limits<double>::infinity();
+                }
+            }
+            return area;
+        },
+        [](double a, double b) { return std::abs(a - b) / std::max(a, 1e-12); }, 1e-9, describe_hull);
+
+    // 凸包顶点上的随机增量最小外接圆与枚举两点、三点圆的实现，比较半径的相对误差；圆未覆盖所有点时误差为无穷大
+    suite.add<HullCase, double>(
+        "hull/circle_point2",
+        [](size_t n, uint64_t seed) {
+            auto cases = generate_hull_cases(n, seed);
+            auto large = [](const HullCase &c) { return c.points->size() > 40; };
+            cases.erase(std::remove_if(cases.begin(), cases.end(), large), cases.end());
+            return cases;
+        },
+        [](const HullCase &c) {
+            const auto &points = *c.points;
+            double best = std::numeric_limits<double>::infinity();
+            auto consider = [&](double cx, double cy, double r) {
+                for (const auto &p : points) {
+                    if (std::hypot(bg::get<0>(p) - cx, bg::get<1>(p) - cy) > r * (1. + 1e-9)) {
+                        return;
+                    }
+                }
+                best = std::min(best, r);
+            };
+            consider(bg::get<0>(points[0]), bg::get<1>(points[0]), 0.);
+            for (size_t i = 0; i < points.size(); ++i) {
+                double ax = bg::get<0>(points[i]), ay = bg::get<1>(points[i]);
+                for (size_t j = i + 1; j < points.size(); ++j) {
+                    double bx = bg::get<0>(points[j]) - ax, by = bg::get<1>(points[j]) - ay;
+                    consider(ax + bx / 2., ay + by / 2., std::hypot(bx, by) / 2.);
+                    for (size_t k = j + 1; k < points.size(); ++k) {
+                        double qx = bg::get<0>(points[k]) - ax, qy = bg::get<1>(points[k]) - ay;
+                        double d = 2. * (bx * qy - by * qx);
+                        if (d != 0.) {
+                            double b2 = bx * bx + by * by, q2 = qx * qx + qy * qy;
+                            double ux = (qy * b2 - by * q2) / d, uy = (bx * q2 - qx * b2) / d;
+                            consider(ax + ux, ay + uy, std::hypot(ux, uy));
+                        }
+                    }
+                }
+            }
+            return best;
+        },
+        [](const HullCase &c) {
+            auto circle = minimum_bounding_circle(*c.points);
+            for (const auto &p : *c.points) {
+                if (bg::distance(p, circle.center) > circle.radius * (1. + 1e-9) + 1e-9) {
+                    return std::numeric_limits<double>::infinity();
+                }
+            }
+            return circle.radius;
+        },
+        [](double a, double b) { return std::abs(a - b) / std::max(a, 1e-12); }, 1e-9, describe_hull);
+
+    // 地理坐标的凸包与先将经纬度换算为相对第一个点的平面坐标、再计算平面凸包的结果必须完全一致，覆盖跨越反子午线
+    // 的点集。Boost 的共线判断带有容差，米级范围内近似共线的点是否作为顶点与精确判断不同，因此不作为参考
+    suite.add<std::vector<PointGeo2>, Polygon<PointGeo2>>(
+        "hull/monotone_chain_geo2",
+        [](size_t n, uint64_t seed) {
+            std::vector<std::vector<PointGeo2>> cases;
+            std::mt19937_64 rng(seed);
+            std::uniform_real_distribution<double> unit(0., 1.);
+            for (const auto &c : generate_hull_cases(n, seed)) {
+                PointGeo2 origin(rng() % 2 == 0 ? 180. : unit(rng) * 360. - 180., unit(rng) * 160. - 80.);
+                const auto &first = c.points->front();
+                std::vector<PointGeo2> points;
+                for (const auto &p : *c.points) {
+                    double dx = bg::get<0>(p) - bg::get<0>(first), dy = bg::get<1>(p) - bg::get<1>(first);
+                    points.push_back(offset(origin, dx, dy));
+                }
+                cases.push_back(points);
+            }
+            return cases;
+        },
+        [](const std::vector<PointGeo2> &points) {
+            // 坐标相对第一个点计算，避免在经度 ±180 附近损失精度
+            double lon0 = bg::get<0>(points.front()), lat0 = bg::get<1>(points.front());
+            std::vector<Point2> planar;
+            std::map<std::pair<double, double>, PointGeo2> original;
+            for (const auto &p : points) {
+                planar.emplace_back(wrap_lon(bg::get<0>(p) - lon0), bg::get<1>(p) - lat0);
+                original[{bg::get<0>(planar.back()), bg::get<1>(planar.back())}] = p;
+            }
+            auto planar_hull = convex_hull(planar);
+            Polygon<PointGeo2> hull;
+            for (const auto &p : planar_hull.outer()) {
+                hull.outer().push_back(original.at({bg::get<0>(p), bg::get<1>(p)}));
+            }
+            return hull;
+        },
+        [](const std::vector<PointGeo2> &points) { return convex_hull(points); }, ring_vertex_mismatch<PointGeo2>, 0.,
+        [](const std::vector<PointGeo2> &points) {
+            return wkt_str(LineString<PointGeo2>(points.begin(), points.end()));
+        });
+
+    // Delaunay 三角剖分逐个三角形检查空圆性质（long double 计算，相对容差 1e-15），同时三角形的个数必须
+    // 满足欧拉公式 2m - 2 - h（m 为不同的点数，h 为凸包边界上的点数），面积之和必须等于凸包面积
+    suite.add<HullCase, std::array<double, 3>>(
+        "delaunay/empty_circle_point2", generate_hull_cases,
+        [](const HullCase &c) {
+            auto points = *c.points;
+            std::sort(points.begin(), points.end(), [](const Point2 &a, const Point2 &b) {
+                return std::make_pair(bg::get<0>(a), bg::get<1>(a)) < std::make_pair(bg::get<0>(b), bg::get<1>(b));
+            });
+            points.erase(std::unique(points.begin(), points.end(),
+                                     [](const Point2 &a, const Point2 &b) { return bg::equals(a, b); }),
+                         points.end());
+            auto hull = convex_hull(points);
+            const auto &ring = hull.outer();
+            double area = std::abs(bg::area(hull));
+            if (area == 0.) {
+                return std::array<double, 3>{0., 0., 0.};
+            }
+            size_t boundary = 0;
+            for (const auto &p : points) {
+                long double px = bg::get<0>(p), py = bg::get<1>(p);
+                for (size_t i = 0; i + 1 < ring.size(); ++i) {
+                    long double ax = bg::get<0>(ring[i]), ay = bg::get<1>(ring[i]);
+                    long double bx = bg::get<0>(ring[i + 1]), by = bg::get<1>(ring[i + 1]);
+                    if ((bx - ax) * (py - ay) - (by - ay) * (px - ax) == 0 && px >= std::min(ax, bx) &&
+                        px <= std::max(ax, bx) && py >= std::min(ay, by) && py <= std::max(ay, by)) {
+                        ++boundary;
+                        break;
+                    }
+                }
+            }
+            return std::array<double, 3>{0., 2. * points.size() - 2. - boundary, area};
+        },
+        [](const HullCase &c) {
+            const auto &points = *c.points;
+            auto triangulation = delaunay_triangulation(points);
+            double violations = 0., area = 0.;
+            for (const auto &t : triangulation.triangles) {
+                long double ax = bg::get<0>(points[t[0]]), ay = bg::get<1>(points[t[0]]);
+                long double bx = bg::get<0>(points[t[1]]), by = bg::get<1>(points[t[1]]);
+                long double cx = bg::get<0>(points[t[2]]), cy = bg::get<1>(points[t[2]]);
+                long double twice = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+                violations += twice <= 0;
+                area += static_cast<double>(twice / 2);
+                for (const auto &p : points) {
+                    long double px = bg::get<0>(p), py = bg::get<1>(p);
+                    long double adx = ax - px, ady = ay - py, bdx = bx - px, bdy = by - py;
+                    long double cdx = cx - px, cdy = cy - py;
+                    long double alift = adx * adx + ady * ady, blift = bdx * bdx + bdy * bdy;
+                    long double clift = cdx * cdx + cdy * cdy;
+                    long double det = alift * (bdx * cdy - cdx * bdy) + blift * (cdx * ady - adx * cdy) +
+                                      clift * (adx * bdy - bdx * ady);
+                    long double permanent = alift * (std::abs(bdx * cdy) + std::abs(cdx * bdy)) +
+                                            blift * (std::abs(cdx * ady) + std::abs(adx * cdy)) +
+                                            clift * (std::abs(adx * bdy) + std::abs(bdx * ady));
+                    violations += det > 1e-15L * permanent;
+                }
+            }
+            return std::array<double, 3>{violations, static_cast<double>(triangulation.triangles.size()), area};
+        },
+        [](const std::array<double, 3> &a, const std::array<double, 3> &b) {
+            double area = std::abs(a[2] - b[2]) / std::max(a[2], 1e-12);
+            return std::max({std::abs(a[0] - b[0]), std::abs(a[1] - b[1]), area});
+        },
+        1e-9, describe_hull);
+
+    // 由 Delaunay 相邻点裁剪的 Voronoi 单元与用所有其他点的垂直平分线裁剪的单元（long double 计算），比较每个
+    // 单元面积的差与裁剪范围面积之比；裁剪范围交替地大于或小于点集的外包矩形
+    suite.add<HullCase, std::vector<double>>(
+        "voronoi/cells_point2", generate_hull_cases,
+        [](const HullCase &c) {
+            const auto &points = *c.points;
+            auto box = voronoi_box(points);
+            std::vector<double> areas{bg::area(box)};
+            using Vertex = std::pair<long double, long double>;
+            for (const auto &p : points) {
+                long double px = bg::get<0>(p), py = bg::get<1>(p);
+                long double x0 = bg::get<bg::min_corner, 0>(box), y0 = bg::get<bg::min_corner, 1>(box);
+                long double x1 = bg::get<bg::max_corner, 0>(box), y1 = bg::get<bg::max_corner, 1>(box);
+                std::vector<Vertex> cell{{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+                for (const auto &q : points) {
+                    // 保留与 q 的垂直平分线上靠近 p 的一侧
+                    long double dx = bg::get<0>(q) - px, dy = bg::get<1>(q) - py;
+                    long double mx = px + dx / 2, my = py + dy / 2;
+                    std::vector<Vertex> clipped;
+                    for (size_t i = 0; i < cell.size() && (dx != 0 || dy != 0); ++i) {
+                        const auto &a = cell[i], &b = cell[(i + 1) % cell.size()];
+                        long double sa = (a.first - mx) * dx + (a.second - my) * dy;
+                        long double sb = (b.first - mx) * dx + (b.second - my) * dy;
+                        if (sa <= 0) {
+                            clipped.push_back(a);
+                        }
+                        if ((sa < 0 && sb > 0) || (sa > 0 && sb < 0)) {
+                            long double t = sa / (sa - sb);
+                            clipped.emplace_back(a.first + (b.first - a.first) * t,
+                                                 a.second + (b.second - a.second) * t);
+                        }
+                    }
+                    if (dx != 0 || dy != 0) {
+                        cell.swap(clipped);
+                    }
+                }
+                long double twice = 0;
+                for (size_t i = 0; i < cell.size(); ++i) {
+                    const auto &a = cell[i], &b = cell[(i + 1) % cell.size()];
+                    twice += a.first * b.second - b.first * a.second;
+                }
+                areas.push_back(static_cast<double>(twice / 2));
+            }
+            return areas;
+        },
+        [](const HullCase &c) {
+            const auto &points = *c.points;
+            auto box = voronoi_box(points);
+            std::vector<double> areas{bg::area(box)};
+            for (const auto &cell : voronoi_cells(points, box)) {
+                areas.push_back(cell.outer().empty() ? 0. : bg::area(cell));
+            }
+            return areas;
+        },
+        [](const std::vector<double> &a, const std::vector<double> &b) {
+            if (a.size() != b.size()) {
+                return std::numeric_limits<double>::infinity();
+            }
+            double error = 0.;
+            for (size_t i = 1; i < a.size(); ++i) {
+                error = std::max(error, std::abs(a[i] - b[i]) / std::max(a[0], 1e-12));
+            }
+            return error;
+        },
+        1e-9, describe_hull);
+
+    // 分块计算并合并的缓冲区与 Boost 对整条折线计算的缓冲区，比较对称差的面积与参考面积之比。Boost 会先以
+    // 缓冲距离的千分之一简化输入，分块与整条折线的简化结果不同，边界相差同一量级。Boost 的差集在个别输入上
+    // 不稳定（两个方向的差集面积之差与两者的面积之差不符），此时在缩小、放大 10 倍的坐标中重新计算
+    suite.add<BufferCase, MultiPolygon<Point2>>(
+        "buffer/chunked_point2", generate_buffer_cases,
+        [](const BufferCase &c) {
+            MultiPolygon<Point2> result;
+            buffer_detail::with_join(c.options, [&](const auto &join) {
+                bg::strategy::buffer::distance_symmetric<double> distance(c.distance);
+                bg::strategy::buffer::point_circle circle(c.options.points_per_circle);
+                if (c.options.end == EndStyle::kRound) {
+                    bg::buffer(*c.line, result, distance, bg::strategy::buffer::side_straight(), join,
+                               bg::strategy::buffer::end_round(c.options.points_per_circle), circle);
+                } else {
+                    bg::buffer(*c.line, result, distance, bg::strategy::buffer::side_straight(), join,
+                               bg::strategy::buffer::end_flat(), circle);
+                }
+            });
+            return result;
+        },
+        [](const BufferCase &c) { return buffer_line(*c.line, c.distance, c.options); },
+        [](const MultiPolygon<Point2> &a, const MultiPolygon<Point2> &b) {
+            double area_a = bg::area(a), area_b = bg::area(b), error = std::numeric_limits<double>::infinity();
+            for (double scale : {1., 0.1, 10.}) {
+                auto scaled = [&](const MultiPolygon<Point2> &polygons) {
+                    return buffer_detail::transform<Point2>(polygons, [&](const Point2 &p) {
+                        return Point2(bg::get<0>(p) * scale, bg::get<1>(p) * scale);
+                    });
+                };
+                MultiPolygon<Point2> only_a, only_b;
+                bg::difference(scaled(a), scaled(b), only_a);
+                bg::difference(scaled(b), scaled(a), only_b);
+                double x = bg::area(only_a) / (scale * scale), y = bg::area(only_b) / (scale * scale);
+                error = std::min(error, (x + y) / std::max(area_a, 1e-12));
+                if (std::abs(x - y - (area_a - area_b)) <= 1e-6 * area_a) {
+                    break;
+                }
+            }
+            return error;
+        },
+        1e-3, describe_buffer);
+
+    // 地理坐标的缓冲区（圆角、圆头）：折线附近的点到折线的大地线距离小于缓冲距离的 99% 时必须在缓冲区内，
+    // 大于 101% 时必须在缓冲区外，输出为不满足的点数。容差包括圆的离散（约 0.4%）与球面、椭球面的差。
+    // Boost 地理坐标的 `within` 对在反子午线两侧反复交替的环不可靠，改为将经度相对折线起点展开后在经纬度
+    // 平面中判断，缓冲区的边长只有百米量级，与大地线的差可以忽略
+    suite.add<GeoBufferCase, double>(
+        "buffer/corridor_geo2",
+        [](size_t n, uint64_t seed) {
+            auto cases = generate_geo_buffer_cases(n, seed);
+            for (auto &c : cases) {
+                c.planar.options.join = JoinStyle::kRound;
+                c.planar.options.end = EndStyle::kRound;
+            }
+            return cases;
+        },
+        [](const GeoBufferCase &c) {
+            // 整条折线在同一个局部平面中由 Boost 计算缓冲区，不分块
+            LocalFrame<PointGeo2> frame(std::vector<PointGeo2>(c.line.begin(), c.line.end()));
+            LineString<Point2> metric;
+            for (const auto &p : c.line) {
+                auto q = frame.to_local(p);
+                metric.emplace_back(q.x, q.y);
+            }
+            size_t points = c.planar.options.points_per_circle;
+            MultiPolygon<Point2> buffered;
+            bg::buffer(metric, buffered, bg::strategy::buffer::distance_symmetric<double>(c.planar.distance),
+                       bg::strategy::buffer::side_straight(), bg::strategy::buffer::join_round(points),
+                       bg::strategy::buffer::end_round(points), bg::strategy::buffer::point_circle(points));
+            buffer_detail::UnionPlane<PointGeo2> plane(c.line.front());
+            return corridor_violations(c, buffer_detail::transform<Point2>(buffered, [&](const Point2 &p) {
+                                           return plane.to_plane(frame.unproject(bg::get<0>(p), bg::get<1>(p)));
+                                       }));
+        },
+        [](const GeoBufferCase &c) {
+            buffer_detail::UnionPlane<PointGeo2> plane(c.line.front());
+            return corridor_violations(
+                c, buffer_detail::transform<Point2>(buffer_line(c.line, c.planar.distance, c.planar.options),
+                                                    [&](const PointGeo2 &p) { return plane.to_plane(p); }));
+        },
+        [](double a, double b) { return std::abs(a - b); }, 0.,
+        [](const GeoBufferCase &c) { return describe_buffer(c.planar) + " " + wkt_str(c.line); });
+
+    // 圆角偏移线与逐段平移构造的偏移线一致，且每个顶点到折线的距离等于偏移距离，误差相对于偏移距离。折线沿
+    // x 方向单调、线段长度远大于偏移距离，内侧的交点不会靠近其他线段
+    suite.add<BufferCase, OffsetCurve>(
+        "offset/round_point2",
+        [](size_t n, uint64_t seed) {
+            std::mt19937_64 rng(seed);
+            std::uniform_real_distribution<double> unit(0., 1.);
+            std::vector<BufferCase> cases;
+            for (size_t i = 0; i < n; ++i) {
+                auto line = std::make_shared<LineString<Point2>>();
+                double d = 1. + unit(rng) * 20., x = unit(rng) * 1e4, y = unit(rng) * 1e4;
+                for (size_t k = 0, count = 2 + rng() % 200; k < count; ++k) {
+                    line->emplace_back(x, y);
+                    double dx = d * (10. + unit(rng) * 20.);
+                    x += dx;
+                    y += dx * (unit(rng) - 0.5) * 4.;
+                }
+                BufferCase c{line, rng() % 2 == 0 ? d : -d, {}, "monotone"};
+                c.options.chunk_segments = 8 + rng() % 32;
+                cases.push_back(c);
+            }
+            return cases;
+        },
+        offset_by_segments,
+        [](const BufferCase &c) {
+            return OffsetCurve{offset_line(*c.line, c.distance, c.options), c.line.get(), c.distance};
+        },
+        offset_error, 1e-9, describe_buffer);
+
+    // 折线清理与逐点的参考实现比较，误差为违反约定的次数与顶点数之差（见 `clean_error`）
+    suite.add<CleanCase, CleanedLine>(
+        "clean/line_point2", generate_clean_cases, clean_by_points,
+        [](const CleanCase &c) { return CleanedLine{clean_line(*c.line, c.options), &c}; }, clean_error, 0.,
+        describe_clean);
+
+    // 覆盖化简与逐个多边形的 Boost 化简比较：后者不保持公共边界，只用作计时与面积的参考，待测结果另外检查拓扑，
+    // 误差为违反次数（见 `simplified_coverage_error`）
+    suite.add<CoverageCase, SimplifiedCoverage>(
+        "coverage/simplify_point2", generate_coverage_cases,
+        [](const CoverageCase &c) {
+            SimplifiedCoverage result{std::vector<Polygon<Point2>>(c.polygons->size()), &c};
+            for (size_t i = 0; i < c.polygons->size(); ++i) {
+                bg::simplify((*c.polygons)[i], result.polygons[i], c.tolerance);
+            }
+            return result;
+        },
+        [](const CoverageCase &c) {
+            static ThreadPool pool(4);
+            return SimplifiedCoverage{simplify_coverage(*c.polygons, c.tolerance, &pool), &c};
+        },
+        simplified_coverage_error, 0., describe_coverage);
+
+    int status = suite.run(argc, argv);
+    shared.reset();
+    dateline.reset();
+    remove_shared_network(shm_name);
+    remove_shared_network(dateline_name);
+    line_file.reset();
+    std::remove(line_path.c_str());
+    std::remove(trace_path.c_str());
+    return status;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace bench {
+
+/**
+ * @brief 基于 `perf_event_open` 的硬件性能计数器。
+ *
+ * 统计用户态的周期数、指令数、L1 数据缓存读缺失、末级缓存缺失、分支预测失败和 dTLB 读缺失，以及软件计数器
+ * task-clock 和缺页次数。不可用的事件（例如虚拟机中没有暴露 PMU，或 `perf_event_paranoid` 限制）会被跳过，
+ * 结果中标记为不可用；计数器被内核复用时按运行时间比例缩放。
+ *
+ * 周期数与指令数作为一组打开（周期数为组长），由内核同时调度，二者的运行时间一致，IPC 不受复用的影响；
+ * 其余事件单独打开，避免组内事件超过 PMU 的计数器数量后整组都无法调度。
+ *
+ * @note 计数器设置了 `inherit`，统计创建计数器的线程以及之后由它创建的所有线程（例如基准测试中惰性创建的
+ * 线程池）。创建计数器之前已经存在的线程不被统计。`inherit` 不支持 `PERF_FORMAT_GROUP`，因此组内的计数器
+ * 仍然逐个读取，但它们通过组长同时重置与启停。
+ */
+class PerfCounters {
+public:
+    struct Event {
+        const char *name;
+        uint32_t type;
+        uint64_t config;
+    };
+
+    // 一次测量的读数，`available` 为 false 时 `value` 无意义
+    struct Reading {
+        std::string name;
+        bool available = false;
+        double value = 0.;
+    };
+
+    PerfCounters() {
+#if defined(__linux__)
+        static const uint64_t kL1dReadMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        static const uint64_t kDtlbReadMiss = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        static const Event kEvents[] = {
+            {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"l1d_misses", PERF_TYPE_HW_CACHE, kL1dReadMiss},
+            {"llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {"dtlb_misses", PERF_TYPE_HW_CACHE, kDtlbReadMiss},
+            {"task_clock_ns", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+            {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+        };
+        int leader = -1;
+        for (const auto &event : kEvents) {
+            // 指令数加入周期数所在的组
+            bool grouped = std::strcmp(event.name, "instructions") == 0 && leader >= 0;
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = event.type;
+            attr.config = event.config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, grouped ? leader : -1, 0));
+            if (fd < 0 && grouped) {
+                // 无法加入组时退回单独计数
+                grouped = false;
+                fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+            if (std::strcmp(event.name, "cycles") == 0) {
+                leader = fd;
+            }
+            counters_.push_back({event.name, fd, grouped});
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const auto &counter : counters_) {
+            if (counter.fd >= 0) {
+                ::close(counter.fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    // 是否至少有一个硬件计数器可用
+    bool hardware_available() const {
+        for (size_t i = 0; i < counters_.size() && i < 6; ++i) {
+            if (counters_[i].fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void start() {
+#if defined(__linux__)
+        // 对组长的操作带 `PERF_IOC_FLAG_GROUP`，同时作用于组内的所有事件
+        for (const auto &counter : counters_) {
+            if (counter.fd >= 0 && !counter.member) {
+                ::ioctl(counter.fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ::ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+#endif
+    }
+
+    std::vector<Reading> stop() {
+        std::vector<Reading> readings;
+#if defined(__linux__)
+        for (const auto &counter : counters_) {
+            if (counter.fd >= 0 && !counter.member) {
+                ::ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+        }
+        for (const auto &counter : counters_) {
+            Reading reading;
+            reading.name = counter.name;
+            uint64_t values[3] = {0, 0, 0};  // value, time_enabled, time_running
+            if (counter.fd >= 0 && ::read(counter.fd, values, sizeof(values)) == sizeof(values) && values[2] > 0) {
+                reading.available = true;
+                reading.value = static_cast<double>(values[0]) * values[1] / values[2];
+            }
+            readings.push_back(reading);
+        }
+#endif
+        return readings;
+    }
+
+private:
+    struct Counter {
+        const char *name;
+        int fd;
+        bool member;  // 组内的非组长事件，随组长重置与启停
+    };
+
+    std::vector<Counter> counters_;
+};
+
+}  // namespace bench
@@ -1,10 +1,26 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
 #include "simplegeom/common.h"
 #include "simplegeom/io.h"
 
 namespace simplegeom {
 
+static constexpr double kEarthRadius = 6371008.8;                       // 地球平均半径（米），局部平面近似使用的球面
+static constexpr double kMetersPerDegree = kEarthRadius * M_PI / 180.;  // 球面上 1 度弧长（米）
+static constexpr double kMinMetersPerDegree = 110000.;                  // 1 度纬度（或赤道上 1 度经度）对应距离的下界
+static constexpr double kWgs84SemiMajorAxis = 6378137.;                 // WGS84 椭球长半轴（米）
+static constexpr double kWgs84Flattening = 1. / 298.257223563;          // WGS84 椭球扁率
+
+// 将经度差规范到 [-180, 180]，范围内的值保持不变
+inline double wrap_lon(double d) {
+    return d > 180. ? d - 360. : (d < -180. ? d + 360. : d);
+}
+
 /**
  * @brief 创建一个以给定点为中心的正方形（二维）或立方体（三维）边界框。
  *
@@ -17,7 +33,9 @@ namespace simplegeom {
  * @param [in] edge_length 边界框的边长，类型为 `double`。
  * @return Box<Point> 返回生成的边界框，类型为 `Box<Point>`，表示一个矩形（二维）或立方体（三维）。
  *
- * @note 该函数会根据点的类型和维度自动调整边界框的生成逻辑。对于地理点，边长会被缩放以适应地理坐标的缩放比例。
+ * @note 该函数会根据点的类型和维度自动调整边界框的生成逻辑。对于地理点，边长会被缩放以适应地理坐标的缩放比例，
+ * 并且经度方向按边界框内最靠近极点的纬度的余弦放大，使边界框总是覆盖以中心点为圆心、半径为边长一半的圆；
+ * 纬度会被限制在 [-90, 90] 范围内，触及极点时经度覆盖中心点两侧各 180 度。
  */
 template <typename Point>
 Box<Point> create_box(const Point &center_point, double edge_length) {
@@ -28,6 +46,23 @@ Box<Point> create_box(const Point &center_point, double edge_length) {
 
     if constexpr (std::is_same_v<Point, PointGeo2> || std::is_same_v<Point, PointGeo3>) {
         edge_length *= kGeographicFactor;
+
+        // 经度方向 1 度对应的距离随纬度升高而缩短，按边界框中最靠近极点的纬度放大；触及极点时覆盖全部经度
+        double lat = bg::get<1>(center_point);
+        double polar_lat = std::abs(lat) + edge_length;
+        double lon_half = polar_lat >= 90.
+                              ? 180.
+                              : std::min(180., edge_length / std::max(std::cos(polar_lat * M_PI / 180.), 1e-9));
+        Point min_corner = center_point, max_corner = center_point;
+        bg::set<0>(min_corner, bg::get<0>(center_point) - lon_half);
+        bg::set<0>(max_corner, bg::get<0>(center_point) + lon_half);
+        bg::set<1>(min_corner, std::max(-90., lat - edge_length));
+        bg::set<1>(max_corner, std::min(90., lat + edge_length));
+        if constexpr (dim > 2) {
+            bg::set<2>(min_corner, bg::get<2>(center_point) - edge_length);
+            bg::set<2>(max_corner, bg::get<2>(center_point) + edge_length);
+        }
+        return Box<Point>(min_corner, max_corner);
     }
 
     if constexpr (dim > 2) {
@@ -139,6 +174,116 @@ double distance(const Point &point, const Geometry<Point> &geometry) {
     return bg::distance(point, geometry);
 }
 
+/**
+ * @brief 计算点在折线上的投影结果（最近线段序号、距离及线段内偏移）。
+ *
+ * 该函数通过搜索框逐步缩小搜索范围，找到折线上距离给定点最近的线段，并返回该线段的序号、点到该线段的距离，
+ * 以及投影点到该线段起点的距离。结合预先计算的累积长度，调用方可以在 O(1) 时间内得到累积投影距离。
+ *
+ * 折线以随机访问迭代器区间 [first, last) 给出，因此顶点可以存放在任意连续内存中（例如共享内存），
+ * 无需先构造 `LineString`。迭代器解引用得到 `Point` 的左值引用时，扫描过程中的线段直接引用折线顶点；
+ * 解引用得到临时值时（例如 `StridedPointView`），每一步只读取一个新顶点。
+ *
+ * @tparam Point 点的类型，通常为二维或三维点。
+ * @tparam Iterator 随机访问迭代器类型，解引用得到 `Point` 或其引用。
+ * @param [in] point 要投影的点。
+ * @param [in] first 折线的起始顶点。
+ * @param [in] last 折线最后一个顶点之后的位置。
+ * @return LineProjection 投影结果。如果折线少于两个点，则 `distance` 为 -1。
+ */
+template <typename Point, typename Iterator>
+LineProjection project(const Point &point, Iterator first, Iterator last) {
+    static constexpr double kSearchBoxEdgeLength = 2000.;  // 初始搜索范围大小
+
+    LineProjection projection;
+    size_t size = static_cast<size_t>(last - first);
+    if (size < 2) {
+        return projection;
+    }
+
+    size_t index = 0;
+    double search_box_size = kSearchBoxEdgeLength;
+
+    auto visit = [&](size_t i, const bg::model::referring_segment<const Point> &seg) {
+        // 如果线段与搜索框不相交则跳过
+        if (!bg::intersects(seg, create_box(point, search_box_size))) {
+            return;
+        }
+
+        // 找到更近的线段时缩小搜索框
+        if (auto d = bg::distance(point, seg) * 2; d < search_box_size) {
+            search_box_size = d;
+            index = i;
+        }
+    };
+    if constexpr (std::is_lvalue_reference_v<typename std::iterator_traits<Iterator>::reference>) {
+        for (size_t i = 0; i < size - 1; ++i) {
+            visit(i, bg::model::referring_segment<const Point>(first[i], first[i + 1]));
+        }
+    } else {
+        Point a = first[0], b;
+        for (size_t i = 0; i < size - 1; ++i) {
+            b = first[i + 1];
+            visit(i, bg::model::referring_segment<const Point>(a, b));
+            a = b;
+        }
+    }
+
+    Segment<Point> seg;
+    assign_segment(first[index], first[index + 1], seg);
+
+    projection.distance = bg::distance(point, seg);
+    projection.segment_index = index;
+    projection.segment_offset = distance(seg.first, closest_point(point, seg));
+    return projection;
+}
+
+/**
+ * @brief 计算点在折线上的投影结果（最近线段序号、距离及线段内偏移）。
+ *
+ * @tparam Point 点的类型，通常为二维或三维点。
+ * @param [in] point 要投影的点。
+ * @param [in] line 折线，由一系列点组成，至少包含两个点。
+ * @return LineProjection 投影结果。如果折线少于两个点，则 `distance` 为 -1。
+ */
+template <typename Point>
+LineProjection project(const Point &point, const LineString<Point> &line) {
+    return project(point, line.begin(), line.end());
+}
+
+/**
+ * @brief 计算点到折线的最短距离及相关投影距离，折线以随机访问迭代器区间 [first, last) 给出。
+ *
+ * @tparam Point 点的类型，通常为二维或三维点。
+ * @tparam Iterator 随机访问迭代器类型，解引用得到 `Point` 或其引用。
+ * @param [in] point 要计算距离的点。
+ * @param [in] first 折线的起始顶点。
+ * @param [in] last 折线最后一个顶点之后的位置。
+ * @param [in] mode 投影模式。
+ * @return std::pair<double, double> 点到折线的最短距离以及投影距离，含义与 `distance(point, line, mode)` 相同。
+ */
+template <typename Point, typename Iterator>
+std::pair<double, double> distance(const Point &point, Iterator first, Iterator last, ProjectionMode mode) {
+    // 空线段
+    if (first == last) {
+        return std::make_pair(-1., 0.);
+    } else if (last - first < 2) {
+        return std::make_pair(distance(point, *first), 0.);
+    }
+
+    auto projection = project(point, first, last);
+
+    // 累积线段长度
+    double project_distance = 0;
+    if (mode == ProjectionMode::kAccumulate) {
+        for (size_t i = 0; i < projection.segment_index; ++i) {
+            project_distance += distance(first[i], first[i + 1]);
+        }
+    }
+
+    return std::make_pair(projection.distance, project_distance + projection.segment_offset);
+}
+
 /**
  * @brief 计算点到折线的最短距离及相关投影距离。
  *
@@ -155,45 +300,114 @@ double distance(const Point &point, const Geometry<Point> &geometry) {
  */
 template <typename Point>
 std::pair<double, double> distance(const Point &point, const LineString<Point> &line, ProjectionMode mode) {
-    static constexpr double kSearchBoxEdgeLength = 2000.;  // 初始搜索范围大小
+    return distance(point, line.begin(), line.end(), mode);
+}
 
-    // 空线段
-    if (line.empty()) {
-        return std::make_pair(-1., 0.);
-    } else if (line.size() < 2) {
-        return std::make_pair(distance(point, line.front()), 0.);
-    }
+// 局部平面中的点，`index` 由调用方使用，例如记录点在输入中的序号
+struct LocalPoint {
+    double x, y;
+    size_t index;
+};
 
-    size_t index = 0;
-    double search_box_size = kSearchBoxEdgeLength;  // 如果线段与搜索框不相交，则跳过该线段
+/**
+ * @brief 以某个点为原点的局部平面，用平面几何近似计算城市范围内的地理坐标。
+ *
+ * 笛卡尔坐标直接使用原始坐标，`scale` 为恒等变换。地理坐标的 `project` 为相对原点的经纬度差（度），经度沿较短的
+ * 方向展开，跨越反子午线的点集仍然连续，相近坐标的差是精确的；`scale` 按参考纬度的等距圆柱投影换算为米
+ * （球面半径为 `kEarthRadius`），`unproject` 为 `scale(project(p))` 的逆变换。距离的相对误差约为点集尺度与地球半径
+ * 之比，适用于城市范围内的点集。
+ *
+ * @tparam Point 二维点类型，`Point2` 或 `PointGeo2`。
+ */
+template <typename Point>
+class LocalFrame {
+public:
+    LocalFrame() = default;
 
-    Segment<Point> seg;
-    for (size_t i = 0; i < line.size() - 1; ++i) {
-        assign_segment(line.at(i), line.at(i + 1), seg);
-        // 如果线段与搜索框不相交则跳过
-        if (!bg::intersects(seg, create_box(point, search_box_size))) {
-            continue;
+    // 以 `origin` 为原点，参考纬度为原点的纬度
+    explicit LocalFrame(const Point &origin) {
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            origin_x_ = bg::get<0>(origin);
+            origin_y_ = bg::get<1>(origin);
+            set_reference_latitude(origin_y_);
         }
+    }
 
-        // 如果线段与搜索框不相交，则跳过该线段
-        if (auto d = distance(point, seg) * 2; d < search_box_size) {
-            search_box_size = d;
-            index = i;
+    // 以第一个点为原点，参考纬度为点集纬度范围的中点；点集为空时为恒等变换
+    explicit LocalFrame(const std::vector<Point> &points) {
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            if (points.empty()) {
+                return;
+            }
+            origin_x_ = bg::get<0>(points[0]);
+            origin_y_ = bg::get<1>(points[0]);
+            double min_y = origin_y_, max_y = origin_y_;
+            for (const auto &p : points) {
+                min_y = std::min(min_y, bg::get<1>(p));
+                max_y = std::max(max_y, bg::get<1>(p));
+            }
+            set_reference_latitude((min_y + max_y) * 0.5);
         }
     }
 
-    // 累积线段长度
-    double project_distance = 0;
-    if (mode == ProjectionMode::kAccumulate) {
-        for (size_t i = 0; i < index; ++i) {
-            project_distance += distance(line.at(i), line.at(i + 1));
+    // 相对原点的坐标差，地理坐标为度
+    LocalPoint project(const Point &p, size_t index = 0) const {
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            return {wrap_lon(bg::get<0>(p) - origin_x_), bg::get<1>(p) - origin_y_, index};
+        } else {
+            return {bg::get<0>(p), bg::get<1>(p), index};
         }
     }
 
-    assign_segment(line.at(index), line.at(index + 1), seg);
+    // 将 `project` 的结果换算为度量坐标
+    LocalPoint scale(const LocalPoint &p) const { return {p.x * scale_x_, p.y * scale_y_, p.index}; }
 
-    project_distance += distance(seg.first, closest_point(point, seg));
+    // 度量坐标，即 `scale(project(p))`
+    LocalPoint to_local(const Point &p, size_t index = 0) const { return scale(project(p, index)); }
 
-    return std::make_pair(bg::distance(point, seg), project_distance);
+    // `to_local` 的逆变换
+    Point unproject(double x, double y) const {
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            return Point(wrap_lon(origin_x_ + x / scale_x_), origin_y_ + y / scale_y_);
+        } else {
+            return Point(x, y);
+        }
+    }
+
+    // 两个方向上每单位坐标差对应的度量长度，笛卡尔坐标为 1
+    double scale_x() const { return scale_x_; }
+    double scale_y() const { return scale_y_; }
+
+private:
+    void set_reference_latitude(double lat) {
+        scale_x_ = kMetersPerDegree * std::max(std::cos(lat * M_PI / 180.), 1e-12);
+        scale_y_ = kMetersPerDegree;
+    }
+
+    double origin_x_ = 0., origin_y_ = 0.;
+    double scale_x_ = 1., scale_y_ = 1.;
+};
+
+/**
+ * @brief 由逆时针方向的顶点生成闭合的多边形，顶点方向按 `Polygon<Point>` 的约定（顺时针）。
+ *
+ * @param [in] n 顶点数，为 0 时返回空多边形。
+ * @param [in] vertex 第 i 个顶点，参数为序号。
+ */
+template <typename Point, typename Func>
+Polygon<Point> make_polygon(size_t n, Func &&vertex) {
+    Polygon<Point> polygon;
+    if (n == 0) {
+        return polygon;
+    }
+    auto &ring = polygon.outer();
+    ring.reserve(n + 1);
+    ring.push_back(vertex(0));
+    for (size_t i = n; i-- > 1;) {
+        ring.push_back(vertex(i));
+    }
+    ring.push_back(ring.front());
+    return polygon;
 }
+
 }  // namespace simplegeom
\ No newline at end of file
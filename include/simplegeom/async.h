@@ -0,0 +1,368 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "simplegeom/io.h"
+#include "simplegeom/network.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+namespace async_detail {
+
+// 只能移动的 `void()` 可调用对象，完成队列中的回调可以持有 `std::promise` 等不可复制的对象
+class Completion {
+public:
+    Completion() = default;
+
+    template <typename Func, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Func>, Completion>>>
+    Completion(Func &&func) : impl_(std::make_unique<Model<std::decay_t<Func>>>(std::forward<Func>(func))) {}
+
+    void operator()() { impl_->call(); }
+
+private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual void call() = 0;
+    };
+
+    template <typename Func>
+    struct Model final : Concept {
+        explicit Model(Func f) : func(std::move(f)) {}
+        void call() override { func(); }
+        Func func;
+    };
+
+    std::unique_ptr<Concept> impl_;
+};
+
+}  // namespace async_detail
+
+/**
+ * @brief 异步任务的结果，持有返回值或任务中抛出的异常。
+ *
+ * @tparam T 返回值类型。
+ */
+template <typename T>
+class AsyncResult {
+public:
+    explicit AsyncResult(T value) : value_(std::move(value)) {}
+    explicit AsyncResult(std::exception_ptr error) : error_(std::move(error)) {}
+
+    bool ok() const { return error_ == nullptr; }
+    std::exception_ptr error() const { return error_; }
+
+    /**
+     * @brief 获取返回值，如果任务失败则重新抛出任务中的异常。
+     */
+    T &get() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return value_;
+    }
+
+private:
+    T value_{};
+    std::exception_ptr error_;
+};
+
+/**
+ * @brief 异步执行上下文。
+ *
+ * CPU 密集的任务（批量投影、WKT/WKB 解析）在计算线程池上执行，文件读取在独立的 I/O 线程池上执行，
+ * 两者互不阻塞。任务完成后回调不会在工作线程中直接执行，而是投递到完成队列，由服务线程调用 `poll` 或
+ * `run` 时依次执行。因此回调总是在同一个服务线程中运行，无需加锁即可访问服务线程的状态，
+ * 单个服务线程可以同时保持大量任务在途。
+ *
+ * @note 文件读取使用线程池模拟异步 I/O，适用于所有平台；在回调中可以继续提交新的任务。回调只需要可以移动，
+ * 可以持有 `std::promise` 等不可复制的对象。
+ */
+class AsyncContext {
+public:
+    /**
+     * @brief 构造异步执行上下文。
+     *
+     * @param [in] compute 计算线程池，由调用方持有，生命周期需要长于上下文。
+     * @param [in] io_threads 文件读取使用的线程数。
+     */
+    explicit AsyncContext(ThreadPool &compute, size_t io_threads = 4) : compute_(compute), io_(io_threads) {}
+
+    AsyncContext(const AsyncContext &) = delete;
+    AsyncContext &operator=(const AsyncContext &) = delete;
+
+    ThreadPool &compute_pool() { return compute_; }
+
+    // 已提交但回调尚未执行的任务数
+    size_t in_flight() const { return in_flight_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 在计算线程池上执行 `func`，完成后在服务线程中以 `AsyncResult` 调用 `callback`。
+     *
+     * @tparam Func 可调用对象类型，不接受参数。
+     * @tparam Callback 可调用对象类型，签名为 `void(AsyncResult<R> &)`，`R` 为 `func` 的返回值类型。
+     */
+    template <typename Func, typename Callback>
+    void submit(Func &&func, Callback &&callback) {
+        dispatch(compute_, std::forward<Func>(func), std::forward<Callback>(callback));
+    }
+
+    /**
+     * @brief 在 I/O 线程池上读取整个文件，完成后在服务线程中调用 `callback`。
+     *
+     * @tparam Callback 可调用对象类型，签名为 `void(AsyncResult<std::string> &)`。
+     * @param [in] path 文件路径。
+     */
+    template <typename Callback>
+    void read_file(std::string path, Callback &&callback) {
+        dispatch(
+            io_, [path = std::move(path)] { return read_whole_file(path); }, std::forward<Callback>(callback));
+    }
+
+    /**
+     * @brief 将回调投递到完成队列，可以在任意线程中调用。
+     */
+    void post(async_detail::Completion completion) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completions_.push_back(std::move(completion));
+        }
+        cv_.notify_one();
+    }
+
+    /**
+     * @brief 执行完成队列中所有已就绪的回调，不阻塞。
+     *
+     * @return size_t 执行的回调数量。
+     */
+    size_t poll() {
+        std::deque<async_detail::Completion> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready.swap(completions_);
+        }
+        for (auto &completion : ready) {
+            completion();
+        }
+        return ready.size();
+    }
+
+    /**
+     * @brief 阻塞执行回调，直到所有在途任务（包括回调中新提交的任务）都已完成。
+     */
+    void run() {
+        while (in_flight() > 0) {
+            std::deque<async_detail::Completion> ready;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return !completions_.empty(); });
+                ready.swap(completions_);
+            }
+            for (auto &completion : ready) {
+                completion();
+            }
+        }
+    }
+
+    /**
+     * @brief 开始一个由多个子任务组成的操作，在途计数加一，需要与 `finish` 配对使用。
+     */
+    void start() { in_flight_.fetch_add(1, std::memory_order_acq_rel); }
+
+    /**
+     * @brief 结束一个操作：把回调投递到完成队列，并在回调执行后将在途计数减一。
+     */
+    void finish(async_detail::Completion completion) {
+        post([this, completion = std::move(completion)]() mutable {
+            completion();
+            in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+private:
+    template <typename Func, typename Callback>
+    void dispatch(ThreadPool &pool, Func &&func, Callback &&callback) {
+        using Result = std::decay_t<decltype(func())>;
+        start();
+        pool.submit([this, func = std::forward<Func>(func), callback = std::forward<Callback>(callback)]() mutable {
+            std::shared_ptr<AsyncResult<Result>> result;
+            try {
+                result = std::make_shared<AsyncResult<Result>>(func());
+            } catch (...) {
+                result = std::make_shared<AsyncResult<Result>>(std::current_exception());
+            }
+            finish([callback = std::move(callback), result]() mutable { callback(*result); });
+        });
+    }
+
+    static std::string read_whole_file(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        std::string data;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            data.reserve(static_cast<size_t>(st.st_size));
+        }
+        char buffer[1 << 16];
+        for (;;) {
+            ssize_t n = ::read(fd, buffer, sizeof(buffer));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "read " + path);
+            }
+            if (n == 0) {
+                break;
+            }
+            data.append(buffer, static_cast<size_t>(n));
+        }
+        ::close(fd);
+        return data;
+    }
+
+    ThreadPool &compute_;
+    ThreadPool io_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<async_detail::Completion> completions_;
+    std::atomic<size_t> in_flight_{0};
+};
+
+namespace async_detail {
+
+/**
+ * @brief 将 [0, n) 划分为若干块提交到计算线程池，所有块完成后在服务线程中调用 `callback`。
+ *
+ * 与 `parallel_for` 不同，该函数不阻塞调用线程，也不会在线程池内部等待其他任务。
+ */
+template <typename T, typename Body, typename Callback>
+void parallel_chunks(AsyncContext &context, std::shared_ptr<std::vector<T>> output, size_t n, Body body,
+                     Callback callback, size_t min_chunk = 256) {
+    auto &pool = context.compute_pool();
+    size_t num_chunks = std::max<size_t>(1, std::min(pool.size() * 2, (n + min_chunk - 1) / min_chunk));
+    size_t chunk = std::max<size_t>(1, (n + num_chunks - 1) / num_chunks);
+    num_chunks = n == 0 ? 1 : (n + chunk - 1) / chunk;
+
+    struct State {
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    state->remaining.store(num_chunks);
+
+    auto body_ptr = std::make_shared<Body>(std::move(body));
+    auto callback_ptr = std::make_shared<Callback>(std::move(callback));
+
+    context.start();
+    for (size_t c = 0; c < num_chunks; ++c) {
+        size_t begin = std::min(n, c * chunk);
+        size_t end = std::min(n, begin + chunk);
+        pool.submit([&context, state, output, body_ptr, callback_ptr, begin, end] {
+            try {
+                for (size_t i = begin; i < end; ++i) {
+                    (*output)[i] = (*body_ptr)(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                context.finish([state, output, callback_ptr] {
+                    AsyncResult<std::vector<T>> result =
+                        state->error ? AsyncResult<std::vector<T>>(state->error)
+                                     : AsyncResult<std::vector<T>>(std::move(*output));
+                    (*callback_ptr)(result);
+                });
+            }
+        });
+    }
+}
+
+}  // namespace async_detail
+
+/**
+ * @brief 异步批量计算多个点在线网上的投影。
+ *
+ * 点集被划分为若干块提交到计算线程池，全部完成后在服务线程中调用 `callback`。
+ *
+ * @tparam Point 点的类型。
+ * @tparam Callback 可调用对象类型，签名为 `void(AsyncResult<std::vector<NetworkProjection>> &)`。
+ * @param [in] context 异步执行上下文。
+ * @param [in] network 折线网络，生命周期需要长于任务。
+ * @param [in] points 要投影的点集。
+ * @param [in] mode 投影模式。
+ * @param [in] callback 完成回调。
+ * @param [in] search_radius 候选折线的搜索框边长。
+ */
+template <typename Point, typename Callback>
+void project_batch_async(AsyncContext &context, const LineNetwork<Point> &network, std::vector<Point> points,
+                         ProjectionMode mode, Callback &&callback,
+                         double search_radius = LineNetwork<Point>::kDefaultSearchRadius) {
+    auto input = std::make_shared<std::vector<Point>>(std::move(points));
+    auto output = std::make_shared<std::vector<NetworkProjection>>(input->size());
+    async_detail::parallel_chunks(
+        context, output, input->size(),
+        [&network, input, mode, search_radius](size_t i) { return network.project((*input)[i], mode, search_radius); },
+        std::forward<Callback>(callback));
+}
+
+/**
+ * @brief 异步解析一批 WKT 字符串。
+ *
+ * @tparam Geometry 几何对象的类型，例如 `LineString<PointGeo2>`。
+ * @tparam Callback 可调用对象类型，签名为 `void(AsyncResult<std::vector<Geometry>> &)`。
+ * @param [in] context 异步执行上下文。
+ * @param [in] wkts WKT 字符串。
+ * @param [in] callback 完成回调，任意一个字符串解析失败时结果中持有对应的异常。
+ */
+template <typename Geometry, typename Callback>
+void decode_wkt_async(AsyncContext &context, std::vector<std::string> wkts, Callback &&callback) {
+    auto input = std::make_shared<std::vector<std::string>>(std::move(wkts));
+    auto output = std::make_shared<std::vector<Geometry>>(input->size());
+    async_detail::parallel_chunks(
+        context, output, input->size(), [input](size_t i) { return from_wkt<Geometry>((*input)[i]); },
+        std::forward<Callback>(callback), 64);
+}
+
+/**
+ * @brief 异步解析一批 WKB 字节流。
+ *
+ * @tparam Geometry 几何对象的类型，例如 `LineString<PointGeo2>`。
+ * @tparam Callback 可调用对象类型，签名为 `void(AsyncResult<std::vector<Geometry>> &)`。
+ * @param [in] context 异步执行上下文。
+ * @param [in] wkbs WKB 字节流。
+ * @param [in] callback 完成回调，任意一个字节流解析失败时结果中持有对应的异常。
+ */
+template <typename Geometry, typename Callback>
+void decode_wkb_async(AsyncContext &context, std::vector<std::vector<uint8_t>> wkbs, Callback &&callback) {
+    auto input = std::make_shared<std::vector<std::vector<uint8_t>>>(std::move(wkbs));
+    auto output = std::make_shared<std::vector<Geometry>>(input->size());
+    async_detail::parallel_chunks(
+        context, output, input->size(), [input](size_t i) { return from_wkb<Geometry>((*input)[i]); },
+        std::forward<Callback>(callback), 64);
+}
+
+}  // namespace simplegeom
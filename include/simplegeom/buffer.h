@@ -0,0 +1,553 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include <boost/geometry/algorithms/point_on_surface.hpp>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/line_handle.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+enum class JoinStyle {
+    kRound,  // 圆角：以顶点为圆心的圆弧
+    kMitre,  // 斜接：两条偏移线的交点，超过 `mitre_limit` 时截断
+    kFlat,   // 平角：直接连接两条偏移线的端点
+};
+
+enum class EndStyle {
+    kRound,  // 以端点为圆心的半圆
+    kFlat,   // 在端点处垂直截断
+};
+
+struct BufferOptions {
+    JoinStyle join = JoinStyle::kRound;
+    EndStyle end = EndStyle::kRound;
+    double mitre_limit = 5.;        // 斜接点到顶点的距离与偏移距离之比的上限
+    size_t points_per_circle = 36;  // 整圆的分段数，圆角与圆头按该精度离散
+    size_t chunk_segments = 256;    // 长折线按该线段数分块计算，每块使用各自的局部平面
+};
+
+// `buffer_line` 中 Boost 合并失败后的回退次数，用于发现分块合并的数值问题
+struct BufferStats {
+    size_t recomputed_merges = 0;      // 两个分块的合并丢失内环或面积异常，改为直接计算相应顶点范围的次数
+    bool whole_line_fallback = false;  // 全部合并后的结果自相交，改为直接计算整条折线
+};
+
+namespace buffer_detail {
+
+// 一个分块在去重后的折线中的顶点下标范围 [first, last]，相邻分块重叠一条线段；[emit_begin, emit_end) 为该分块
+// 负责的顶点，这些顶点的前后顶点都在分块内
+struct Chunk {
+    size_t first, last;
+    size_t emit_begin, emit_end;
+};
+
+inline std::vector<Chunk> make_chunks(size_t n, size_t segments) {
+    segments = std::max<size_t>(segments, 2);
+    std::vector<Chunk> chunks;
+    for (size_t begin = 0; begin + 1 < n; begin += segments) {
+        size_t end = std::min(n - 1, begin + segments);
+        chunks.push_back({begin == 0 ? 0 : begin - 1, end, begin, end == n - 1 ? n : end});
+    }
+    return chunks;
+}
+
+// 去掉连续重复的顶点
+template <typename Point>
+std::vector<Point> distinct_points(const LineString<Point> &line) {
+    std::vector<Point> points;
+    points.reserve(line.size());
+    for (const auto &p : line) {
+        if (points.empty() || bg::get<0>(p) != bg::get<0>(points.back()) ||
+            bg::get<1>(p) != bg::get<1>(points.back())) {
+            points.push_back(p);
+        }
+    }
+    return points;
+}
+
+// 分块在局部平面（米）中的顶点
+template <typename Point>
+struct MetricChunk {
+    LocalFrame<Point> frame;
+    std::vector<LocalPoint> points;
+};
+
+template <typename Point>
+MetricChunk<Point> project_chunk(const std::vector<Point> &points, const Chunk &chunk) {
+    std::vector<Point> part(points.begin() + chunk.first, points.begin() + chunk.last + 1);
+    MetricChunk<Point> metric{LocalFrame<Point>(part), {}};
+    metric.points.reserve(part.size());
+    for (size_t i = 0; i < part.size(); ++i) {
+        metric.points.push_back(metric.frame.to_local(part[i], chunk.first + i));
+    }
+    return metric;
+}
+
+/**
+ * @brief 合并各分块结果所用的平面。
+ *
+ * 笛卡尔坐标为原始坐标；地理坐标为相对折线起点的经纬度差（度），经度沿较短的方向展开，跨越反子午线的折线
+ * 仍然连续。各分块在各自的局部平面中计算后换算为经纬度，再在该平面中合并。
+ */
+template <typename Point>
+class UnionPlane {
+public:
+    explicit UnionPlane(const Point &origin) : origin_(origin) {}
+
+    Point2 to_plane(const Point &p) const {
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            return {wrap_lon(bg::get<0>(p) - bg::get<0>(origin_)), bg::get<1>(p)};
+        } else {
+            return {bg::get<0>(p), bg::get<1>(p)};
+        }
+    }
+
+    Point from_plane(const Point2 &p) const {
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            return {wrap_lon(bg::get<0>(origin_) + bg::get<0>(p)), bg::get<1>(p)};
+        } else {
+            return p;
+        }
+    }
+
+private:
+    Point origin_;
+};
+
+// 逐点变换多边形集合，保持环的结构与方向
+template <typename To, typename From, typename Func>
+MultiPolygon<To> transform(const MultiPolygon<From> &polygons, Func &&func) {
+    MultiPolygon<To> result;
+    result.resize(polygons.size());
+    auto convert = [&](const auto &ring, auto &out) {
+        out.reserve(ring.size());
+        for (const auto &p : ring) {
+            out.push_back(func(p));
+        }
+    };
+    for (size_t i = 0; i < polygons.size(); ++i) {
+        convert(polygons[i].outer(), result[i].outer());
+        result[i].inners().resize(polygons[i].inners().size());
+        for (size_t k = 0; k < polygons[i].inners().size(); ++k) {
+            convert(polygons[i].inners()[k], result[i].inners()[k]);
+        }
+    }
+    return result;
+}
+
+// 平角连接：Boost 的连接策略接口，只连接两条偏移线的端点
+class FlatJoin {
+public:
+    template <typename Point, typename DistanceType, typename RangeOut>
+    bool apply(const Point &, const Point &, const Point &perp1, const Point &perp2, const DistanceType &,
+               RangeOut &range_out) const {
+        if (bg::equals(perp1, perp2)) {
+            return false;
+        }
+        range_out.push_back(perp1);
+        range_out.push_back(perp2);
+        return true;
+    }
+
+    template <typename NumericType>
+    NumericType max_distance(const NumericType &distance) const {
+        return distance;
+    }
+};
+
+// 以 `options.join` 对应的 Boost 连接策略调用 `func`
+template <typename Func>
+auto with_join(const BufferOptions &options, Func &&func) {
+    switch (options.join) {
+        case JoinStyle::kRound:
+            return func(bg::strategy::buffer::join_round(options.points_per_circle));
+        case JoinStyle::kMitre:
+            return func(bg::strategy::buffer::join_miter(options.mitre_limit));
+        default:
+            return func(FlatJoin());
+    }
+}
+
+/**
+ * @brief 端点 `a` 处背离相邻顶点 `b` 的圆头（顺时针闭合），半圆的顶点与 Boost 的圆头相同。
+ *
+ * 半圆的直径边与平头截断的分块缓冲区的端边重合时，Boost 的合并会在两者之间留下细小的洞，因此直径边的两个端点
+ * 向折线内侧收缩半径的千分之一，使圆头与分块缓冲区有一定的重叠。
+ */
+inline Polygon<Point2> round_cap(const LocalPoint &a, const LocalPoint &b, double radius,
+                                 size_t points_per_circle) {
+    constexpr double kOverlap = 1e-3;
+    double length = std::hypot(b.x - a.x, b.y - a.y), ux = (b.x - a.x) / length, uy = (b.y - a.y) / length;
+    double angle = std::atan2(-ux, uy);  // 右侧法向
+    size_t n = std::max<size_t>(points_per_circle / 2, 2);
+    Polygon<Point2> polygon;
+    for (size_t k = 0; k <= n; ++k) {
+        double t = angle - M_PI * static_cast<double>(k) / static_cast<double>(n);
+        polygon.outer().emplace_back(a.x + radius * std::cos(t), a.y + radius * std::sin(t));
+    }
+    double side = radius * (1. - kOverlap), inward = radius * kOverlap;
+    polygon.outer().emplace_back(a.x - side * uy + inward * ux, a.y + side * ux + inward * uy);
+    polygon.outer().emplace_back(a.x + side * uy + inward * ux, a.y - side * ux + inward * uy);
+    polygon.outer().push_back(polygon.outer().front());
+    return polygon;
+}
+
+// 合并平面中折线顶点 [first, last] 的缓冲区
+struct Part {
+    size_t first, last;
+    MultiPolygon<Point2> polygons;
+    double area;
+};
+
+// `a` 的每个内环中取一点，不在 `b` 中的点也不能在 `a` 与 `b` 的合并结果 `merged` 中
+inline bool holes_kept(const MultiPolygon<Point2> &a, const MultiPolygon<Point2> &b,
+                       const MultiPolygon<Point2> &merged) {
+    for (const auto &polygon : a) {
+        for (const auto &inner : polygon.inners()) {
+            Polygon<Point2> hole;
+            hole.outer().assign(inner.rbegin(), inner.rend());
+            Point2 p;
+            bg::point_on_surface(hole, p);
+            if (!bg::covered_by(p, b) && bg::within(p, merged)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 依次两两合并相邻的部分，每一层在线程池中并行。
+ *
+ * Boost 1.74 的合并在少数输入上会丢失内环：两部分合起来围成的洞（合并结果的面积超出两部分面积之和），或者一部分
+ * 原有而另一部分没有覆盖的洞。检查到这两种情况时改用 `recompute` 直接计算两部分所覆盖的顶点范围的缓冲区。
+ */
+template <typename Recompute>
+MultiPolygon<Point2> union_all(std::vector<Part> parts, ThreadPool *pool, Recompute &&recompute) {
+    while (parts.size() > 1) {
+        std::vector<Part> merged((parts.size() + 1) / 2);
+        parallel_for(
+            pool, merged.size(),
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (2 * i + 1 == parts.size()) {
+                        merged[i] = std::move(parts[2 * i]);
+                        continue;
+                    }
+                    const auto &a = parts[2 * i], &b = parts[2 * i + 1];
+                    auto &out = merged[i];
+                    out.first = a.first;
+                    out.last = b.last;
+                    bg::union_(a.polygons, b.polygons, out.polygons);
+                    out.area = bg::area(out.polygons);
+                    double upper = (a.area + b.area) * (1. + 1e-9), lower = std::max(a.area, b.area) * (1. - 1e-9);
+                    if (out.area > upper || out.area < lower || !holes_kept(a.polygons, b.polygons, out.polygons) ||
+                        !holes_kept(b.polygons, a.polygons, out.polygons)) {
+                        out.polygons = recompute(out.first, out.last);
+                        out.area = bg::area(out.polygons);
+                    }
+                }
+            },
+            1);
+        parts.swap(merged);
+    }
+    return parts.empty() ? MultiPolygon<Point2>() : std::move(parts.front().polygons);
+}
+
+// 单位法向量（指向线段左侧）
+inline void left_normal(const LocalPoint &a, const LocalPoint &b, double &nx, double &ny) {
+    double dx = b.x - a.x, dy = b.y - a.y, length = std::hypot(dx, dy);
+    nx = -dy / length;
+    ny = dx / length;
+}
+
+/**
+ * @brief 在局部平面中计算一个顶点处的偏移点。
+ *
+ * 端点沿所在线段的法向偏移。中间顶点在偏移线的内侧取两条偏移线的交点，在外侧按连接方式生成圆弧、斜接点或两条
+ * 偏移线的端点；两条线段方向相反时没有交点，取两条偏移线的端点。
+ *
+ * @param [in] points 分块的顶点。
+ * @param [in] i 顶点在分块中的下标。
+ * @param [in] d 偏移距离，正值向左。
+ * @param [out] out 偏移点，依次追加。
+ */
+inline void offset_vertex(const std::vector<LocalPoint> &points, size_t i, double d,
+                          const BufferOptions &options, std::vector<LocalPoint> &out) {
+    const auto &p = points[i];
+    if (i == 0 || i + 1 == points.size()) {
+        double nx, ny;
+        i == 0 ? left_normal(p, points[1], nx, ny) : left_normal(points[i - 1], p, nx, ny);
+        out.push_back({p.x + d * nx, p.y + d * ny, p.index});
+        return;
+    }
+    double n1x, n1y, n2x, n2y;
+    left_normal(points[i - 1], p, n1x, n1y);
+    left_normal(p, points[i + 1], n2x, n2y);
+    double turn = n1x * n2y - n1y * n2x;  // 左转为正
+    double cosine = n1x * n2x + n1y * n2y;
+    if (turn == 0. && cosine > 0.) {
+        out.push_back({p.x + d * n1x, p.y + d * n1y, p.index});
+        return;
+    }
+    bool outer = turn * d < 0.;
+    if (1. + cosine < 1e-12 || (outer && options.join == JoinStyle::kFlat)) {
+        out.push_back({p.x + d * n1x, p.y + d * n1y, p.index});
+        out.push_back({p.x + d * n2x, p.y + d * n2y, p.index});
+        return;
+    }
+    // 两条偏移线的交点
+    double mx = d * (n1x + n2x) / (1. + cosine), my = d * (n1y + n2y) / (1. + cosine);
+    if (!outer) {
+        out.push_back({p.x + mx, p.y + my, p.index});
+    } else if (options.join == JoinStyle::kRound) {
+        double a1 = std::atan2(d * n1y, d * n1x), delta = std::atan2(turn, cosine);
+        auto steps = static_cast<size_t>(
+            std::ceil(std::abs(delta) * static_cast<double>(options.points_per_circle) / (2. * M_PI)));
+        steps = std::max<size_t>(steps, 1);
+        double radius = std::abs(d);
+        for (size_t k = 0; k <= steps; ++k) {
+            double a = a1 + delta * static_cast<double>(k) / static_cast<double>(steps);
+            out.push_back({p.x + radius * std::cos(a), p.y + radius * std::sin(a), p.index});
+        }
+    } else {
+        double limit = std::max(options.mitre_limit, 1.) * std::abs(d), length = std::hypot(mx, my);
+        if (length <= limit) {
+            out.push_back({p.x + mx, p.y + my, p.index});
+            return;
+        }
+        // 在距顶点 `limit` 处垂直于角平分线截断，截断线与两条偏移线各交于一点
+        double bx = mx / length, by = my / length;
+        const auto &prev = points[i - 1], &next = points[i + 1];
+        double u1x = p.x - prev.x, u1y = p.y - prev.y, u2x = next.x - p.x, u2y = next.y - p.y;
+        double t1 = (limit - d * (n1x * bx + n1y * by)) / (u1x * bx + u1y * by);
+        double t2 = (limit - d * (n2x * bx + n2y * by)) / (u2x * bx + u2y * by);
+        out.push_back({p.x + d * n1x + t1 * u1x, p.y + d * n1y + t1 * u1y, p.index});
+        out.push_back({p.x + d * n2x + t2 * u2x, p.y + d * n2y + t2 * u2y, p.index});
+    }
+}
+
+}  // namespace buffer_detail
+
+/**
+ * @brief 折线的偏移线（例如由中心线得到车道线）。
+ *
+ * 逐个顶点计算偏移点：偏移线的内侧取两条偏移线的交点，外侧按 `options.join` 连接。不处理偏移距离大于局部曲率
+ * 半径时产生的自相交（此时应使用 `buffer_line` 的边界）。地理坐标按 `options.chunk_segments` 分块，每块在
+ * 以该块纬度中点为参考的局部平面（米）中计算，距离误差约为分块尺度与地球半径之比。
+ *
+ * @param [in] line 折线，连续重复的顶点只计算一次。
+ * @param [in] distance 偏移距离，正值向左（沿折线方向），地理坐标下单位为米。
+ * @param [in] options 连接方式与分块大小，不使用端点样式。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return LineString<Point> 偏移线，少于两个不同的顶点时为空。
+ */
+template <typename Point>
+LineString<Point> offset_line(const LineString<Point> &line, double distance, const BufferOptions &options = {},
+                              ThreadPool *pool = nullptr) {
+    auto points = buffer_detail::distinct_points(line);
+    auto chunks = buffer_detail::make_chunks(points.size(), options.chunk_segments);
+    std::vector<LineString<Point>> parts(chunks.size());
+    parallel_for(
+        pool, chunks.size(),
+        [&](size_t begin, size_t end) {
+            std::vector<LocalPoint> out;
+            for (size_t c = begin; c < end; ++c) {
+                auto metric = buffer_detail::project_chunk(points, chunks[c]);
+                out.clear();
+                for (size_t j = chunks[c].emit_begin; j < chunks[c].emit_end; ++j) {
+                    buffer_detail::offset_vertex(metric.points, j - chunks[c].first, distance, options, out);
+                }
+                for (const auto &p : out) {
+                    parts[c].push_back(metric.frame.unproject(p.x, p.y));
+                }
+            }
+        },
+        1);
+    LineString<Point> result;
+    for (const auto &part : parts) {
+        result.insert(result.end(), part.begin(), part.end());
+    }
+    return result;
+}
+
+/**
+ * @brief 折线的缓冲区（例如路线周围的走廊）。
+ *
+ * 长折线按 `options.chunk_segments` 分块，相邻分块重叠一条线段，每块在各自的局部平面（米）中用 Boost 的笛卡尔
+ * 缓冲区计算，最后在线程池中两两合并；Boost 的合并丢失内环或面积异常时，改为直接计算相应顶点范围的缓冲区，
+ * 全部合并后的结果仍自相交时改为直接计算整条折线，回退的次数由 `stats` 报告。
+ * 分块避免了 Boost 在长折线上的超线性代价，局部平面避免了地理坐标下的大地线计算。地理坐标的距离误差约为
+ * 分块尺度与地球半径之比，相邻分块的局部平面不同，重叠处的边界相差同一量级。
+ *
+ * @param [in] line 折线，连续重复的顶点只计算一次。
+ * @param [in] distance 缓冲距离（取绝对值），地理坐标下单位为米。
+ * @param [in] options 连接方式、端点样式、圆的分段数与分块大小。
+ * @param [in] pool 线程池，用于分块计算与合并，为空时在当前线程中计算。
+ * @param [out] stats 可选，合并失败后的回退次数；回退只影响耗时，不影响结果的正确性。
+ * @return MultiPolygon<Point> 缓冲区；折线退化为一个点时为以该点为圆心的圆，为空或距离为 0 时为空。
+ */
+template <typename Point>
+MultiPolygon<Point> buffer_line(const LineString<Point> &line, double distance, const BufferOptions &options = {},
+                                ThreadPool *pool = nullptr, BufferStats *stats = nullptr) {
+    if (stats != nullptr) {
+        *stats = {};
+    }
+    auto points = buffer_detail::distinct_points(line);
+    distance = std::abs(distance);
+    if (points.empty() || distance == 0.) {
+        return {};
+    }
+    buffer_detail::UnionPlane<Point> plane(points.front());
+    bg::strategy::buffer::distance_symmetric<double> distance_strategy(distance);
+    bg::strategy::buffer::point_circle circle(options.points_per_circle);
+    if (points.size() == 1) {
+        LocalFrame<Point> frame(points);
+        auto center = frame.to_local(points[0]);
+        MultiPolygon<Point2> disc;
+        bg::buffer(Point2(center.x, center.y), disc, distance_strategy, bg::strategy::buffer::side_straight(),
+                   bg::strategy::buffer::join_round(), bg::strategy::buffer::end_round(), circle);
+        return buffer_detail::transform<Point>(
+            disc, [&](const Point2 &p) { return frame.unproject(bg::get<0>(p), bg::get<1>(p)); });
+    }
+
+    // 顶点 [first, last] 在各自局部平面中的缓冲区，换算到合并平面。圆角连接时分块内部的端点也使用圆头（以顶点为
+    // 圆心的圆在缓冲区内）；其他连接方式的分块内部端点平头截断，折线两端的圆头另外以半圆补上
+    bool round_chunk_ends = options.end == EndStyle::kRound && options.join == JoinStyle::kRound;
+    auto buffer_range = [&](size_t first, size_t last) {
+        auto metric = buffer_detail::project_chunk(points, {first, last, first, last});
+        LineString<Point2> chunk_line;
+        for (const auto &p : metric.points) {
+            chunk_line.emplace_back(p.x, p.y);
+        }
+        MultiPolygon<Point2> buffered;
+        buffer_detail::with_join(options, [&](const auto &join) {
+            if (round_chunk_ends) {
+                bg::buffer(chunk_line, buffered, distance_strategy, bg::strategy::buffer::side_straight(), join,
+                           bg::strategy::buffer::end_round(options.points_per_circle), circle);
+            } else {
+                bg::buffer(chunk_line, buffered, distance_strategy, bg::strategy::buffer::side_straight(), join,
+                           bg::strategy::buffer::end_flat(), circle);
+            }
+        });
+        if (options.end == EndStyle::kRound && !round_chunk_ends) {
+            auto add_cap = [&](const LocalPoint &a, const LocalPoint &b) {
+                MultiPolygon<Point2> merged;
+                bg::union_(buffered, buffer_detail::round_cap(a, b, distance, options.points_per_circle), merged);
+                buffered.swap(merged);
+            };
+            if (first == 0) {
+                add_cap(metric.points[0], metric.points[1]);
+            }
+            if (last + 1 == points.size()) {
+                add_cap(metric.points.back(), metric.points[metric.points.size() - 2]);
+            }
+        }
+        return buffer_detail::transform<Point2>(buffered, [&](const Point2 &p) {
+            return plane.to_plane(metric.frame.unproject(bg::get<0>(p), bg::get<1>(p)));
+        });
+    };
+
+    auto chunks = buffer_detail::make_chunks(points.size(), options.chunk_segments);
+    std::vector<buffer_detail::Part> parts(chunks.size());
+    parallel_for(
+        pool, chunks.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                auto polygons = buffer_range(chunks[c].first, chunks[c].last);
+                double area = bg::area(polygons);
+                parts[c] = {chunks[c].first, chunks[c].last, std::move(polygons), area};
+            }
+        },
+        1);
+    std::atomic<size_t> recomputed{0};
+    auto merged = buffer_detail::union_all(std::move(parts), pool, [&](size_t first, size_t last) {
+        recomputed.fetch_add(1, std::memory_order_relaxed);
+        return buffer_range(first, last);
+    });
+    bool fallback = chunks.size() > 1 && !bg::is_valid(merged);
+    if (fallback) {
+        merged = buffer_range(0, points.size() - 1);  // 合并结果自相交（Boost 合并的数值问题）
+    }
+    if (stats != nullptr) {
+        stats->recomputed_merges = recomputed.load(std::memory_order_relaxed);
+        stats->whole_line_fallback = fallback;
+    }
+    return buffer_detail::transform<Point>(merged, [&](const Point2 &p) { return plane.from_plane(p); });
+}
+
+/**
+ * @brief 折线句柄的偏移线，语义与 `offset_line(LineString, ...)` 相同，结果同样以句柄返回。
+ */
+template <typename Point>
+LineHandle<Point> offset_line(const LineHandle<Point> &line, double distance, const BufferOptions &options = {},
+                              ThreadPool *pool = nullptr) {
+    return LineHandle<Point>(offset_line(line.line(), distance, options, pool));
+}
+
+/**
+ * @brief 折线句柄的缓冲区，语义与 `buffer_line(LineString, ...)` 相同。
+ */
+template <typename Point>
+MultiPolygon<Point> buffer_line(const LineHandle<Point> &line, double distance, const BufferOptions &options = {},
+                                ThreadPool *pool = nullptr, BufferStats *stats = nullptr) {
+    return buffer_line(line.line(), distance, options, pool, stats);
+}
+
+/**
+ * @brief 批量计算折线的缓冲区，在线程池中按折线并行，每条折线在当前线程中计算。
+ *
+ * @param [in] lines 折线集合。
+ * @param [in] distance 缓冲距离，地理坐标下单位为米。
+ * @param [in] options 连接方式、端点样式、圆的分段数与分块大小。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<MultiPolygon<Point>> 与 `lines` 一一对应的缓冲区。
+ */
+template <typename Point>
+std::vector<MultiPolygon<Point>> buffer_line_batch(const std::vector<LineString<Point>> &lines, double distance,
+                                                   const BufferOptions &options = {}, ThreadPool *pool = nullptr) {
+    std::vector<MultiPolygon<Point>> results(lines.size());
+    parallel_for(
+        pool, lines.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = buffer_line(lines[i], distance, options);
+            }
+        },
+        1);
+    return results;
+}
+
+/**
+ * @brief 批量计算折线的偏移线，在线程池中按折线并行。
+ *
+ * @param [in] lines 折线集合。
+ * @param [in] distance 偏移距离，正值向左，地理坐标下单位为米。
+ * @param [in] options 连接方式与分块大小。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<LineString<Point>> 与 `lines` 一一对应的偏移线。
+ */
+template <typename Point>
+std::vector<LineString<Point>> offset_line_batch(const std::vector<LineString<Point>> &lines, double distance,
+                                                 const BufferOptions &options = {}, ThreadPool *pool = nullptr) {
+    std::vector<LineString<Point>> results(lines.size());
+    parallel_for(
+        pool, lines.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = offset_line(lines[i], distance, options);
+            }
+        },
+        16);
+    return results;
+}
+
+}  // namespace simplegeom
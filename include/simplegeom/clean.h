@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/line_handle.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+struct CleanOptions {
+    double tolerance = 0.;  // 去重与共线判断的容差，单位与 `distance` 相同（地理坐标下为米），0 时只去掉完全重合的顶点
+    double grid = 0.;       // 吸附网格的间距，单位为坐标单位（地理坐标下为度），0 时不吸附；坐标与间距之比需小于 2^51
+};
+
+namespace clean_detail {
+
+static constexpr size_t kMaxRun = 64;  // 两个保留顶点之间最多跳过的顶点数，限制覆盖检查的开销
+static constexpr double kRound = 6755399441055744.;  // 1.5 × 2^52
+
+// 舍入到最近的整数（偶数优先），|v| < 2^51。只有加减法，不需要 SSE4.1 的舍入指令，也没有分支
+inline double round_even(double v) { return (v + kRound) - kRound; }
+
+// 吸附到间距为 `grid` 的网格，`inverse` 为 1 / grid
+inline double snap(double v, double grid, double inverse) { return round_even(v * inverse) * grid; }
+
+/**
+ * @brief 按列计算吸附后的顶点在局部平面中的坐标（笛卡尔坐标为原始单位，地理坐标为米）。
+ *
+ * 循环内只有乘加，经度差也用舍入展开到 [-180, 180]，没有分支，编译器可以将其向量化。地理坐标以第一个点为
+ * 原点，按第一个点的纬度换算为米，适用于城市范围内的折线。
+ */
+template <typename Point>
+void project_columns(const LineString<Point> &line, const CleanOptions &options, std::vector<double> &xs,
+                     std::vector<double> &ys) {
+    size_t n = line.size();
+    xs.resize(n);
+    ys.resize(n);
+    double grid = options.grid, inverse = grid > 0. ? 1. / grid : 0.;
+    auto pass = [&](auto &&round) {
+        double x0 = round(bg::get<0>(line[0])), y0 = round(bg::get<1>(line[0]));
+        LocalFrame<Point> frame(Point(x0, y0));
+        double kx = frame.scale_x(), ky = frame.scale_y();
+        for (size_t k = 0; k < n; ++k) {
+            double dx = round(bg::get<0>(line[k])) - x0, dy = round(bg::get<1>(line[k])) - y0;
+            if constexpr (std::is_same_v<Point, PointGeo2>) {
+                dx -= 360. * round_even(dx * (1. / 360.));
+            }
+            xs[k] = dx * kx;
+            ys[k] = dy * ky;
+        }
+    };
+    if (grid > 0.) {
+        pass([&](double v) { return snap(v, grid, inverse); });
+    } else {
+        pass([](double v) { return v; });
+    }
+}
+
+/**
+ * @brief 在局部平面坐标上选出保留的顶点。
+ *
+ * 与上一个保留的顶点（或候选顶点）的距离不超过容差的顶点视为重复，直接跳过；候选顶点在其前后保留顶点之间的
+ * 所有被跳过的顶点到两者连线的距离都不超过容差时去掉（共线的顶点与来回的小锯齿），否则保留。每个输入顶点到
+ * 结果折线的距离不超过容差，首尾两点总是保留，结果中相邻顶点的距离大于容差（最后一段除外，但不为 0）。
+ */
+inline void select_vertices(const std::vector<double> &xs, const std::vector<double> &ys, double tolerance,
+                            std::vector<uint32_t> &kept) {
+    size_t n = xs.size();
+    kept.clear();
+    if (n == 0) {
+        return;
+    }
+    double squared = tolerance * tolerance;
+    auto distance2 = [&](size_t i, size_t j) {
+        double dx = xs[j] - xs[i], dy = ys[j] - ys[i];
+        return dx * dx + dy * dy;
+    };
+    // (a, k) 之间的顶点到线段 a–k 的距离都不超过容差
+    auto covered = [&](size_t a, size_t k) {
+        double dx = xs[k] - xs[a], dy = ys[k] - ys[a], length2 = dx * dx + dy * dy;
+        for (size_t i = a + 1; i < k; ++i) {
+            double px = xs[i] - xs[a], py = ys[i] - ys[a];
+            double t = length2 > 0. ? std::clamp((px * dx + py * dy) / length2, 0., 1.) : 0.;
+            double ex = px - t * dx, ey = py - t * dy;
+            if (ex * ex + ey * ey > squared) {
+                return false;
+            }
+        }
+        return true;
+    };
+    kept.push_back(0);
+    size_t a = 0, b = n;  // 上一个保留的顶点与候选顶点，b == n 表示没有候选顶点
+    for (size_t k = 1; k < n; ++k) {
+        if (distance2(b == n ? a : b, k) <= squared) {
+            continue;
+        }
+        if (b != n && (k - a > kMaxRun || !covered(a, k))) {
+            kept.push_back(static_cast<uint32_t>(b));
+            a = b;
+        }
+        b = k;
+    }
+    if (b != n) {
+        kept.push_back(static_cast<uint32_t>(b));
+    }
+    if (kept.back() != n - 1 && distance2(kept.back(), n - 1) > 0.) {
+        kept.push_back(static_cast<uint32_t>(n - 1));
+    }
+}
+
+}  // namespace clean_detail
+
+/**
+ * @brief 清理折线：吸附到网格，去掉重复的顶点、共线的顶点与小于容差的来回锯齿。
+ *
+ * 重复的顶点会产生长度为 0 的线段（`closest_point` 中投影比例为 NaN 的情形），多余的顶点也会增加投影时遍历的
+ * 线段数。先按列计算吸附后的坐标与局部平面坐标（可以向量化），再一次遍历选出保留的顶点，只为保留的顶点构造
+ * 结果。
+ *
+ * @tparam Point 点类型，支持 Point2 与 PointGeo2。
+ * @param [in] line 折线。
+ * @param [in] options 容差与网格间距。
+ * @return LineString<Point> 清理后的折线：相邻顶点不重合，输入的每个顶点（吸附后）到结果的距离不超过容差，
+ * 首尾两点保留（吸附后）。输入的所有顶点都重合时只有一个点。
+ */
+template <typename Point>
+LineString<Point> clean_line(const LineString<Point> &line, const CleanOptions &options = {}) {
+    static_assert(std::is_same_v<Point, Point2> || std::is_same_v<Point, PointGeo2>,
+                  "clean_line supports Point2 and PointGeo2");
+    LineString<Point> result;
+    if (line.empty()) {
+        return result;
+    }
+    std::vector<double> xs, ys;
+    std::vector<uint32_t> kept;
+    clean_detail::project_columns(line, options, xs, ys);
+    clean_detail::select_vertices(xs, ys, std::max(options.tolerance, 0.), kept);
+    result.reserve(kept.size());
+    double grid = options.grid, inverse = grid > 0. ? 1. / grid : 0.;
+    for (uint32_t k : kept) {
+        double x = bg::get<0>(line[k]), y = bg::get<1>(line[k]);
+        if (grid > 0.) {
+            x = clean_detail::snap(x, grid, inverse);
+            y = clean_detail::snap(y, grid, inverse);
+        }
+        result.emplace_back(x, y);
+    }
+    return result;
+}
+
+/**
+ * @brief 清理折线句柄，语义与 `clean_line(LineString, ...)` 相同。
+ *
+ * 折线已经是干净的（清理没有改变任何顶点）时返回共享同一份数据的句柄，已经缓存的外包框、累积长度与线段索引
+ * 随之保留，不复制顶点。
+ */
+template <typename Point>
+LineHandle<Point> clean_line(const LineHandle<Point> &line, const CleanOptions &options = {}) {
+    auto cleaned = clean_line(line.line(), options);
+    if (cleaned.size() == line.size() &&
+        std::equal(cleaned.begin(), cleaned.end(), line.begin(), [](const Point &a, const Point &b) {
+            return bg::get<0>(a) == bg::get<0>(b) && bg::get<1>(a) == bg::get<1>(b);
+        })) {
+        return line;
+    }
+    return LineHandle<Point>(std::move(cleaned));
+}
+
+/**
+ * @brief 批量清理多条折线。
+ *
+ * @param [in] lines 折线集合。
+ * @param [in] options 容差与网格间距。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<LineString<Point>> 与 `lines` 一一对应的清理结果。
+ */
+template <typename Point>
+std::vector<LineString<Point>> clean_line_batch(const std::vector<LineString<Point>> &lines,
+                                                const CleanOptions &options = {}, ThreadPool *pool = nullptr) {
+    std::vector<LineString<Point>> results(lines.size());
+    parallel_for(
+        pool, lines.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = clean_line(lines[i], options);
+            }
+        },
+        16);
+    return results;
+}
+
+}  // namespace simplegeom
@@ -20,11 +20,21 @@ using Box = bg::model::box<Point>;
 template <typename Point>
 using Polygon = bg::model::polygon<Point>;
 
+template <typename Point>
+using MultiPolygon = bg::model::multi_polygon<Polygon<Point>>;
+
 template <typename Point>
 using Segment = bg::model::segment<Point>;
 
 enum class ProjectionMode { kSimple, kAccumulate };
 
+// 点在折线上的投影结果
+struct LineProjection {
+    double distance = -1.;       // 点到最近线段的距离，-1 表示无效结果
+    size_t segment_index = 0;    // 最近线段的序号（起点在折线中的下标）
+    double segment_offset = 0.;  // 投影点到最近线段起点的距离
+};
+
 template <typename Point>
 inline void assign_segment(const Point &p1, const Point &p2, Segment<Point> &seg) {
     seg.first = p1;
@@ -0,0 +1,588 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+namespace bgi = boost::geometry::index;
+
+namespace coverage_detail {
+
+static constexpr size_t kMaxRefinements = 12;  // 容差减半的次数上限，超过后保留该弧段的全部顶点
+
+// 坐标的位模式，坐标完全相同的顶点视为同一个顶点
+struct VertexKey {
+    uint64_t x, y;
+
+    bool operator==(const VertexKey &other) const { return x == other.x && y == other.y; }
+};
+
+template <typename Point>
+VertexKey vertex_key(const Point &p) {
+    // 加 0 将 -0 规范为 +0
+    double x = bg::get<0>(p) + 0., y = bg::get<1>(p) + 0.;
+    VertexKey key;
+    std::memcpy(&key.x, &x, sizeof(x));
+    std::memcpy(&key.y, &y, sizeof(y));
+    return key;
+}
+
+/**
+ * @brief 按坐标为顶点编号的开放寻址表。
+ *
+ * 表中只存编号，比较时回到输入中的顶点取坐标；与 `std::unordered_map` 相比没有逐个节点的分配，容量为 2 的幂，
+ * 装载率超过一半时加倍。
+ */
+template <typename Point>
+class VertexTable {
+public:
+    explicit VertexTable(size_t expected) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) {
+            capacity *= 2;
+        }
+        slots_.assign(capacity, kEmpty);
+    }
+
+    // 返回 `p` 的编号，新的坐标追加到 `vertices`
+    uint32_t insert(const Point &p, std::vector<const Point *> &vertices) {
+        VertexKey key = vertex_key(p);
+        size_t mask = slots_.size() - 1;
+        for (size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+            uint32_t id = slots_[i];
+            if (id == kEmpty) {
+                id = static_cast<uint32_t>(vertices.size());
+                vertices.push_back(&p);
+                slots_[i] = id;
+                if (vertices.size() * 2 > slots_.size()) {
+                    grow(vertices);
+                }
+                return id;
+            }
+            if (vertex_key(*vertices[id]) == key) {
+                return id;
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+
+    static size_t hash(const VertexKey &key) {
+        uint64_t h = key.x * 0x9e3779b97f4a7c15ull ^ key.y;
+        h = (h ^ (h >> 32)) * 0xd6e8feb86659fd93ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    void grow(const std::vector<const Point *> &vertices) {
+        slots_.assign(slots_.size() * 2, kEmpty);
+        size_t mask = slots_.size() - 1;
+        for (size_t id = 0; id < vertices.size(); ++id) {
+            size_t i = hash(vertex_key(*vertices[id])) & mask;
+            while (slots_[i] != kEmpty) {
+                i = (i + 1) & mask;
+            }
+            slots_[i] = static_cast<uint32_t>(id);
+        }
+    }
+
+    std::vector<uint32_t> slots_;
+};
+
+// 顶点的不同邻接顶点，多于两个时只记录个数
+struct Neighbours {
+    uint32_t first = UINT32_MAX, second = UINT32_MAX;
+    uint32_t count = 0;
+
+    void add(uint32_t v) {
+        if (v == first || v == second || count > 2) {
+            return;
+        }
+        (count == 0 ? first : second) = v;
+        count = count == 0 ? 1 : (count == 1 ? 2 : 3);
+    }
+};
+
+// 公共局部平面中的坐标
+struct XY {
+    double x, y;
+};
+
+// (a - o) × (b - o)，b 在 o→a 左侧时为正
+inline double cross(const XY &o, const XY &a, const XY &b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+/**
+ * @brief 覆盖的拓扑：顶点去重后，环被切分为弧段，两个多边形的公共边界只存储一次。
+ *
+ * 度数（不同邻接顶点的个数）不为 2 的顶点为节点，环在节点处切分为弧段；没有节点的环（飞地、内环）整体作为一条
+ * 闭合弧段，从编号最小的顶点开始。弧段与环都按 CSR 方式存储，顶点只记录指向输入的指针。
+ */
+template <typename Point>
+struct Topology {
+    std::vector<const Point *> vertices;
+    std::vector<XY> planar;              // 顶点在公共局部平面中的坐标
+    std::vector<uint32_t> arc_vertices;  // 弧段依次经过的顶点编号，闭合弧段首尾相同
+    std::vector<size_t> arc_offsets{0};
+    std::vector<uint32_t> ring_arcs;  // 环依次经过的弧段，值为 弧段编号 << 1 | 是否反向
+    std::vector<size_t> ring_offsets{0};
+    std::vector<size_t> polygon_rings{0};  // 多边形的环在 `ring_offsets` 中的范围，第一个为外环
+
+    size_t arc_count() const { return arc_offsets.size() - 1; }
+    size_t ring_count() const { return ring_offsets.size() - 1; }
+    size_t polygon_count() const { return polygon_rings.size() - 1; }
+};
+
+template <typename Point>
+Topology<Point> build_topology(const std::vector<Polygon<Point>> &polygons) {
+    Topology<Point> topology;
+    size_t total = 0;
+    for (const auto &polygon : polygons) {
+        total += bg::num_points(polygon);
+    }
+    // 公共边界上的顶点至少出现两次
+    VertexTable<Point> table(total / 2 + 1);
+    std::vector<uint32_t> ring_vertices;
+    std::vector<size_t> ring_vertex_offsets{0};
+    ring_vertices.reserve(total);
+    auto add_ring = [&](const auto &ring) {
+        size_t begin = ring_vertices.size();
+        for (const auto &p : ring) {
+            uint32_t id = table.insert(p, topology.vertices);
+            if (ring_vertices.size() == begin || ring_vertices.back() != id) {
+                ring_vertices.push_back(id);
+            }
+        }
+        // 去掉闭合点
+        while (ring_vertices.size() > begin + 1 && ring_vertices.back() == ring_vertices[begin]) {
+            ring_vertices.pop_back();
+        }
+        ring_vertex_offsets.push_back(ring_vertices.size());
+    };
+    for (const auto &polygon : polygons) {
+        add_ring(bg::exterior_ring(polygon));
+        for (const auto &inner : bg::interior_rings(polygon)) {
+            add_ring(inner);
+        }
+        topology.polygon_rings.push_back(ring_vertex_offsets.size() - 1);
+    }
+
+    // 相对第一个顶点的坐标差，换算为米时使用各条弧段起点的纬度（见 `simplify_arc`）
+    LocalFrame<Point> frame;
+    if (!topology.vertices.empty()) {
+        frame = LocalFrame<Point>(*topology.vertices[0]);
+    }
+    topology.planar.reserve(topology.vertices.size());
+    for (const Point *p : topology.vertices) {
+        auto q = frame.project(*p);
+        topology.planar.push_back({q.x, q.y});
+    }
+
+    std::vector<Neighbours> neighbours(topology.vertices.size());
+    size_t rings = ring_vertex_offsets.size() - 1;
+    for (size_t r = 0; r < rings; ++r) {
+        size_t begin = ring_vertex_offsets[r], n = ring_vertex_offsets[r + 1] - begin;
+        for (size_t i = 0; n > 1 && i < n; ++i) {
+            uint32_t a = ring_vertices[begin + i], b = ring_vertices[begin + (i + 1) % n];
+            neighbours[a].add(b);
+            neighbours[b].add(a);
+        }
+    }
+    auto is_node = [&](uint32_t v) { return neighbours[v].count != 2; };
+
+    // 以有向的第一条边标识弧段：从节点出发沿一条边走到下一个节点的路径是唯一的，反向经过的弧段以最后一条边的
+    // 反向为键
+    std::unordered_map<uint64_t, uint32_t> arc_keys;
+    for (size_t r = 0; r < rings; ++r) {
+        const uint32_t *v = ring_vertices.data() + ring_vertex_offsets[r];
+        size_t n = ring_vertex_offsets[r + 1] - ring_vertex_offsets[r], start = 0;
+        while (start < n && !is_node(v[start])) {
+            ++start;
+        }
+        if (start == n && n > 0) {
+            start = static_cast<size_t>(std::min_element(v, v + n) - v);
+        }
+        // 从 `start` 开始的第 i 个顶点，i ≤ n
+        auto at = [&](size_t i) { return v[start + i < n ? start + i : start + i - n]; };
+        for (size_t k = 0; k < n;) {
+            auto found = arc_keys.find(uint64_t(at(k)) << 32 | at(k + 1));
+            if (found != arc_keys.end()) {
+                // 已有的弧段按其长度跳过
+                uint32_t arc = found->second >> 1;
+                topology.ring_arcs.push_back(found->second);
+                k += topology.arc_offsets[arc + 1] - topology.arc_offsets[arc] - 1;
+                continue;
+            }
+            auto id = static_cast<uint32_t>(topology.arc_count());
+            topology.arc_vertices.push_back(at(k));
+            size_t j = k + 1;
+            while (j < n && !is_node(at(j))) {
+                topology.arc_vertices.push_back(at(j++));
+            }
+            topology.arc_vertices.push_back(at(j));
+            topology.arc_offsets.push_back(topology.arc_vertices.size());
+            arc_keys.emplace(uint64_t(at(k)) << 32 | at(k + 1), id << 1);
+            arc_keys.emplace(uint64_t(at(j)) << 32 | at(j - 1), id << 1 | 1);
+            topology.ring_arcs.push_back(id << 1);
+            k = j;
+        }
+        topology.ring_offsets.push_back(topology.ring_arcs.size());
+    }
+    return topology;
+}
+
+/**
+ * @brief 对一条弧段做 Douglas–Peucker 化简，两端保持不动。
+ *
+ * 距离在以弧段起点纬度为参考的等距圆柱投影中计算（米），笛卡尔坐标直接使用原始坐标。闭合弧段先在离起点最远的
+ * 顶点处分为两段。`tolerance` 为负数时保留全部顶点。
+ *
+ * @param [out] kept 保留的顶点在弧段中的序号，升序。
+ * @param [in,out] keep 临时缓冲区。
+ */
+template <typename Point>
+void simplify_arc(const Topology<Point> &topology, size_t arc, double tolerance, std::vector<uint32_t> &kept,
+                  std::vector<char> &keep) {
+    const uint32_t *v = topology.arc_vertices.data() + topology.arc_offsets[arc];
+    size_t n = topology.arc_offsets[arc + 1] - topology.arc_offsets[arc];
+    kept.clear();
+    if (tolerance < 0.) {
+        for (size_t i = 0; i < n; ++i) {
+            kept.push_back(static_cast<uint32_t>(i));
+        }
+        return;
+    }
+    LocalFrame<Point> frame(*topology.vertices[v[0]]);
+    double sx = frame.scale_x(), sy = frame.scale_y();
+    auto at = [&](size_t i) { return topology.planar[v[i]]; };
+    keep.assign(n, 0);
+    keep[0] = keep[n - 1] = 1;
+    std::vector<std::pair<size_t, size_t>> stack;
+    if (n > 2 && v[0] == v[n - 1]) {
+        size_t farthest = 1;
+        double best = -1.;
+        for (size_t i = 1; i + 1 < n; ++i) {
+            double dx = (at(i).x - at(0).x) * sx, dy = (at(i).y - at(0).y) * sy, d = dx * dx + dy * dy;
+            if (d > best) {
+                best = d;
+                farthest = i;
+            }
+        }
+        keep[farthest] = 1;
+        stack.emplace_back(0, farthest);
+        stack.emplace_back(farthest, n - 1);
+    } else {
+        stack.emplace_back(0, n - 1);
+    }
+    double squared = tolerance * tolerance;
+    while (!stack.empty()) {
+        auto [first, last] = stack.back();
+        stack.pop_back();
+        if (last <= first + 1) {
+            continue;
+        }
+        double ax = at(first).x * sx, ay = at(first).y * sy;
+        double dx = at(last).x * sx - ax, dy = at(last).y * sy - ay, length2 = dx * dx + dy * dy;
+        size_t farthest = first;
+        double best = -1.;
+        for (size_t i = first + 1; i < last; ++i) {
+            double px = at(i).x * sx - ax, py = at(i).y * sy - ay;
+            double t = length2 > 0. ? std::clamp((px * dx + py * dy) / length2, 0., 1.) : 0.;
+            double ex = px - t * dx, ey = py - t * dy, d = ex * ex + ey * ey;
+            if (d > best) {
+                best = d;
+                farthest = i;
+            }
+        }
+        if (best > squared) {
+            keep[farthest] = 1;
+            stack.emplace_back(first, farthest);
+            stack.emplace_back(farthest, last);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (keep[i]) {
+            kept.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+// 化简后的一条线段，`a`、`b` 为顶点编号
+struct ArcSegment {
+    uint32_t arc, a, b;
+};
+
+// 两条化简后的线段是否破坏拓扑：不共享顶点时不能相交（包括接触），共享一个顶点时不能共线重叠，两条不同的线段
+// 不能连接同一对顶点
+template <typename Point>
+bool segments_conflict(const Topology<Point> &topology, const ArcSegment &s, const ArcSegment &t) {
+    if (s.a == s.b || t.a == t.b) {
+        return false;
+    }
+    const auto &planar = topology.planar;
+    bool aa = s.a == t.a, ab = s.a == t.b, ba = s.b == t.a, bb = s.b == t.b;
+    if ((aa && bb) || (ab && ba)) {
+        return true;
+    }
+    if (aa || ab || ba || bb) {
+        uint32_t shared = aa || ab ? s.a : s.b, u = shared == s.a ? s.b : s.a, w = aa || ba ? t.b : t.a;
+        const auto &o = planar[shared], &p = planar[u], &q = planar[w];
+        return cross(o, p, q) == 0. && (p.x - o.x) * (q.x - o.x) + (p.y - o.y) * (q.y - o.y) > 0.;
+    }
+    const auto &p1 = planar[s.a], &p2 = planar[s.b], &q1 = planar[t.a], &q2 = planar[t.b];
+    double d1 = cross(q1, q2, p1), d2 = cross(q1, q2, p2), d3 = cross(p1, p2, q1), d4 = cross(p1, p2, q2);
+    if (((d1 > 0. && d2 < 0.) || (d1 < 0. && d2 > 0.)) && ((d3 > 0. && d4 < 0.) || (d3 < 0. && d4 > 0.))) {
+        return true;
+    }
+    auto on_segment = [](const XY &a, const XY &b, const XY &p) {
+        return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= p.y &&
+               p.y <= std::max(a.y, b.y);
+    };
+    return (d1 == 0. && on_segment(q1, q2, p1)) || (d2 == 0. && on_segment(q1, q2, p2)) ||
+           (d3 == 0. && on_segment(p1, p2, q1)) || (d4 == 0. && on_segment(p1, p2, q2));
+}
+
+// 依次访问化简后的环上的顶点编号（不含闭合点）
+template <typename Point, typename Func>
+void for_each_ring_vertex(const Topology<Point> &topology, const std::vector<std::vector<uint32_t>> &kept, size_t ring,
+                          Func &&func) {
+    for (size_t i = topology.ring_offsets[ring]; i < topology.ring_offsets[ring + 1]; ++i) {
+        uint32_t arc = topology.ring_arcs[i] >> 1;
+        const uint32_t *v = topology.arc_vertices.data() + topology.arc_offsets[arc];
+        const auto &k = kept[arc];
+        if (topology.ring_arcs[i] & 1) {
+            for (size_t j = k.size() - 1; j > 0; --j) {
+                func(v[k[j]]);
+            }
+        } else {
+            for (size_t j = 0; j + 1 < k.size(); ++j) {
+                func(v[k[j]]);
+            }
+        }
+    }
+}
+
+// 点是否在化简后的环内（射线法）
+template <typename Point>
+bool inside_ring(const Topology<Point> &topology, const std::vector<std::vector<uint32_t>> &kept, size_t ring,
+                 const XY &p) {
+    bool inside = false, first = true;
+    XY head{}, previous{};
+    auto edge = [&](const XY &a, const XY &b) {
+        if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (p.y - a.y) * (b.x - a.x) / (b.y - a.y)) {
+            inside = !inside;
+        }
+    };
+    for_each_ring_vertex(topology, kept, ring, [&](uint32_t id) {
+        const auto &q = topology.planar[id];
+        if (first) {
+            head = q;
+            first = false;
+        } else {
+            edge(previous, q);
+        }
+        previous = q;
+    });
+    if (!first) {
+        edge(previous, head);
+    }
+    return inside;
+}
+
+}  // namespace coverage_detail
+
+/**
+ * @brief 保持拓扑的覆盖化简：相邻多边形的公共边界只化简一次，化简后仍然严格重合，不产生缝隙与重叠。
+ *
+ * 先按坐标对顶点去重，将所有环在节点（多于两个多边形相交的顶点，或覆盖外边界上的转折点）处切分为弧段，每条公共
+ * 边界只存储一次；再在线程池中并行地对每条弧段做 Douglas–Peucker 化简（两端节点保持不动），最后由弧段重新拼接
+ * 各多边形的环。化简后检查：环至少保留 3 个不同顶点；任意两条线段不相交（共享端点的除外）；内环仍在外环内。
+ * 违反时将相关弧段的容差减半后重新化简，直至通过或保留该弧段的全部顶点，重新检查只涉及变化的弧段。
+ *
+ * 公共边界只存储、化简一次，顶点只保存指向输入的指针，中间结果的内存少于逐个多边形化简。
+ *
+ * @tparam Point 点类型，支持 Point2 与 PointGeo2。
+ * @param [in] polygons 多边形覆盖，相邻多边形的公共边界必须有完全相同的顶点（坐标逐位相等）。
+ * @param [in] tolerance 化简容差，单位与 `distance` 相同（地理坐标下为米）。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<Polygon<Point>> 与输入一一对应的化简结果，环的方向不变，起点可能移到某个节点。
+ * @note 拓扑检查在公共局部平面中进行，适用于城市或省级范围的覆盖。
+ */
+template <typename Point>
+std::vector<Polygon<Point>> simplify_coverage(const std::vector<Polygon<Point>> &polygons, double tolerance,
+                                              ThreadPool *pool = nullptr) {
+    static_assert(std::is_same_v<Point, Point2> || std::is_same_v<Point, PointGeo2>,
+                  "simplify_coverage supports Point2 and PointGeo2");
+    using coverage_detail::ArcSegment;
+    auto topology = coverage_detail::build_topology(polygons);
+    size_t arcs = topology.arc_count();
+
+    std::vector<std::vector<uint32_t>> kept(arcs);
+    std::vector<double> tolerances(arcs, tolerance);
+    std::vector<size_t> refinements(arcs, 0);
+    std::vector<uint32_t> dirty(arcs);
+    for (size_t i = 0; i < arcs; ++i) {
+        dirty[i] = static_cast<uint32_t>(i);
+    }
+    auto refinable = [&](size_t arc) {
+        return kept[arc].size() < topology.arc_offsets[arc + 1] - topology.arc_offsets[arc];
+    };
+
+    using IndexValue = std::pair<Box<Point2>, uint32_t>;
+    using RTree = bgi::rtree<IndexValue, bgi::quadratic<16>>;
+    auto box = [&](const ArcSegment &s) {
+        const auto &a = topology.planar[s.a], &b = topology.planar[s.b];
+        return Box<Point2>(Point2(std::min(a.x, b.x), std::min(a.y, b.y)),
+                           Point2(std::max(a.x, b.x), std::max(a.y, b.y)));
+    };
+
+    while (!dirty.empty()) {
+        parallel_for(
+            pool, dirty.size(),
+            [&](size_t begin, size_t end) {
+                std::vector<char> keep;
+                for (size_t i = begin; i < end; ++i) {
+                    coverage_detail::simplify_arc(topology, dirty[i], tolerances[dirty[i]], kept[dirty[i]], keep);
+                }
+            },
+            16);
+
+        std::vector<ArcSegment> segments;
+        std::vector<size_t> segment_offsets{0};
+        segment_offsets.reserve(arcs + 1);
+        for (size_t arc = 0; arc < arcs; ++arc) {
+            const uint32_t *v = topology.arc_vertices.data() + topology.arc_offsets[arc];
+            for (size_t j = 0; j + 1 < kept[arc].size(); ++j) {
+                segments.push_back({static_cast<uint32_t>(arc), v[kept[arc][j]], v[kept[arc][j + 1]]});
+            }
+            segment_offsets.push_back(segments.size());
+        }
+        std::vector<IndexValue> values;
+        values.reserve(segments.size());
+        for (size_t i = 0; i < segments.size(); ++i) {
+            values.emplace_back(box(segments[i]), static_cast<uint32_t>(i));
+        }
+        RTree rtree(values.begin(), values.end());
+        std::vector<IndexValue>().swap(values);
+
+        std::vector<char> marked(arcs, 0);
+        auto mark = [&](size_t arc) {
+            if (refinable(arc)) {
+                marked[arc] = 1;
+            }
+        };
+        // 环至少保留 3 个不同顶点
+        for (size_t r = 0; r < topology.ring_count(); ++r) {
+            size_t distinct = 0;
+            for (size_t i = topology.ring_offsets[r]; i < topology.ring_offsets[r + 1]; ++i) {
+                distinct += kept[topology.ring_arcs[i] >> 1].size() - 1;
+            }
+            if (distinct < 3) {
+                for (size_t i = topology.ring_offsets[r]; i < topology.ring_offsets[r + 1]; ++i) {
+                    mark(topology.ring_arcs[i] >> 1);
+                }
+            }
+        }
+        // 内环仍在外环内：内环与外环不相交时，检查内环的一个顶点即可
+        std::vector<char> escaped(topology.polygon_count(), 0);
+        parallel_for(
+            pool, topology.polygon_count(),
+            [&](size_t begin, size_t end) {
+                for (size_t p = begin; p < end; ++p) {
+                    size_t outer = topology.polygon_rings[p];
+                    for (size_t r = outer + 1; r < topology.polygon_rings[p + 1]; ++r) {
+                        if (topology.ring_offsets[r] == topology.ring_offsets[r + 1]) {
+                            continue;
+                        }
+                        uint32_t arc = topology.ring_arcs[topology.ring_offsets[r]] >> 1;
+                        const auto &anchor = topology.planar[topology.arc_vertices[topology.arc_offsets[arc]]];
+                        escaped[p] |= !coverage_detail::inside_ring(topology, kept, outer, anchor);
+                    }
+                }
+            },
+            16);
+        for (size_t p = 0; p < topology.polygon_count(); ++p) {
+            size_t outer = topology.polygon_rings[p];
+            for (size_t i = topology.ring_offsets[outer]; escaped[p] && i < topology.ring_offsets[outer + 1]; ++i) {
+                mark(topology.ring_arcs[i] >> 1);
+            }
+        }
+        // 只检查变化的弧段的线段
+        std::vector<uint32_t> queries;
+        for (uint32_t arc : dirty) {
+            for (size_t i = segment_offsets[arc]; i < segment_offsets[arc + 1]; ++i) {
+                queries.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        std::vector<uint32_t> partners(queries.size(), UINT32_MAX);
+        parallel_for(pool, queries.size(), [&](size_t begin, size_t end) {
+            std::vector<IndexValue> hits;
+            for (size_t i = begin; i < end; ++i) {
+                const auto &s = segments[queries[i]];
+                hits.clear();
+                rtree.query(bgi::intersects(box(s)), std::back_inserter(hits));
+                for (const auto &hit : hits) {
+                    if (hit.second != queries[i] &&
+                        coverage_detail::segments_conflict(topology, s, segments[hit.second])) {
+                        partners[i] = hit.second;
+                        // 该弧段已无法细化时需要继续寻找可细化的另一侧
+                        if (refinable(s.arc) || refinable(segments[hit.second].arc)) {
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+        for (size_t i = 0; i < queries.size(); ++i) {
+            if (partners[i] != UINT32_MAX) {
+                mark(segments[queries[i]].arc);
+                mark(segments[partners[i]].arc);
+            }
+        }
+
+        dirty.clear();
+        for (size_t arc = 0; arc < arcs; ++arc) {
+            if (marked[arc]) {
+                tolerances[arc] = ++refinements[arc] > coverage_detail::kMaxRefinements ? -1. : tolerances[arc] * 0.5;
+                dirty.push_back(static_cast<uint32_t>(arc));
+            }
+        }
+    }
+
+    std::vector<Polygon<Point>> result(polygons.size());
+    parallel_for(
+        pool, polygons.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p) {
+                for (size_t r = topology.polygon_rings[p]; r < topology.polygon_rings[p + 1]; ++r) {
+                    typename Polygon<Point>::ring_type ring;
+                    coverage_detail::for_each_ring_vertex(
+                        topology, kept, r, [&](uint32_t id) { ring.push_back(*topology.vertices[id]); });
+                    if (!ring.empty()) {
+                        ring.push_back(ring.front());
+                    }
+                    if (r == topology.polygon_rings[p]) {
+                        result[p].outer() = std::move(ring);
+                    } else {
+                        result[p].inners().push_back(std::move(ring));
+                    }
+                }
+            }
+        },
+        16);
+    return result;
+}
+
+}  // namespace simplegeom
@@ -0,0 +1,558 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+// Delaunay 三角剖分
+struct Triangulation {
+    static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+    std::vector<std::array<uint32_t, 3>> triangles;  // 顶点在输入中的序号，在（局部）平面中为逆时针方向
+    std::vector<std::array<uint32_t, 3>> neighbors;  // 与第 i 个顶点相对的边的相邻三角形，`kNone` 表示凸包边
+};
+
+namespace delaunay_detail {
+
+/**
+ * @brief 精确的符号判断所需的浮点展开（Shewchuk）。
+ *
+ * 一个展开是若干个互不重叠、按绝对值递增排列的浮点数之和，由 `two_sum` 与 `two_product` 无误差地构造，
+ * 和的符号即为最后一个非零分量的符号。只在快速的浮点判断无法确定符号时使用。
+ */
+using Expansion = std::vector<double>;
+
+inline void two_sum(double a, double b, double &x, double &y) {
+    x = a + b;
+    double bv = x - a;
+    y = (a - (x - bv)) + (b - bv);
+}
+
+inline Expansion two_diff(double a, double b) {
+    double x, y;
+    two_sum(a, -b, x, y);
+    return {y, x};
+}
+
+// 将 b 加到展开 e 上（Grow-Expansion），去掉零分量
+inline Expansion grow(const Expansion &e, double b) {
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double v : e) {
+        double sum, err;
+        two_sum(q, v, sum, err);
+        if (err != 0.) {
+            h.push_back(err);
+        }
+        q = sum;
+    }
+    if (q != 0. || h.empty()) {
+        h.push_back(q);
+    }
+    return h;
+}
+
+inline Expansion sum(const Expansion &e, const Expansion &f) {
+    Expansion h = e;
+    for (double v : f) {
+        h = grow(h, v);
+    }
+    return h;
+}
+
+// 展开乘以一个浮点数（Scale-Expansion），乘积的误差由 `std::fma` 精确得到
+inline Expansion scale(const Expansion &e, double b) {
+    Expansion h;
+    for (double v : e) {
+        double product = v * b, err = std::fma(v, b, -product);
+        h = grow(grow(h, err), product);
+    }
+    return h.empty() ? Expansion{0.} : h;
+}
+
+inline Expansion product(const Expansion &e, const Expansion &f) {
+    Expansion h{0.};
+    for (double v : f) {
+        h = sum(h, scale(e, v));
+    }
+    return h;
+}
+
+inline Expansion negate(Expansion e) {
+    for (double &v : e) {
+        v = -v;
+    }
+    return e;
+}
+
+inline int sign(const Expansion &e) {
+    for (size_t i = e.size(); i-- > 0;) {
+        if (e[i] != 0.) {
+            return e[i] > 0. ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static constexpr double kEpsilon = std::numeric_limits<double>::epsilon() / 2.;
+static constexpr double kOrientBound = (3. + 16. * kEpsilon) * kEpsilon;
+static constexpr double kIncircleBound = (10. + 96. * kEpsilon) * kEpsilon;
+
+struct XY {
+    double x, y;
+};
+
+// c 在 a→b 左侧时为正，共线时为 0
+inline int orient(const XY &a, const XY &b, const XY &c) {
+    double left = (a.x - c.x) * (b.y - c.y), right = (a.y - c.y) * (b.x - c.x);
+    double det = left - right;
+    if (std::abs(det) > kOrientBound * (std::abs(left) + std::abs(right))) {
+        return det > 0. ? 1 : -1;
+    }
+    auto exact = sum(product(two_diff(b.x, a.x), two_diff(c.y, a.y)),
+                     negate(product(two_diff(b.y, a.y), two_diff(c.x, a.x))));
+    return sign(exact);
+}
+
+// a、b、c 为逆时针方向时，d 在外接圆内为正，在圆上为 0
+inline int incircle(const XY &a, const XY &b, const XY &c, const XY &d) {
+    double adx = a.x - d.x, ady = a.y - d.y, bdx = b.x - d.x, bdy = b.y - d.y, cdx = c.x - d.x, cdy = c.y - d.y;
+    double bc = bdx * cdy, cb = cdx * bdy, ca = cdx * ady, ac = adx * cdy, ab = adx * bdy, ba = bdx * ady;
+    double alift = adx * adx + ady * ady, blift = bdx * bdx + bdy * bdy, clift = cdx * cdx + cdy * cdy;
+    double det = alift * (bc - cb) + blift * (ca - ac) + clift * (ab - ba);
+    double permanent = (std::abs(bc) + std::abs(cb)) * alift + (std::abs(ca) + std::abs(ac)) * blift +
+                       (std::abs(ab) + std::abs(ba)) * clift;
+    if (std::abs(det) > kIncircleBound * permanent) {
+        return det > 0. ? 1 : -1;
+    }
+    Expansion ex = two_diff(a.x, d.x), ey = two_diff(a.y, d.y), fx = two_diff(b.x, d.x), fy = two_diff(b.y, d.y);
+    Expansion gx = two_diff(c.x, d.x), gy = two_diff(c.y, d.y);
+    auto lift = [](const Expansion &x, const Expansion &y) { return sum(product(x, x), product(y, y)); };
+    auto cross = [](const Expansion &x1, const Expansion &y1, const Expansion &x2, const Expansion &y2) {
+        return sum(product(x1, y2), negate(product(y1, x2)));
+    };
+    auto exact = sum(sum(product(lift(ex, ey), cross(fx, fy, gx, gy)), product(lift(fx, fy), cross(gx, gy, ex, ey))),
+                     product(lift(gx, gy), cross(ex, ey, fx, fy)));
+    return sign(exact);
+}
+
+// (x, y) 在 2^16 × 2^16 网格上的希尔伯特曲线序号
+inline uint32_t hilbert_index(uint32_t x, uint32_t y) {
+    constexpr uint32_t kSide = 1u << 16;
+    uint32_t d = 0;
+    for (uint32_t s = kSide / 2; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = kSide - 1 - x;
+                y = kSide - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/**
+ * @brief 带“无穷远点”的 Bowyer–Watson 增量构造。
+ *
+ * 每条凸包边与无穷远点组成一个虚拟三角形，点在凸包之外时与可见的凸包边的虚拟三角形冲突，不需要外包的超级
+ * 三角形，凸包附近的结果也是精确的 Delaunay 三角剖分。点按希尔伯特曲线的顺序插入，从上一次插入的三角形出发
+ * 沿直线行走定位，期望的行走距离为常数，总代价为 O(n log n)（排序）。点按插入顺序重新存放，相邻插入的点与新建的
+ * 三角形在内存中也相邻。重复的点只插入一次。
+ */
+class Builder {
+public:
+    explicit Builder(const std::vector<XY> &points) : infinite_(static_cast<uint32_t>(points.size())) {
+        sort(points);
+    }
+
+    Triangulation build() {
+        Triangulation result;
+        if (!initialize()) {
+            return result;
+        }
+        start_of_.assign(points_.size() + 1, Triangulation::kNone);
+        end_of_.assign(points_.size() + 1, Triangulation::kNone);
+        for (uint32_t v = 0; v < points_.size(); ++v) {
+            if (v != initial_[0] && v != initial_[1] && v != initial_[2]) {
+                insert(v);
+            }
+        }
+
+        // 只输出有限三角形，虚拟三角形的相邻关系记为 `kNone`
+        std::vector<uint32_t> remap(triangles_.size(), Triangulation::kNone);
+        for (uint32_t t = 0; t < triangles_.size(); ++t) {
+            if (!ghost(t)) {
+                remap[t] = static_cast<uint32_t>(result.triangles.size());
+                const auto &v = triangles_[t].v;
+                result.triangles.push_back({ids_[v[0]], ids_[v[1]], ids_[v[2]]});
+            }
+        }
+        for (uint32_t t = 0; t < triangles_.size(); ++t) {
+            if (remap[t] != Triangulation::kNone) {
+                const auto &n = triangles_[t].n;
+                result.neighbors.push_back({remap[n[0]], remap[n[1]], remap[n[2]]});
+            }
+        }
+        return result;
+    }
+
+private:
+    struct Triangle {
+        std::array<uint32_t, 3> v;  // 逆时针方向的顶点，虚拟三角形含有 `infinite_`
+        std::array<uint32_t, 3> n;  // 与第 i 个顶点相对的边的相邻三角形
+    };
+
+    // 冲突区域的一条边界边：u→w 为冲突三角形中的边，`outside` 为边外的非冲突三角形，其第 `slot` 个相邻三角形
+    // 指向冲突三角形
+    struct Boundary {
+        uint32_t u, w, outside, slot;
+    };
+
+    // 按希尔伯特曲线排序后存放到 `points_`，`ids_` 为在输入中的序号；曲线序号相同的点保持输入中的顺序。曲线序号为
+    // 32 位，使用两趟 16 位的基数排序
+    void sort(const std::vector<XY> &points) {
+        double min_x = std::numeric_limits<double>::infinity(), min_y = min_x, max_x = -min_x, max_y = -min_x;
+        for (const auto &p : points) {
+            min_x = std::min(min_x, p.x);
+            min_y = std::min(min_y, p.y);
+            max_x = std::max(max_x, p.x);
+            max_y = std::max(max_y, p.y);
+        }
+        double sx = max_x > min_x ? 65535. / (max_x - min_x) : 0., sy = max_y > min_y ? 65535. / (max_y - min_y) : 0.;
+        std::vector<uint64_t> keys(points.size());
+        for (uint32_t i = 0; i < points.size(); ++i) {
+            auto x = static_cast<uint32_t>((points[i].x - min_x) * sx);
+            auto y = static_cast<uint32_t>((points[i].y - min_y) * sy);
+            keys[i] = static_cast<uint64_t>(hilbert_index(x, y)) << 32 | i;
+        }
+        std::vector<uint64_t> buffer(keys.size());
+        for (int shift = 32; shift < 64; shift += 16) {
+            std::vector<size_t> offsets((1 << 16) + 1, 0);
+            for (uint64_t key : keys) {
+                ++offsets[((key >> shift) & 0xffff) + 1];
+            }
+            for (size_t i = 1; i < offsets.size(); ++i) {
+                offsets[i] += offsets[i - 1];
+            }
+            for (uint64_t key : keys) {
+                buffer[offsets[(key >> shift) & 0xffff]++] = key;
+            }
+            keys.swap(buffer);
+        }
+        ids_.resize(points.size());
+        points_.resize(points.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            ids_[i] = static_cast<uint32_t>(keys[i]);
+            points_[i] = points[ids_[i]];
+        }
+    }
+
+    bool same(uint32_t a, uint32_t b) const { return points_[a].x == points_[b].x && points_[a].y == points_[b].y; }
+    bool ghost(uint32_t t) const {
+        const auto &v = triangles_[t].v;
+        return v[0] == infinite_ || v[1] == infinite_ || v[2] == infinite_;
+    }
+
+    // 以前三个不共线的点建立第一个三角形及其三个虚拟三角形，所有点共线时返回 false
+    bool initialize() {
+        if (points_.size() < 3) {
+            return false;
+        }
+        uint32_t a = 0, b = Triangulation::kNone, c = Triangulation::kNone;
+        for (uint32_t v = 1; v < points_.size(); ++v) {
+            if (b == Triangulation::kNone) {
+                b = same(a, v) ? b : v;
+            } else if (orient(points_[a], points_[b], points_[v]) != 0) {
+                c = v;
+                break;
+            }
+        }
+        if (c == Triangulation::kNone) {
+            return false;
+        }
+        if (orient(points_[a], points_[b], points_[c]) < 0) {
+            std::swap(b, c);
+        }
+        initial_ = {a, b, c};
+        triangles_.push_back({{a, b, c}, {1, 2, 3}});
+        // 第 i 个虚拟三角形位于第一个三角形中与顶点 i 相对的边之外
+        for (uint32_t i = 0; i < 3; ++i) {
+            uint32_t x = initial_[(i + 2) % 3], y = initial_[(i + 1) % 3];
+            // (x, y, ∞)：与 x 相对的边 (y, ∞) 属于以 y 为第一个顶点的虚拟三角形
+            triangles_.push_back({{x, y, infinite_}, {1 + (i + 2) % 3, 1 + (i + 1) % 3, 0}});
+        }
+        triangles_.reserve(2 * points_.size() + 2);  // 三角形（含虚拟三角形）的个数为 2n - 2
+        mark_.assign(triangles_.size(), 0);
+        mark_.reserve(triangles_.capacity());
+        last_ = 0;
+        return true;
+    }
+
+    // p 是否在三角形 t 的外接圆内（虚拟三角形为 p 位于凸包边外侧，或在凸包边的内部）
+    bool conflict(uint32_t t, const XY &p) const {
+        const auto &v = triangles_[t].v;
+        for (int i = 0; i < 3; ++i) {
+            if (v[i] == infinite_) {
+                const XY &a = points_[v[(i + 1) % 3]], &b = points_[v[(i + 2) % 3]];
+                int o = orient(a, b, p);
+                if (o != 0) {
+                    return o > 0;
+                }
+                return a.x != b.x ? (p.x > std::min(a.x, b.x) && p.x < std::max(a.x, b.x))
+                                  : (p.y > std::min(a.y, b.y) && p.y < std::max(a.y, b.y));
+            }
+        }
+        return incircle(points_[v[0]], points_[v[1]], points_[v[2]], p) > 0;
+    }
+
+    // 从上一次插入的三角形出发行走，返回与 p 冲突的一个三角形；p 与已有顶点重合时返回 `kNone`
+    uint32_t locate(const XY &p) {
+        uint32_t t = last_;
+        if (ghost(t)) {
+            const auto &v = triangles_[t].v;
+            t = triangles_[t].n[v[0] == infinite_ ? 0 : (v[1] == infinite_ ? 1 : 2)];
+        }
+        for (;;) {
+            const auto &tri = triangles_[t];
+            if (ghost(t)) {
+                return t;
+            }
+            bool moved = false;
+            for (uint32_t k = 0; k < 3 && !moved; ++k) {
+                uint32_t i = (k + walk_) % 3;  // 轮换起始边，避免在退化情形下循环
+                if (orient(points_[tri.v[(i + 1) % 3]], points_[tri.v[(i + 2) % 3]], p) < 0) {
+                    t = tri.n[i];
+                    moved = true;
+                }
+            }
+            ++walk_;
+            if (!moved) {
+                for (uint32_t v : tri.v) {
+                    if (points_[v].x == p.x && points_[v].y == p.y) {
+                        return Triangulation::kNone;
+                    }
+                }
+                return t;
+            }
+        }
+    }
+
+    void insert(uint32_t q) {
+        const XY &p = points_[q];
+        uint32_t first = locate(p);
+        if (first == Triangulation::kNone) {
+            return;
+        }
+        // 广度优先搜索冲突区域，`mark_` 为 2 * stamp 表示冲突，2 * stamp + 1 表示已检查且不冲突
+        ++stamp_;
+        uint64_t in = 2 * stamp_, out = 2 * stamp_ + 1;
+        conflicts_.clear();
+        boundary_.clear();
+        conflicts_.push_back(first);
+        mark_[first] = in;
+        for (size_t k = 0; k < conflicts_.size(); ++k) {
+            uint32_t t = conflicts_[k];
+            for (uint32_t i = 0; i < 3; ++i) {
+                uint32_t nb = triangles_[t].n[i];
+                if (mark_[nb] == in) {
+                    continue;
+                }
+                if (mark_[nb] != out && conflict(nb, p)) {
+                    mark_[nb] = in;
+                    conflicts_.push_back(nb);
+                    continue;
+                }
+                mark_[nb] = out;
+                const auto &n = triangles_[nb].n;
+                uint32_t slot = n[0] == t ? 0 : (n[1] == t ? 1 : 2);
+                boundary_.push_back({triangles_[t].v[(i + 1) % 3], triangles_[t].v[(i + 2) % 3], nb, slot});
+            }
+        }
+
+        // 冲突区域关于 p 是星形的，以每条边界边与 p 组成新的三角形；边界边比冲突三角形多 2 条，先复用冲突三角形的
+        // 位置
+        for (size_t k = 0; k < boundary_.size(); ++k) {
+            const auto &b = boundary_[k];
+            uint32_t t;
+            if (k < conflicts_.size()) {
+                t = conflicts_[k];
+            } else {
+                t = static_cast<uint32_t>(triangles_.size());
+                triangles_.emplace_back();
+                mark_.push_back(0);
+            }
+            triangles_[t] = {{b.u, b.w, q}, {Triangulation::kNone, Triangulation::kNone, b.outside}};
+            triangles_[b.outside].n[b.slot] = t;
+            start_of_[b.u] = t;
+            end_of_[b.w] = t;
+            last_ = t;
+        }
+        for (const auto &b : boundary_) {
+            uint32_t t = start_of_[b.u];
+            triangles_[t].n[0] = start_of_[b.w];  // 边 (w, q)
+            triangles_[t].n[1] = end_of_[b.u];    // 边 (q, u)
+        }
+    }
+
+    std::vector<XY> points_;
+    std::vector<uint32_t> ids_;
+    uint32_t infinite_;
+    std::array<uint32_t, 3> initial_{};
+    std::vector<Triangle> triangles_;
+    std::vector<uint64_t> mark_;
+    uint64_t stamp_ = 0;
+    uint32_t last_ = 0, walk_ = 0;
+    std::vector<uint32_t> conflicts_, start_of_, end_of_;
+    std::vector<Boundary> boundary_;
+};
+
+// 凸多边形被半平面 (x - m)·d <= 0 裁剪（Sutherland–Hodgman）
+inline void clip(std::vector<XY> &polygon, const XY &m, const XY &d, std::vector<XY> &buffer) {
+    buffer.clear();
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        const XY &a = polygon[i], &b = polygon[(i + 1) % polygon.size()];
+        double sa = (a.x - m.x) * d.x + (a.y - m.y) * d.y, sb = (b.x - m.x) * d.x + (b.y - m.y) * d.y;
+        if (sa <= 0.) {
+            buffer.push_back(a);
+        }
+        if ((sa < 0. && sb > 0.) || (sa > 0. && sb < 0.)) {
+            double t = sa / (sa - sb);
+            buffer.push_back({a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t});
+        }
+    }
+    polygon.swap(buffer);
+}
+
+template <typename Point>
+std::vector<XY> project(const std::vector<Point> &points, const LocalFrame<Point> &frame) {
+    std::vector<XY> xy(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        auto p = frame.to_local(points[i]);
+        xy[i] = {p.x, p.y};
+    }
+    return xy;
+}
+
+}  // namespace delaunay_detail
+
+/**
+ * @brief 点集的 Delaunay 三角剖分。
+ *
+ * 使用带无穷远点的 Bowyer–Watson 增量算法，点按希尔伯特曲线排序后插入；方向与外接圆判断先用浮点数计算并
+ * 估计误差，无法确定符号时改用浮点展开精确计算，共圆、共线与重复的点都能得到正确的结果。地理坐标在
+ * `LocalFrame` 的局部平面（米）中计算，适用于城市范围内的点集。
+ *
+ * @param [in] points 点集，重复的点只有第一个出现在三角形中。
+ * @return Triangulation 三角剖分，所有点共线或少于 3 个不同的点时为空。
+ */
+template <typename Point>
+Triangulation delaunay_triangulation(const std::vector<Point> &points) {
+    LocalFrame<Point> frame(points);
+    return delaunay_detail::Builder(delaunay_detail::project(points, frame)).build();
+}
+
+/**
+ * @brief 点集的 Voronoi 图，每个单元裁剪到 `box` 内。
+ *
+ * 点 i 的 Voronoi 单元是它与每个 Delaunay 相邻点的垂直平分线所确定的半平面之交，从 `box` 出发依次用这些
+ * 半平面裁剪即得到裁剪后的单元，不需要处理凸包上无界的单元。所有点共线时相邻点为直线上前后相邻的点。
+ *
+ * @param [in] points 点集（例如站点），重复的点得到相同的单元。
+ * @param [in] box 裁剪范围，地理坐标下经度范围应与点集在反子午线的同一侧展开。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<Polygon<Point>> 与 `points` 一一对应的单元，与 `box` 不相交时为空多边形。
+ */
+template <typename Point>
+std::vector<Polygon<Point>> voronoi_cells(const std::vector<Point> &points, const Box<Point> &box,
+                                          ThreadPool *pool = nullptr) {
+    using delaunay_detail::XY;
+    LocalFrame<Point> frame(points);
+    auto xy = delaunay_detail::project(points, frame);
+    size_t n = points.size();
+
+    // 每个点的 Delaunay 相邻点，重复的点映射到第一个出现的点
+    std::vector<uint32_t> representative(n);
+    std::vector<std::vector<uint32_t>> adjacent(n);
+    auto triangulation = delaunay_detail::Builder(xy).build();
+    for (const auto &t : triangulation.triangles) {
+        for (int i = 0; i < 3; ++i) {
+            adjacent[t[i]].push_back(t[(i + 1) % 3]);
+            adjacent[t[(i + 1) % 3]].push_back(t[i]);
+        }
+    }
+    std::vector<uint32_t> order(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return xy[a].x < xy[b].x || (xy[a].x == xy[b].x && xy[a].y < xy[b].y);
+    });
+    for (size_t k = 0; k < n; ++k) {
+        bool duplicate = k > 0 && xy[order[k]].x == xy[order[k - 1]].x && xy[order[k]].y == xy[order[k - 1]].y;
+        representative[order[k]] = duplicate ? representative[order[k - 1]] : order[k];
+    }
+    if (triangulation.triangles.empty()) {
+        uint32_t prev = Triangulation::kNone;
+        for (uint32_t i : order) {
+            if (representative[i] == i) {
+                if (prev != Triangulation::kNone) {
+                    adjacent[i].push_back(prev);
+                    adjacent[prev].push_back(i);
+                }
+                prev = i;
+            }
+        }
+    }
+
+    auto lo = frame.to_local(box.min_corner(), 0), hi = frame.to_local(box.max_corner(), 0);
+    if constexpr (std::is_same_v<Point, PointGeo2>) {
+        if (hi.x < lo.x) {
+            hi.x += frame.scale({360., 0., 0}).x;
+        }
+    }
+    std::vector<Polygon<Point>> cells(n);
+    parallel_for(
+        pool, n,
+        [&](size_t begin, size_t end) {
+            std::vector<XY> polygon, buffer;
+            for (size_t i = begin; i < end; ++i) {
+                if (representative[i] != i) {
+                    continue;
+                }
+                polygon = {{lo.x, lo.y}, {hi.x, lo.y}, {hi.x, hi.y}, {lo.x, hi.y}};
+                std::sort(adjacent[i].begin(), adjacent[i].end());
+                adjacent[i].erase(std::unique(adjacent[i].begin(), adjacent[i].end()), adjacent[i].end());
+                for (uint32_t j = 0; j < adjacent[i].size() && !polygon.empty(); ++j) {
+                    const XY &a = xy[i], &b = xy[adjacent[i][j]];
+                    delaunay_detail::clip(polygon, {(a.x + b.x) * 0.5, (a.y + b.y) * 0.5}, {b.x - a.x, b.y - a.y},
+                                          buffer);
+                }
+                cells[i] = make_polygon<Point>(
+                    polygon.size(), [&](size_t k) { return frame.unproject(polygon[k].x, polygon[k].y); });
+            }
+        },
+        64);
+    for (size_t i = 0; i < n; ++i) {
+        if (representative[i] != i) {
+            cells[i] = cells[representative[i]];
+        }
+    }
+    return cells;
+}
+
+}  // namespace simplegeom
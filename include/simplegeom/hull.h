@@ -0,0 +1,381 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+enum class HullAlgorithm {
+    kMonotoneChain,  // Andrew 单调链：先按坐标排序，大规模输入可以在线程池中并行排序
+    kQuickhull,      // 快速凸包：不排序，适合凸包顶点远少于输入点数的情形
+};
+
+// 最小外接圆，地理坐标下半径的单位为米
+template <typename Point>
+struct BoundingCircle {
+    Point center;
+    double radius = 0.;
+};
+
+namespace hull_detail {
+
+static constexpr size_t kParallelSortPoints = 65536;  // 超过该点数时并行排序
+
+// (a - o) × (b - o)，b 在 o→a 左侧时为正
+inline double cross(const LocalPoint &o, const LocalPoint &a, const LocalPoint &b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+inline bool less_xy(const LocalPoint &a, const LocalPoint &b) { return a.x < b.x || (a.x == b.x && a.y < b.y); }
+
+// 将点集划分为与线程数相同的几段并行排序，再逐层两两归并
+inline void parallel_sort(std::vector<LocalPoint> &points, ThreadPool *pool) {
+    size_t runs = pool == nullptr || points.size() < kParallelSortPoints ? 1 : pool->size();
+    if (runs < 2) {
+        std::sort(points.begin(), points.end(), less_xy);
+        return;
+    }
+    size_t n = points.size(), run = (n + runs - 1) / runs;
+    parallel_for(
+        pool, runs,
+        [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+                std::sort(points.begin() + std::min(n, r * run), points.begin() + std::min(n, (r + 1) * run), less_xy);
+            }
+        },
+        1);
+    for (size_t width = run; width < n; width *= 2) {
+        size_t pairs = (n + 2 * width - 1) / (2 * width);
+        parallel_for(
+            pool, pairs,
+            [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) {
+                    auto first = points.begin() + k * 2 * width;
+                    auto middle = points.begin() + std::min(n, k * 2 * width + width);
+                    auto last = points.begin() + std::min(n, (k + 1) * 2 * width);
+                    std::inplace_merge(first, middle, last, less_xy);
+                }
+            },
+            1);
+    }
+}
+
+// Andrew 单调链，`points` 应当已按坐标排序并去重；返回逆时针方向的凸包顶点（不含共线点，首尾不重复）
+inline std::vector<LocalPoint> monotone_chain(const std::vector<LocalPoint> &points) {
+    if (points.size() < 2) {
+        return points;
+    }
+    std::vector<LocalPoint> hull(points.size() * 2);
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i) {  // 下凸壳
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.) {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;) {  // 上凸壳
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.) {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+// 快速凸包的一侧：[first, last) 中的点都严格位于 p→q 右侧，按从 p 到 q 的顺序输出这一侧的凸包顶点。离 p→q
+// 最远的点不唯一时（它们共线且与 p→q 平行）取最靠近 p 的一个，保证它是凸包的顶点
+inline void quickhull_side(std::vector<LocalPoint>::iterator first, std::vector<LocalPoint>::iterator last,
+                           const LocalPoint &p, const LocalPoint &q, std::vector<LocalPoint> &hull) {
+    if (first == last) {
+        return;
+    }
+    double dx = q.x - p.x, dy = q.y - p.y;
+    auto farthest = std::min_element(first, last, [&](const LocalPoint &a, const LocalPoint &b) {
+        double ca = cross(p, q, a), cb = cross(p, q, b);
+        return ca < cb || (ca == cb && a.x * dx + a.y * dy < b.x * dx + b.y * dy);
+    });
+    LocalPoint c = *farthest;
+    auto middle = std::partition(first, last, [&](const LocalPoint &a) { return cross(p, c, a) < 0.; });
+    auto end = std::partition(middle, last, [&](const LocalPoint &a) { return cross(c, q, a) < 0.; });
+    quickhull_side(first, middle, p, c, hull);
+    hull.push_back(c);
+    quickhull_side(middle, end, c, q, hull);
+}
+
+// 快速凸包，返回逆时针方向的凸包顶点（不含共线点，首尾不重复）
+inline std::vector<LocalPoint> quickhull(std::vector<LocalPoint> points) {
+    std::vector<LocalPoint> hull;
+    if (points.empty()) {
+        return hull;
+    }
+    auto [left, right] = std::minmax_element(points.begin(), points.end(), less_xy);
+    LocalPoint a = *left, b = *right;
+    hull.push_back(a);
+    if (a.x == b.x && a.y == b.y) {
+        return hull;
+    }
+    auto middle =
+        std::partition(points.begin(), points.end(), [&](const LocalPoint &p) { return cross(a, b, p) < 0.; });
+    auto end = std::partition(middle, points.end(), [&](const LocalPoint &p) { return cross(b, a, p) < 0.; });
+    quickhull_side(points.begin(), middle, a, b, hull);
+    hull.push_back(b);
+    quickhull_side(middle, end, b, a, hull);
+    return hull;
+}
+
+// Akl–Toussaint 预筛选：删除严格位于四个极值点（x、y 的最小与最大）围成的四边形内部的点，它们不可能是凸包
+// 顶点。均匀或正态分布的点集通常只剩下很少的点需要排序
+inline void discard_interior(std::vector<LocalPoint> &points) {
+    if (points.size() < 16) {
+        return;
+    }
+    LocalPoint quad[4] = {points[0], points[0], points[0], points[0]};  // 逆时针：最左、最下、最右、最上
+    for (const auto &p : points) {
+        quad[0] = p.x < quad[0].x ? p : quad[0];
+        quad[1] = p.y < quad[1].y ? p : quad[1];
+        quad[2] = p.x > quad[2].x ? p : quad[2];
+        quad[3] = p.y > quad[3].y ? p : quad[3];
+    }
+    points.erase(std::remove_if(points.begin(), points.end(),
+                                [&](const LocalPoint &p) {
+                                    return cross(quad[0], quad[1], p) > 0. && cross(quad[1], quad[2], p) > 0. &&
+                                           cross(quad[2], quad[3], p) > 0. && cross(quad[3], quad[0], p) > 0.;
+                                }),
+                 points.end());
+}
+
+template <typename Point>
+std::vector<LocalPoint> planar_hull(const std::vector<Point> &points, const LocalFrame<Point> &frame,
+                                    HullAlgorithm algorithm, ThreadPool *pool) {
+    std::vector<LocalPoint> planar(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        planar[i] = frame.project(points[i], i);
+    }
+    if (algorithm == HullAlgorithm::kQuickhull) {
+        return quickhull(std::move(planar));
+    }
+    discard_interior(planar);
+    parallel_sort(planar, pool);
+    planar.erase(std::unique(planar.begin(), planar.end(),
+                             [](const LocalPoint &a, const LocalPoint &b) { return a.x == b.x && a.y == b.y; }),
+                 planar.end());
+    return monotone_chain(planar);
+}
+
+}  // namespace hull_detail
+
+/**
+ * @brief 点集的凸包。
+ *
+ * 凸包的顶点为输入中的原始点（坐标不经过投影换算），不包含共线点。点集少于 3 个不同的点时返回退化的环
+ * （1 个点或 1 条线段）。`kMonotoneChain` 在点数较多且提供线程池时并行排序，`kQuickhull` 总是在当前线程中计算。
+ *
+ * @tparam Point 二维点类型，`Point2` 或 `PointGeo2`。
+ * @param [in] points 点集，也可以是 `LineString<Point>`，例如轨迹的全部点。
+ * @param [in] algorithm 凸包算法。
+ * @param [in] pool 用于并行排序的线程池，可以为空。
+ * @return Polygon<Point> 闭合的凸包多边形，点集为空时为空多边形。
+ */
+template <typename Point>
+Polygon<Point> convex_hull(const std::vector<Point> &points, HullAlgorithm algorithm = HullAlgorithm::kMonotoneChain,
+                           ThreadPool *pool = nullptr) {
+    LocalFrame<Point> frame(points);
+    auto hull = hull_detail::planar_hull(points, frame, algorithm, pool);
+    return make_polygon<Point>(hull.size(), [&](size_t i) { return points[hull[i].index]; });
+}
+
+/**
+ * @brief 面积最小的外接矩形（方向任意）。
+ *
+ * 最小外接矩形必有一条边与凸包的某条边共线，旋转卡壳依次以凸包的每条边为底边，同时单调推进沿底边方向最远、
+ * 最近以及离底边最远的三个顶点，总代价为凸包的 O(h)。地理坐标在局部平面中计算。凸包退化时返回凸包本身。
+ *
+ * @return Polygon<Point> 闭合的矩形，点集为空时为空多边形。
+ */
+template <typename Point>
+Polygon<Point> minimum_bounding_rectangle(const std::vector<Point> &points) {
+    LocalFrame<Point> frame(points);
+    auto hull = hull_detail::planar_hull(points, frame, HullAlgorithm::kMonotoneChain, nullptr);
+    size_t m = hull.size();
+    if (m < 3) {
+        return make_polygon<Point>(m, [&](size_t i) { return points[hull[i].index]; });
+    }
+    for (auto &p : hull) {
+        p = frame.scale(p);
+    }
+    auto at = [&](size_t i) -> const LocalPoint & { return hull[i % m]; };
+    auto dot = [](const LocalPoint &a, const LocalPoint &b, double ex, double ey) {
+        return (b.x - a.x) * ex + (b.y - a.y) * ey;
+    };
+
+    double best_area = std::numeric_limits<double>::infinity();
+    LocalPoint corners[4];
+    size_t right = 0, top = 0, left = 0;
+    for (size_t i = 0; i < m; ++i) {
+        double ex = at(i + 1).x - at(i).x, ey = at(i + 1).y - at(i).y, length = std::hypot(ex, ey);
+        ex /= length;
+        ey /= length;
+        // 底边的单位方向为 (ex, ey)，指向凸包内部的法向为 (-ey, ex)
+        right = std::max(right, i + 1);
+        while (dot(at(right), at(right + 1), ex, ey) > 0.) {
+            ++right;
+        }
+        top = std::max(top, right);
+        while (dot(at(top), at(top + 1), -ey, ex) > 0.) {
+            ++top;
+        }
+        left = std::max(left, top);
+        while (dot(at(left), at(left + 1), ex, ey) < 0.) {
+            ++left;
+        }
+        double lo = dot(at(i), at(left), ex, ey), hi = dot(at(i), at(right), ex, ey);
+        double height = dot(at(i), at(top), -ey, ex);
+        double area = (hi - lo) * height;
+        if (area < best_area) {
+            best_area = area;
+            const LocalPoint &o = at(i);
+            corners[0] = {o.x + ex * lo, o.y + ey * lo, 0};
+            corners[1] = {o.x + ex * hi, o.y + ey * hi, 0};
+            corners[2] = {corners[1].x - ey * height, corners[1].y + ex * height, 0};
+            corners[3] = {corners[0].x - ey * height, corners[0].y + ex * height, 0};
+        }
+    }
+    return make_polygon<Point>(4, [&](size_t i) { return frame.unproject(corners[i].x, corners[i].y); });
+}
+
+/**
+ * @brief 最小外接圆。
+ *
+ * 只在凸包顶点上运行随机增量算法（Welzl），期望代价为 O(h)，顶点顺序由固定种子打乱，结果可以复现。
+ * 地理坐标在局部平面中计算，半径的单位为米。
+ *
+ * @return BoundingCircle<Point> 外接圆，点集为空时半径为 0、圆心为默认构造的点。
+ */
+template <typename Point>
+BoundingCircle<Point> minimum_bounding_circle(const std::vector<Point> &points) {
+    BoundingCircle<Point> result;
+    LocalFrame<Point> frame(points);
+    auto hull = hull_detail::planar_hull(points, frame, HullAlgorithm::kMonotoneChain, nullptr);
+    if (hull.empty()) {
+        return result;
+    }
+    for (auto &p : hull) {
+        p = frame.scale(p);
+    }
+    std::mt19937 rng(hull.size());
+    std::shuffle(hull.begin(), hull.end(), rng);
+
+    double cx = hull[0].x, cy = hull[0].y, r = 0.;
+    auto outside = [&](const LocalPoint &p) { return std::hypot(p.x - cx, p.y - cy) > r * (1. + 1e-12); };
+    auto diameter = [&](const LocalPoint &a, const LocalPoint &b) {
+        cx = (a.x + b.x) * 0.5;
+        cy = (a.y + b.y) * 0.5;
+        r = std::hypot(a.x - cx, a.y - cy);
+    };
+    for (size_t i = 1; i < hull.size(); ++i) {
+        if (!outside(hull[i])) {
+            continue;
+        }
+        cx = hull[i].x;
+        cy = hull[i].y;
+        r = 0.;
+        for (size_t j = 0; j < i; ++j) {
+            if (!outside(hull[j])) {
+                continue;
+            }
+            diameter(hull[i], hull[j]);
+            for (size_t k = 0; k < j; ++k) {
+                if (!outside(hull[k])) {
+                    continue;
+                }
+                // 三点的外接圆，以 hull[i] 为原点计算
+                const LocalPoint &a = hull[i], &b = hull[j], &c = hull[k];
+                double bx = b.x - a.x, by = b.y - a.y, qx = c.x - a.x, qy = c.y - a.y;
+                double d = 2. * (bx * qy - by * qx);
+                if (d == 0.) {  // 凸包顶点不共线，仅在数值退化时出现
+                    continue;
+                }
+                double b2 = bx * bx + by * by, c2 = qx * qx + qy * qy;
+                double ux = (qy * b2 - by * c2) / d, uy = (bx * c2 - qx * b2) / d;
+                cx = a.x + ux;
+                cy = a.y + uy;
+                r = std::hypot(ux, uy);
+            }
+        }
+    }
+    result.center = frame.unproject(cx, cy);
+    result.radius = r;
+    return result;
+}
+
+/**
+ * @brief 批量计算多个点集的凸包，每个点集在单个线程中计算。
+ *
+ * @tparam Points 点集类型，`std::vector<Point>` 或 `LineString<Point>`。
+ * @param [in] sets 点集。
+ * @param [in] algorithm 凸包算法。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<Polygon<Point>> 与 `sets` 一一对应的凸包。
+ */
+template <typename Points>
+std::vector<Polygon<typename Points::value_type>> convex_hull_batch(
+    const std::vector<Points> &sets, HullAlgorithm algorithm = HullAlgorithm::kMonotoneChain,
+    ThreadPool *pool = nullptr) {
+    std::vector<Polygon<typename Points::value_type>> results(sets.size());
+    parallel_for(
+        pool, sets.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = simplegeom::convex_hull(sets[i], algorithm);
+            }
+        },
+        16);
+    return results;
+}
+
+/**
+ * @brief 批量计算多个点集的最小外接矩形。
+ */
+template <typename Points>
+std::vector<Polygon<typename Points::value_type>> minimum_bounding_rectangle_batch(const std::vector<Points> &sets,
+                                                                                   ThreadPool *pool = nullptr) {
+    std::vector<Polygon<typename Points::value_type>> results(sets.size());
+    parallel_for(
+        pool, sets.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = minimum_bounding_rectangle(sets[i]);
+            }
+        },
+        16);
+    return results;
+}
+
+/**
+ * @brief 批量计算多个点集的最小外接圆。
+ */
+template <typename Points>
+std::vector<BoundingCircle<typename Points::value_type>> minimum_bounding_circle_batch(
+    const std::vector<Points> &sets, ThreadPool *pool = nullptr) {
+    std::vector<BoundingCircle<typename Points::value_type>> results(sets.size());
+    parallel_for(
+        pool, sets.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = minimum_bounding_circle(sets[i]);
+            }
+        },
+        16);
+    return results;
+}
+
+}  // namespace simplegeom
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include "simplegeom/common.h"
 
@@ -68,4 +76,231 @@ std::string wkt_str(const Geometry<Point> &geometry) {
     return ss.str();
 }
 
+/**
+ * @brief 从 WKT（Well-Known Text）格式的字符串解析几何对象。
+ *
+ * 该函数是 `wkt_str` 的逆操作，依赖 Boost.Geometry 的 `bg::read_wkt` 完成解析。
+ *
+ * @tparam Geometry 几何对象的类型，例如 `Point2` 或 `LineString<PointGeo2>`。
+ * @param [in] wkt WKT 格式的字符串。
+ * @return Geometry 解析得到的几何对象。
+ *
+ * @note 字符串格式错误时会抛出 `bg::read_wkt_exception` 异常。
+ */
+template <typename Geometry>
+Geometry from_wkt(const std::string &wkt) {
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+    return geometry;
+}
+
+namespace io_detail {
+
+// WKB 字节流读取器，按几何对象头部声明的字节序解码数值
+class WkbReader {
+public:
+    WkbReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+    uint8_t byte() {
+        require(1);
+        return data_[offset_++];
+    }
+
+    uint32_t uint32() {
+        uint32_t value;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    double float64() {
+        double value;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    void set_little_endian(bool little_endian) { little_endian_ = little_endian; }
+    size_t offset() const { return offset_; }
+    size_t remaining() const { return size_ - offset_; }
+
+private:
+    void require(size_t n) const {
+        if (size_ - offset_ < n) {
+            throw std::runtime_error("invalid wkb: unexpected end of data");
+        }
+    }
+
+    void read(void *value, size_t n) {
+        require(n);
+        uint8_t bytes[8];
+        std::memcpy(bytes, data_ + offset_, n);
+        offset_ += n;
+        static const bool kHostLittleEndian = [] {
+            uint16_t probe = 1;
+            uint8_t first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }();
+        if (little_endian_ != kHostLittleEndian) {
+            std::reverse(bytes, bytes + n);
+        }
+        std::memcpy(value, bytes, n);
+    }
+
+    const uint8_t *data_;
+    size_t size_;
+    size_t offset_ = 0;
+    bool little_endian_ = true;
+};
+
+// 几何对象头部：字节序、类型以及每个坐标点的维数，同时支持 ISO WKB 与 PostGIS EWKB 的 Z/M/SRID 标记
+struct WkbHeader {
+    uint32_t type;
+    size_t coordinates;
+};
+
+inline WkbHeader read_wkb_header(WkbReader &reader) {
+    reader.set_little_endian(reader.byte() == 1);
+    uint32_t raw = reader.uint32();
+    bool has_z = (raw & 0x80000000u) != 0;
+    bool has_m = (raw & 0x40000000u) != 0;
+    if (raw & 0x20000000u) {
+        reader.uint32();  // SRID
+    }
+    uint32_t type = raw & 0x0fffffffu;
+    switch (type / 1000) {
+        case 1:
+            has_z = true;
+            break;
+        case 2:
+            has_m = true;
+            break;
+        case 3:
+            has_z = has_m = true;
+            break;
+        default:
+            break;
+    }
+    return WkbHeader{type % 1000, size_t(2) + has_z + has_m};
+}
+
+template <typename Point>
+Point read_wkb_point(WkbReader &reader, size_t coordinates) {
+    constexpr size_t dim = bg::dimension<Point>::value;
+    double values[4] = {0., 0., 0., 0.};
+    for (size_t i = 0; i < coordinates; ++i) {
+        values[i] = reader.float64();
+    }
+    Point point;
+    bg::set<0>(point, values[0]);
+    bg::set<1>(point, values[1]);
+    if constexpr (dim > 2) {
+        bg::set<2>(point, coordinates > 2 ? values[2] : 0.);
+    }
+    return point;
+}
+
+template <typename Range>
+void read_wkb_points(WkbReader &reader, size_t coordinates, Range &range) {
+    using Point = typename bg::point_type<Range>::type;
+    uint32_t count = reader.uint32();
+    // 点数来自输入数据，先与剩余字节数比较，避免按伪造的点数预留内存
+    if (count > reader.remaining() / (coordinates * sizeof(double))) {
+        throw std::runtime_error("invalid wkb: point count exceeds data size");
+    }
+    range.clear();
+    range.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        range.push_back(read_wkb_point<Point>(reader, coordinates));
+    }
+}
+
+}  // namespace io_detail
+
+/**
+ * @brief 从 WKB（Well-Known Binary）格式的字节流解析几何对象。
+ *
+ * 支持点（Point）、折线（LineString）和多边形（Polygon），兼容大小端字节序以及 ISO WKB 和 PostGIS EWKB 的
+ * Z/M/SRID 标记。多余的坐标维度（例如二维点读取带 Z 值的数据时的 Z 值，以及 M 值）会被忽略。
+ *
+ * @tparam Geometry 几何对象的类型，例如 `PointGeo2`、`LineString<PointGeo2>` 或 `Polygon<Point2>`。
+ * @param [in] data WKB 字节流的起始地址。
+ * @param [in] size 字节流的长度。
+ * @return Geometry 解析得到的几何对象。
+ *
+ * @note 数据不完整或几何类型与 `Geometry` 不一致时抛出 `std::runtime_error` 异常。
+ */
+template <typename Geometry>
+Geometry from_wkb(const uint8_t *data, size_t size) {
+    using Tag = typename bg::tag<Geometry>::type;
+    using Point = typename bg::point_type<Geometry>::type;
+
+    io_detail::WkbReader reader(data, size);
+    auto header = io_detail::read_wkb_header(reader);
+
+    Geometry geometry;
+    if constexpr (std::is_same_v<Tag, bg::point_tag>) {
+        if (header.type != 1) {
+            throw std::runtime_error("invalid wkb: expected point");
+        }
+        geometry = io_detail::read_wkb_point<Point>(reader, header.coordinates);
+    } else if constexpr (std::is_same_v<Tag, bg::linestring_tag>) {
+        if (header.type != 2) {
+            throw std::runtime_error("invalid wkb: expected linestring");
+        }
+        io_detail::read_wkb_points(reader, header.coordinates, geometry);
+    } else if constexpr (std::is_same_v<Tag, bg::polygon_tag>) {
+        if (header.type != 3) {
+            throw std::runtime_error("invalid wkb: expected polygon");
+        }
+        uint32_t rings = reader.uint32();
+        for (uint32_t i = 0; i < rings; ++i) {
+            if (i == 0) {
+                io_detail::read_wkb_points(reader, header.coordinates, geometry.outer());
+            } else {
+                geometry.inners().emplace_back();
+                io_detail::read_wkb_points(reader, header.coordinates, geometry.inners().back());
+            }
+        }
+    } else {
+        static_assert(std::is_same_v<Tag, bg::point_tag>, "Only support point, linestring and polygon");
+    }
+    return geometry;
+}
+
+/**
+ * @brief 从 WKB（Well-Known Binary）格式的字节流解析几何对象。
+ *
+ * @tparam Geometry 几何对象的类型。
+ * @param [in] wkb WKB 字节流。
+ * @return Geometry 解析得到的几何对象。
+ */
+template <typename Geometry>
+Geometry from_wkb(const std::vector<uint8_t> &wkb) {
+    return from_wkb<Geometry>(wkb.data(), wkb.size());
+}
+
+/**
+ * @brief 从文本文件中逐行读取 WKT 格式的几何对象，空行会被忽略。
+ *
+ * @tparam Geometry 几何对象的类型，例如 `LineString<PointGeo2>`。
+ * @param [in] path 文件路径。
+ * @return std::vector<Geometry> 按文件顺序排列的几何对象。
+ *
+ * @note 文件无法打开时抛出 `std::runtime_error` 异常。
+ */
+template <typename Geometry>
+std::vector<Geometry> read_wkt_file(const std::string &path) {
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    std::vector<Geometry> geometries;
+    for (std::string line; std::getline(input, line);) {
+        if (!line.empty()) {
+            geometries.push_back(from_wkt<Geometry>(line));
+        }
+    }
+    return geometries;
+}
+
 }  // namespace simplegeom
\ No newline at end of file
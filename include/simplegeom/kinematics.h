@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <boost/geometry/formulas/vincenty_inverse.hpp>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+#include "simplegeom/trajectory.h"
+
+namespace simplegeom {
+
+// 运动参数计算的选项
+struct KinematicsOptions {
+    double max_speed = 0.;    // 速度上限，超过该速度的孤立点视为离群点，0 表示不过滤
+    double max_hop = 10000.;  // 近似计算的最大间距，单位与 `distance` 相同，超过时改用精确的 `distance`
+};
+
+/**
+ * @brief 轨迹每个点的运动参数，按列存放。
+ *
+ * 第 i 个点的速度与航向由前一个有效点到该点的线段得到，加速度为相邻两个有效点的速度差除以时间差；
+ * 第一个有效点沿用第一段线段的速度与航向，加速度为 0。时间差为 0 时沿用前一个点的速度，加速度为 0；
+ * 未移动时沿用前一个点的航向。离群点的三个参数都是 NaN。
+ */
+struct TrajectoryKinematics {
+    std::vector<double> speed;         // 速度，单位为 `distance` 的单位每秒（地理坐标下为米/秒）
+    std::vector<double> heading;       // 航向（度），以正北（y 轴正方向）为 0，顺时针为正，范围 [0, 360)
+    std::vector<double> acceleration;  // 加速度，单位为速度的单位每秒
+    std::vector<uint8_t> outlier;      // 是否为离群点
+};
+
+namespace kinematics_detail {
+
+// 一段线段的长度与航向
+struct Hop {
+    double distance = 0.;
+    double heading = 0.;
+};
+
+static constexpr double kMaxConvergence = 0.002;  // 经度差（弧度）与纬度正弦之积的上限，超过时改用精确计算
+
+inline double to_heading(double radians) {
+    double deg = radians * 180. / M_PI;
+    return deg < 0. ? deg + 360. : (deg >= 360. ? deg - 360. : deg);
+}
+
+/**
+ * @brief 各点处每弧度纬度、每弧度经度对应的距离。
+ *
+ * 使用 WGS84 椭球的子午圈曲率半径 M 与卯酉圈曲率半径 N，两点之间的距离按两端的平均值在局部平面中计算。
+ * 局部平面忽略了经线的收敛，误差随经度差与纬度正弦之积增大，该值不超过 `kMaxConvergence` 时相对误差
+ * 在 1e-6 量级。每个点只计算一次三角函数，相邻线段共享端点的结果。
+ */
+struct GeoScales {
+    std::vector<double> meridian, parallel, sin_lat;
+
+    explicit GeoScales(const LineString<PointGeo2> &points)
+        : meridian(points.size()), parallel(points.size()), sin_lat(points.size()) {
+        static constexpr double kA = kWgs84SemiMajorAxis, kF = kWgs84Flattening, kE2 = kF * (2. - kF);
+        for (size_t i = 0; i < points.size(); ++i) {
+            double lat = bg::get<1>(points[i]) * M_PI / 180.;
+            double s = std::sin(lat), w2 = 1. - kE2 * s * s, w = std::sqrt(w2);
+            meridian[i] = kA * (1. - kE2) / (w2 * w);
+            parallel[i] = kA / w * std::sqrt(std::max(0., 1. - s * s));  // 纬度在 [-90, 90] 内，余弦非负
+            sin_lat[i] = std::abs(s);
+        }
+    }
+};
+
+// 精确的线段长度，航向取两端方位角的平均值，与近似计算中局部平面内的方向一致
+inline Hop exact_hop(const PointGeo2 &p1, const PointGeo2 &p2) {
+    static const bg::srs::spheroid<double> kSpheroid;
+    constexpr double kRad = M_PI / 180.;
+    auto r = bg::formula::vincenty_inverse<double, true, true, true>::apply(
+        bg::get<0>(p1) * kRad, bg::get<1>(p1) * kRad, bg::get<0>(p2) * kRad, bg::get<1>(p2) * kRad, kSpheroid);
+    double d = r.reverse_azimuth - r.azimuth;
+    d = d > M_PI ? d - 2 * M_PI : (d < -M_PI ? d + 2 * M_PI : d);
+    return {simplegeom::distance(p1, p2), to_heading(r.azimuth + d / 2)};
+}
+
+// 第 i 个点到第 j 个点的线段，与 `consecutive_hops` 的结果一致
+template <typename Point, typename Scales>
+Hop hop(const LineString<Point> &points, const Scales &scales, size_t i, size_t j, double max_hop) {
+    const auto &p1 = points[i], &p2 = points[j];
+    if constexpr (std::is_same_v<Point, PointGeo2>) {
+        constexpr double kRad = M_PI / 180.;
+        double dlon = wrap_lon(bg::get<0>(p2) - bg::get<0>(p1)) * kRad;
+        double dy = (scales.meridian[i] + scales.meridian[j]) * 0.5 * (bg::get<1>(p2) - bg::get<1>(p1)) * kRad;
+        double dx = (scales.parallel[i] + scales.parallel[j]) * 0.5 * dlon;
+        double d = std::sqrt(dx * dx + dy * dy);
+        if (d > max_hop || std::abs(dlon) * std::max(scales.sin_lat[i], scales.sin_lat[j]) > kMaxConvergence) {
+            return exact_hop(p1, p2);
+        }
+        return {d, to_heading(std::atan2(dx, dy))};
+    } else {
+        double dx = bg::get<0>(p2) - bg::get<0>(p1), dy = bg::get<1>(p2) - bg::get<1>(p1);
+        return {std::sqrt(dx * dx + dy * dy), to_heading(std::atan2(dx, dy))};
+    }
+}
+
+// 笛卡尔坐标不需要预先计算比例
+struct NoScales {
+    template <typename Points>
+    explicit NoScales(const Points &) {}
+};
+
+/**
+ * @brief 按列计算所有相邻两点之间的线段，第 k 段（第 k - 1 个点到第 k 个点）写入 `distance[k]` 与 `heading[k]`。
+ *
+ * 第一遍只有算术运算与开方，编译器可以将其向量化，东向分量暂存在 `heading` 中、北向分量暂存在 `scratch` 中；
+ * 第二遍计算航向；地理坐标下最后一遍将超出近似适用范围的线段改为精确计算。
+ */
+template <typename Point, typename Scales>
+void consecutive_hops(const LineString<Point> &points, const Scales &scales, double max_hop,
+                      std::vector<double> &distance, std::vector<double> &heading, std::vector<double> &scratch) {
+    constexpr double kRad = M_PI / 180.;
+    size_t n = points.size();
+    for (size_t k = 1; k < n; ++k) {
+        double dx = bg::get<0>(points[k]) - bg::get<0>(points[k - 1]);
+        double dy = bg::get<1>(points[k]) - bg::get<1>(points[k - 1]);
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            dx = (dx > 180. ? dx - 360. : (dx < -180. ? dx + 360. : dx)) * kRad;
+            dx *= (scales.parallel[k - 1] + scales.parallel[k]) * 0.5;
+            dy *= (scales.meridian[k - 1] + scales.meridian[k]) * 0.5 * kRad;
+        }
+        distance[k] = std::sqrt(dx * dx + dy * dy);
+        heading[k] = dx;
+        scratch[k] = dy;
+    }
+    for (size_t k = 1; k < n; ++k) {
+        heading[k] = to_heading(std::atan2(heading[k], scratch[k]));
+    }
+    if constexpr (std::is_same_v<Point, PointGeo2>) {
+        for (size_t k = 1; k < n; ++k) {
+            double dlon = wrap_lon(bg::get<0>(points[k]) - bg::get<0>(points[k - 1])) * kRad;
+            if (distance[k] > max_hop ||
+                std::abs(dlon) * std::max(scales.sin_lat[k - 1], scales.sin_lat[k]) > kMaxConvergence) {
+                auto h = exact_hop(points[k - 1], points[k]);
+                distance[k] = h.distance;
+                heading[k] = h.heading;
+            }
+        }
+    }
+}
+
+}  // namespace kinematics_detail
+
+/**
+ * @brief 沿轨迹一次遍历计算每个点的速度、航向与加速度。
+ *
+ * 地理坐标下相邻点的距离与航向使用局部平面近似：每个点预先计算一次椭球曲率半径，之后每段线段只需要一次开方
+ * 与一次 `atan2`，比逐段调用 Vincenty 公式快得多；间距超过 `max_hop` 或高纬度地区经度差较大的线段改用精确计算。
+ * 相邻点之间的线段先按列批量计算，跳过离群点时才单独计算不相邻两点之间的线段。
+ *
+ * `max_speed` 大于 0 时过滤离群点：一个点从前一个有效点到达该点、以及从该点到达下一个点的速度都超过
+ * `max_speed` 时（首尾两点只看存在的一侧），该点为离群点，不参与后续点的计算。这一规则只剔除孤立的跳点，
+ * 轨迹整体平移（如重新定位）之后的点仍然有效。
+ *
+ * @tparam Point 二维点类型，`Point2` 或 `PointGeo2`。
+ * @param [in] line 轨迹，时间戳非递减。
+ * @param [in] options 计算选项。
+ * @return TrajectoryKinematics 与轨迹的点一一对应的运动参数。
+ */
+template <typename Point>
+TrajectoryKinematics compute_kinematics(const Trajectory<Point> &line, const KinematicsOptions &options = {}) {
+    using Scales =
+        std::conditional_t<std::is_same_v<Point, PointGeo2>, kinematics_detail::GeoScales, kinematics_detail::NoScales>;
+    using kinematics_detail::Hop;
+
+    size_t n = line.size();
+    TrajectoryKinematics result;
+    result.speed.assign(n, std::numeric_limits<double>::quiet_NaN());
+    result.heading.assign(n, std::numeric_limits<double>::quiet_NaN());
+    result.acceleration.assign(n, std::numeric_limits<double>::quiet_NaN());
+    result.outlier.assign(n, 0);
+    if (n == 0) {
+        return result;
+    }
+    Scales scales(line.points);
+    const auto &t = line.timestamps;
+    // 相邻点之间的线段暂存在 `speed` 与 `heading` 中，第 i 个点的结果写入前先读出第 i 段
+    kinematics_detail::consecutive_hops(line.points, scales, options.max_hop, result.speed, result.heading,
+                                        result.acceleration);
+    auto too_fast = [&](const Hop &h, size_t i, size_t j) {
+        return options.max_speed > 0. && h.distance > options.max_speed * (t[j] - t[i]);
+    };
+
+    size_t prev = n, first = n;  // 前一个有效点与第一个有效点，n 表示没有
+    for (size_t i = 0; i < n; ++i) {
+        Hop in;
+        if (prev + 1 == i) {
+            in = {result.speed[i], result.heading[i]};
+        } else if (prev != n) {
+            in = kinematics_detail::hop(line.points, scales, prev, i, options.max_hop);
+        }
+        if (options.max_speed > 0. && (prev != n || i + 1 < n)) {
+            Hop next;
+            if (i + 1 < n) {
+                next = {result.speed[i + 1], result.heading[i + 1]};
+            }
+            bool bad_in = prev == n || too_fast(in, prev, i);
+            bool bad_out = i + 1 == n || too_fast(next, i, i + 1);
+            if (bad_in && bad_out) {
+                result.speed[i] = result.heading[i] = result.acceleration[i] = std::numeric_limits<double>::quiet_NaN();
+                result.outlier[i] = 1;
+                continue;
+            }
+        }
+
+        if (prev == n) {
+            result.speed[i] = 0.;
+            result.heading[i] = 0.;
+            result.acceleration[i] = 0.;
+            first = i;
+        } else {
+            double dt = t[i] - t[prev];
+            result.speed[i] = dt > 0. ? in.distance / dt : result.speed[prev];
+            result.heading[i] = in.distance > 0. ? in.heading : result.heading[prev];
+            if (prev == first) {
+                // 第一个有效点沿用第一段线段的速度与航向
+                result.speed[prev] = result.speed[i];
+                result.heading[prev] = result.heading[i];
+            }
+            result.acceleration[i] = dt > 0. ? (result.speed[i] - result.speed[prev]) / dt : 0.;
+        }
+        prev = i;
+    }
+    return result;
+}
+
+/**
+ * @brief 批量计算多条轨迹的运动参数。
+ *
+ * @param [in] lines 轨迹集合。
+ * @param [in] options 计算选项。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<TrajectoryKinematics> 与 `lines` 一一对应的运动参数。
+ */
+template <typename Point>
+std::vector<TrajectoryKinematics> compute_kinematics_batch(const std::vector<Trajectory<Point>> &lines,
+                                                           const KinematicsOptions &options = {},
+                                                           ThreadPool *pool = nullptr) {
+    std::vector<TrajectoryKinematics> results(lines.size());
+    parallel_for(
+        pool, lines.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = compute_kinematics(lines[i], options);
+            }
+        },
+        16);
+    return results;
+}
+
+}  // namespace simplegeom
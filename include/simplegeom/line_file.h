@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/view.h"
+
+namespace simplegeom {
+
+/**
+ * 折线文件的二进制格式（本机字节序），用于存放无法一次性载入内存的超长折线：
+ *
+ *   `LineFileHeader`
+ *   `count` 个顶点的交错坐标 `[x0, y0, x1, y1, ...]`
+ *   `chunk_count` 个 `LineChunkSummary`，位于 `summary_offset`
+ *
+ * 顶点按 `chunk_points` 个一组划分为块，第 k 块包含线段 [k * chunk_points, (k + 1) * chunk_points)，
+ * 即顶点 [k * chunk_points, (k + 1) * chunk_points]（与下一块共享一个顶点）。摘要记录每块的外包框以及
+ * 折线起点到该块第一个顶点的累积长度，投影时据此跳过与搜索框不相交的块。
+ */
+static constexpr uint32_t kLineFileMagic = 0x53474c31;  // "SGL1"
+
+struct LineFileHeader {
+    uint32_t magic = kLineFileMagic;
+    uint32_t dimension = 2;
+    uint64_t count = 0;           // 顶点数
+    uint64_t chunk_points = 0;    // 每块的线段数
+    uint64_t chunk_count = 0;     // 块数
+    uint64_t summary_offset = 0;  // 块摘要在文件中的偏移
+};
+
+struct LineChunkSummary {
+    double min_x, min_y, max_x, max_y;  // 块内顶点（含与下一块共享的顶点）的外包框
+    double start_length;                // 折线起点到块第一个顶点的累积长度
+};
+
+/**
+ * @brief 以流式方式写入折线文件，内存占用只与块大小有关。
+ *
+ * @tparam Point 二维点类型。
+ */
+template <typename Point>
+class LineFileWriter {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    static constexpr size_t kDefaultChunkPoints = 65536;
+
+    explicit LineFileWriter(const std::string &path, size_t chunk_points = kDefaultChunkPoints)
+        : out_(path, std::ios::binary | std::ios::trunc) {
+        if (!out_) {
+            throw std::runtime_error("failed to open line file: " + path);
+        }
+        if (chunk_points == 0) {
+            throw std::invalid_argument("chunk_points must be positive");
+        }
+        header_.chunk_points = chunk_points;
+        out_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+    }
+
+    ~LineFileWriter() {
+        if (!closed_) {
+            try {
+                close();
+            } catch (...) {
+            }
+        }
+    }
+
+    LineFileWriter(const LineFileWriter &) = delete;
+    LineFileWriter &operator=(const LineFileWriter &) = delete;
+
+    void append(const Point &point) {
+        double xy[2] = {bg::get<0>(point), bg::get<1>(point)};
+        out_.write(reinterpret_cast<const char *>(xy), sizeof(xy));
+        if (!chunk_.empty()) {
+            length_ += simplegeom::distance(chunk_.back(), point);
+        }
+        chunk_.push_back(point);
+        ++header_.count;
+        // 块内线段数达到上限时结束当前块，最后一个顶点作为下一块的第一个顶点
+        if (chunk_.size() == header_.chunk_points + 1) {
+            finish_chunk();
+            chunk_.erase(chunk_.begin(), chunk_.end() - 1);
+            chunk_start_ = length_;
+        }
+    }
+
+    template <typename Iterator>
+    void append(Iterator first, Iterator last) {
+        for (; first != last; ++first) {
+            append(*first);
+        }
+    }
+
+    // 写入块摘要并回填文件头，之后不能再追加顶点
+    void close() {
+        if (chunk_.size() > 1 || (header_.count == 1 && summaries_.empty())) {
+            finish_chunk();
+        }
+        header_.chunk_count = summaries_.size();
+        header_.summary_offset = sizeof(LineFileHeader) + header_.count * 2 * sizeof(double);
+        out_.write(reinterpret_cast<const char *>(summaries_.data()),
+                   static_cast<std::streamsize>(summaries_.size() * sizeof(LineChunkSummary)));
+        out_.seekp(0);
+        out_.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+        out_.close();
+        closed_ = true;
+        if (!out_) {
+            throw std::runtime_error("failed to write line file");
+        }
+    }
+
+private:
+    void finish_chunk() {
+        LineString<Point> line(chunk_.begin(), chunk_.end());
+        auto box = bg::return_envelope<Box<Point>>(line);
+        summaries_.push_back({bg::get<bg::min_corner, 0>(box), bg::get<bg::min_corner, 1>(box),
+                              bg::get<bg::max_corner, 0>(box), bg::get<bg::max_corner, 1>(box), chunk_start_});
+    }
+
+    std::ofstream out_;
+    LineFileHeader header_;
+    std::vector<Point> chunk_;
+    std::vector<LineChunkSummary> summaries_;
+    double length_ = 0.;
+    double chunk_start_ = 0.;
+    bool closed_ = false;
+};
+
+/**
+ * @brief 存放在文件中的超长折线，按块流式读取并计算投影。
+ *
+ * 打开时只读取文件头和块摘要。`project` 对一组查询点只遍历一遍文件：每个查询点维护与
+ * `project(point, first, last)` 相同的逐步缩小的搜索框，某一块的外包框与所有查询点当前的搜索框都不相交时
+ * 跳过该块，不读取其顶点。结果（包括累积投影距离的求和顺序）与将整条折线载入内存后逐点调用
+ * `distance(point, line, mode)` 完全一致。
+ *
+ * @tparam Point 二维点类型，需要与写入时一致。
+ */
+template <typename Point>
+class LineFile {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    explicit LineFile(const std::string &path) : in_(path, std::ios::binary) {
+        if (!in_ || !in_.read(reinterpret_cast<char *>(&header_), sizeof(header_)) ||
+            header_.magic != kLineFileMagic || header_.dimension != 2) {
+            throw std::runtime_error("invalid line file: " + path);
+        }
+        summaries_.resize(header_.chunk_count);
+        in_.seekg(static_cast<std::streamoff>(header_.summary_offset));
+        if (!in_.read(reinterpret_cast<char *>(summaries_.data()),
+                      static_cast<std::streamsize>(summaries_.size() * sizeof(LineChunkSummary)))) {
+            throw std::runtime_error("truncated line file: " + path);
+        }
+    }
+
+    size_t size() const { return header_.count; }
+    size_t chunk_count() const { return summaries_.size(); }
+    const std::vector<LineChunkSummary> &summaries() const { return summaries_; }
+
+    // 最近一次 `project` 读取的块数
+    size_t chunks_read() const { return chunks_read_; }
+
+    /**
+     * @brief 一次遍历计算多个点到折线的最短距离及投影距离。
+     *
+     * @param [in] points 查询点集。
+     * @param [in] mode 投影模式。
+     * @return std::vector<std::pair<double, double>> 与输入一一对应，含义与 `distance(point, line, mode)` 相同。
+     */
+    std::vector<std::pair<double, double>> project(const std::vector<Point> &points, ProjectionMode mode) {
+        static constexpr double kSearchBoxEdgeLength = 2000.;  // 与 `project(point, first, last)` 的初始搜索范围一致
+
+        std::vector<std::pair<double, double>> results(points.size(), std::make_pair(-1., 0.));
+        chunks_read_ = 0;
+        if (header_.count == 0) {
+            return results;
+        }
+        if (header_.count == 1) {
+            auto first = read_points(0, 1);
+            for (size_t q = 0; q < points.size(); ++q) {
+                results[q] = std::make_pair(simplegeom::distance(points[q], first[0]), 0.);
+            }
+            return results;
+        }
+
+        std::vector<QueryState> states(points.size());
+        for (auto &state : states) {
+            state.search_box_size = kSearchBoxEdgeLength;
+        }
+
+        std::vector<size_t> active;
+        for (size_t k = 0; k < summaries_.size(); ++k) {
+            active.clear();
+            for (size_t q = 0; q < points.size(); ++q) {
+                if (!can_skip(summaries_[k], create_box(points[q], states[q].search_box_size))) {
+                    active.push_back(q);
+                }
+            }
+            if (active.empty()) {
+                continue;
+            }
+
+            size_t begin = k * header_.chunk_points;
+            size_t end = std::min<size_t>(header_.count, begin + header_.chunk_points + 1);
+            auto coords = read_coords(begin, end - begin);
+            auto view = StridedPointView<Point>::interleaved(coords.data(), end - begin);
+            ++chunks_read_;
+
+            bool updated = false;
+            for (size_t q : active) {
+                auto &state = states[q];
+                Point a = view[0], b;
+                for (size_t i = 0; i + 1 < view.size(); ++i) {
+                    b = view[i + 1];
+                    bg::model::referring_segment<const Point> seg(a, b);
+                    if (bg::intersects(seg, create_box(points[q], state.search_box_size))) {
+                        if (auto d = bg::distance(points[q], seg) * 2; d < state.search_box_size) {
+                            state.search_box_size = d;
+                            state.index = begin + i;
+                            state.chunk = k;
+                            state.found_in_pass = true;
+                            updated = true;
+                            assign_segment(a, b, state.segment);
+                        }
+                    }
+                    a = b;
+                }
+            }
+
+            // 累积模式下，从块起点的累积长度开始逐段相加，求和顺序与内存中的实现一致
+            if (updated && mode == ProjectionMode::kAccumulate) {
+                size_t last = 0;
+                for (size_t q : active) {
+                    if (states[q].found_in_pass) {
+                        last = std::max(last, states[q].index - begin);
+                    }
+                }
+                std::vector<double> prefix(last + 1, summaries_[k].start_length);
+                for (size_t i = 0; i < last; ++i) {
+                    prefix[i + 1] = prefix[i] + simplegeom::distance(view[i], view[i + 1]);
+                }
+                for (size_t q : active) {
+                    if (states[q].found_in_pass) {
+                        states[q].prefix_length = prefix[states[q].index - begin];
+                    }
+                }
+            }
+            for (size_t q : active) {
+                states[q].found_in_pass = false;
+            }
+        }
+
+        // 没有线段与初始搜索框相交时，与内存中的实现一样取第一条线段
+        Segment<Point> first_segment;
+        bool first_loaded = false;
+        for (size_t q = 0; q < points.size(); ++q) {
+            auto &state = states[q];
+            if (state.chunk == kNoChunk) {
+                if (!first_loaded) {
+                    auto first = read_points(0, 2);
+                    assign_segment(first[0], first[1], first_segment);
+                    first_loaded = true;
+                }
+                state.segment = first_segment;
+                state.prefix_length = 0.;
+            }
+            double offset = simplegeom::distance(state.segment.first, closest_point(points[q], state.segment));
+            double project_distance = mode == ProjectionMode::kAccumulate ? state.prefix_length + offset : offset;
+            results[q] = std::make_pair(bg::distance(points[q], state.segment), project_distance);
+        }
+        return results;
+    }
+
+private:
+    static constexpr size_t kNoChunk = static_cast<size_t>(-1);
+
+    struct QueryState {
+        double search_box_size = 0.;
+        size_t index = 0;            // 当前最近线段的全局序号
+        size_t chunk = kNoChunk;     // 当前最近线段所在的块
+        bool found_in_pass = false;  // 当前块中是否更新了最近线段
+        double prefix_length = 0.;   // 折线起点到最近线段起点的累积长度
+        Segment<Point> segment;
+    };
+
+    /**
+     * @brief 判断块与搜索框是否必定不相交。地理坐标下搜索框跨越反子午线或触及极点、块的经度范围过宽
+     * （可能跨越反子午线）时保守地返回 false。
+     */
+    static bool can_skip(const LineChunkSummary &chunk, const Box<Point> &box) {
+        double min_x = bg::get<bg::min_corner, 0>(box), min_y = bg::get<bg::min_corner, 1>(box);
+        double max_x = bg::get<bg::max_corner, 0>(box), max_y = bg::get<bg::max_corner, 1>(box);
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            if (min_x < -180. || max_x > 180. || min_y <= -90. || max_y >= 90. || chunk.max_x - chunk.min_x >= 180. ||
+                chunk.min_x > chunk.max_x || chunk.min_x < -180. || chunk.max_x > 180. || chunk.min_y <= -90. ||
+                chunk.max_y >= 90.) {
+                return false;
+            }
+        }
+        return chunk.max_x < min_x || chunk.min_x > max_x || chunk.max_y < min_y || chunk.min_y > max_y;
+    }
+
+    std::vector<double> read_coords(size_t first, size_t count) {
+        std::vector<double> coords(count * 2);
+        in_.clear();
+        in_.seekg(static_cast<std::streamoff>(sizeof(LineFileHeader) + first * 2 * sizeof(double)));
+        if (!in_.read(reinterpret_cast<char *>(coords.data()),
+                      static_cast<std::streamsize>(coords.size() * sizeof(double)))) {
+            throw std::runtime_error("failed to read line file");
+        }
+        return coords;
+    }
+
+    std::vector<Point> read_points(size_t first, size_t count) {
+        auto coords = read_coords(first, count);
+        auto view = StridedPointView<Point>::interleaved(coords.data(), count);
+        return std::vector<Point>(view.begin(), view.end());
+    }
+
+    std::ifstream in_;
+    LineFileHeader header_;
+    std::vector<LineChunkSummary> summaries_;
+    size_t chunks_read_ = 0;
+};
+
+}  // namespace simplegeom
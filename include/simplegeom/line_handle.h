@@ -0,0 +1,209 @@
+#pragma once
+
+#include <boost/geometry/index/rtree.hpp>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+
+namespace simplegeom {
+namespace bgi = boost::geometry::index;
+
+/**
+ * @brief 不可变折线的引用计数句柄。
+ *
+ * 复制句柄只增加引用计数，多个流水线阶段可以共享同一份顶点而无需深拷贝。外包框、各顶点的累积长度以及
+ * 线段的 R 树索引在首次使用时计算并缓存在共享数据中，随句柄一起传递，可以在多个线程中同时读取。
+ * 修改通过 `modify` 进行：数据被其他句柄共享时先复制一份（写时复制），修改后缓存随之失效。
+ *
+ * @tparam Point 点的类型，通常为 `Point2` 或 `PointGeo2`。
+ */
+template <typename Point>
+class LineHandle {
+public:
+    using SegmentIndex = bgi::rtree<std::pair<Box<Point>, size_t>, bgi::quadratic<16>>;
+
+    static constexpr size_t kIndexMinSegments = 32;  // 线段数不少于该值时投影使用线段索引
+
+    LineHandle() : LineHandle(LineString<Point>()) {}
+    explicit LineHandle(LineString<Point> line) : data_(std::make_shared<Data>(std::move(line))) {}
+
+    const LineString<Point> &line() const { return data_->line; }
+    size_t size() const { return data_->line.size(); }
+    bool empty() const { return data_->line.empty(); }
+    const Point &operator[](size_t i) const { return data_->line[i]; }
+    typename LineString<Point>::const_iterator begin() const { return data_->line.begin(); }
+    typename LineString<Point>::const_iterator end() const { return data_->line.end(); }
+
+    // 共享同一份数据的句柄数量
+    long use_count() const { return data_.use_count(); }
+
+    /**
+     * @brief 折线的外包框，首次调用时计算。
+     */
+    const Box<Point> &envelope() const {
+        std::call_once(data_->envelope_once, [this] {
+            bg::assign_inverse(data_->envelope);
+            if (!data_->line.empty()) {
+                data_->envelope = bg::return_envelope<Box<Point>>(data_->line);
+            }
+        });
+        return data_->envelope;
+    }
+
+    /**
+     * @brief 各顶点的累积长度，第 i 个值为起点到第 i 个顶点沿线的距离，首次调用时计算。
+     */
+    const std::vector<double> &cumulative_lengths() const {
+        std::call_once(data_->lengths_once, [this] {
+            const auto &line = data_->line;
+            auto &lengths = data_->cumulative_lengths;
+            lengths.assign(line.size(), 0.);
+            for (size_t i = 1; i < line.size(); ++i) {
+                lengths[i] = lengths[i - 1] + simplegeom::distance(line[i - 1], line[i]);
+            }
+        });
+        return data_->cumulative_lengths;
+    }
+
+    // 折线总长度
+    double length() const { return empty() ? 0. : cumulative_lengths().back(); }
+
+    /**
+     * @brief 线段外包框的 R 树索引，值为线段外包框与线段序号，首次调用时以打包算法构建。
+     */
+    const SegmentIndex &index() const {
+        std::call_once(data_->index_once, [this] {
+            const auto &line = data_->line;
+            std::vector<std::pair<Box<Point>, size_t>> values;
+            values.reserve(line.size());
+            Segment<Point> seg;
+            for (size_t i = 0; i + 1 < line.size(); ++i) {
+                assign_segment(line[i], line[i + 1], seg);
+                values.emplace_back(bg::return_envelope<Box<Point>>(seg), i);
+            }
+            data_->index = SegmentIndex(values.begin(), values.end());
+        });
+        return data_->index;
+    }
+
+    /**
+     * @brief 修改折线顶点，修改完成后丢弃已缓存的派生数据。
+     *
+     * 提供强异常保证：`func` 在顶点的副本上修改，抛出异常时句柄保持原样。因此即使数据没有被其他句柄共享，
+     * 也会复制一次顶点。
+     *
+     * @param [in] func 修改函数，参数为 `LineString<Point> &`。
+     */
+    template <typename Func>
+    void modify(Func &&func) {
+        // 无论是否共享都换成新的数据块，旧数据块上的缓存与 once_flag 不能重置。不能把顶点移出旧数据块：
+        // `func` 可能在修改了一部分顶点之后抛出异常，此时无法恢复原来的顶点
+        LineString<Point> line = data_->line;
+        func(line);
+        data_ = std::make_shared<Data>(std::move(line));
+    }
+
+private:
+    struct Data {
+        explicit Data(LineString<Point> l) : line(std::move(l)) {}
+
+        LineString<Point> line;
+        Box<Point> envelope;
+        std::vector<double> cumulative_lengths;
+        SegmentIndex index;
+        std::once_flag envelope_once, lengths_once, index_once;
+    };
+
+    std::shared_ptr<Data> data_;
+};
+
+/**
+ * @brief 计算点在折线句柄上的投影结果。
+ *
+ * 线段数较多时通过缓存的线段索引筛选与搜索框相交的线段，只计算这些线段的距离。与
+ * `project(point, first, last)` 一样只接受距离小于搜索框边长一半的线段，搜索框角落里更远的线段不算找到；
+ * 没有这样的线段时退回第一条线段。线段数较少，或地理坐标下搜索框跨越反子午线、
+ * 触及极点（此时外包框不能可靠地表示线段的范围）时直接使用线性扫描。
+ *
+ * @tparam Point 点的类型。
+ * @param [in] point 要投影的点。
+ * @param [in] line 折线句柄。
+ * @return LineProjection 投影结果。如果折线少于两个点，则 `distance` 为 -1。
+ */
+template <typename Point>
+LineProjection project(const Point &point, const LineHandle<Point> &line) {
+    static constexpr double kSearchBoxEdgeLength = 2000.;  // 与 `project(point, first, last)` 的初始搜索范围一致
+
+    if (line.size() < LineHandle<Point>::kIndexMinSegments + 1) {
+        return project(point, line.begin(), line.end());
+    }
+    auto search_box = create_box(point, kSearchBoxEdgeLength);
+    if constexpr (std::is_same_v<Point, PointGeo2> || std::is_same_v<Point, PointGeo3>) {
+        if (bg::get<bg::min_corner, 0>(search_box) < -180. || bg::get<bg::max_corner, 0>(search_box) > 180. ||
+            bg::get<bg::min_corner, 1>(search_box) <= -90. || bg::get<bg::max_corner, 1>(search_box) >= 90.) {
+            return project(point, line.begin(), line.end());
+        }
+    }
+
+    size_t index = 0;
+    double best = -1.;
+    Segment<Point> seg;
+    const auto &segments = line.index();
+    for (auto it = segments.qbegin(bgi::intersects(search_box)); it != segments.qend(); ++it) {
+        assign_segment(line[it->second], line[it->second + 1], seg);
+        double d = bg::distance(point, seg);
+        // 距离相同时取序号较小的线段，与线性扫描的结果保持一致
+        if (best < 0. || d < best || (d == best && it->second < index)) {
+            best = d;
+            index = it->second;
+        }
+    }
+
+    // 线性扫描的搜索框从边长 2000 米开始收缩，只接受距离的两倍小于边长的线段
+    if (best * 2. >= kSearchBoxEdgeLength) {
+        best = -1.;
+        index = 0;
+    }
+
+    LineProjection projection;
+    assign_segment(line[index], line[index + 1], seg);
+    projection.distance = best < 0. ? bg::distance(point, seg) : best;
+    projection.segment_index = index;
+    projection.segment_offset = simplegeom::distance(seg.first, closest_point(point, seg));
+    return projection;
+}
+
+/**
+ * @brief 计算点到折线句柄的最短距离。
+ */
+template <typename Point>
+double distance(const Point &point, const LineHandle<Point> &line) {
+    return bg::distance(point, line.line());
+}
+
+/**
+ * @brief 计算点到折线句柄的最短距离及投影距离，语义与 `distance(point, LineString, mode)` 相同。
+ *
+ * 累积模式下的投影距离由缓存的累积长度直接得到，不再逐段累加。
+ */
+template <typename Point>
+std::pair<double, double> distance(const Point &point, const LineHandle<Point> &line, ProjectionMode mode) {
+    if (line.empty()) {
+        return std::make_pair(-1., 0.);
+    } else if (line.size() < 2) {
+        return std::make_pair(simplegeom::distance(point, line[0]), 0.);
+    }
+
+    auto projection = project(point, line);
+    double project_distance = projection.segment_offset;
+    if (mode == ProjectionMode::kAccumulate) {
+        project_distance += line.cumulative_lengths()[projection.segment_index];
+    }
+    return std::make_pair(projection.distance, project_distance);
+}
+
+}  // namespace simplegeom
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+
+namespace simplegeom {
+
+// 移动对象查询结果中的一项
+struct MovingObjectHit {
+    uint64_t id;
+    double distance;
+};
+
+/**
+ * @brief 支持高频原地更新的移动对象索引（例如实时车辆位置）。
+ *
+ * 坐标空间被划分为边长为 `cell_size` 的均匀网格，网格单元经哈希映射到固定数量的桶，每个桶有独立的互斥锁；
+ * 对象编号到所在网格单元的映射按编号分片，每个分片也有独立的锁。更新只锁定对象所在的分片和涉及的一两个桶，
+ * 位置不跨网格时只原地修改坐标，不需要重建索引。查询先用 `create_box` 得到边界框，只访问与之相交的网格单元，
+ * 再用 `distance` 精确过滤。地理坐标下跨越反子午线的查询会同时访问另一侧的网格单元。
+ *
+ * 所有成员函数都可以在多个线程中同时调用。对象跨网格移动时先从旧单元移除再插入新单元，同时进行的查询
+ * 可能短暂地看不到该对象。
+ *
+ * @tparam Point 二维点类型，通常为 `PointGeo2`。
+ */
+template <typename Point>
+class MovingObjectIndex {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    static constexpr double kDefaultCellSize = 0.002;  // 地理坐标下约 200 米
+
+    /**
+     * @param [in] cell_size 网格边长，单位与坐标相同（地理坐标下为度）。
+     * @param [in] buckets 桶的数量，会向上取整为 2 的幂。
+     */
+    explicit MovingObjectIndex(double cell_size = kDefaultCellSize, size_t buckets = 1 << 16)
+        : cell_size_(cell_size), buckets_(round_up(buckets)), mask_(buckets_.size() - 1) {}
+
+    MovingObjectIndex(const MovingObjectIndex &) = delete;
+    MovingObjectIndex &operator=(const MovingObjectIndex &) = delete;
+
+    /**
+     * @brief 插入对象或更新对象的位置。
+     */
+    void update(uint64_t id, const Point &point) {
+        Cell cell = cell_of(bg::get<0>(point), bg::get<1>(point));
+        auto &shard = shards_[shard_of(id)];
+        std::lock_guard<std::mutex> shard_lock(shard.mutex);
+        auto it = shard.cells.find(id);
+        if (it != shard.cells.end() && it->second == cell) {
+            auto &bucket = buckets_[bucket_of(cell)];
+            std::lock_guard<std::mutex> lock(bucket.mutex);
+            for (auto &entry : bucket.entries) {
+                if (entry.id == id) {
+                    entry.x = bg::get<0>(point);
+                    entry.y = bg::get<1>(point);
+                    break;
+                }
+            }
+            return;
+        }
+        if (it != shard.cells.end()) {
+            erase(id, it->second);
+            it->second = cell;
+        } else {
+            shard.cells.emplace(id, cell);
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        auto &bucket = buckets_[bucket_of(cell)];
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        bucket.entries.push_back({id, cell, bg::get<0>(point), bg::get<1>(point)});
+    }
+
+    /**
+     * @brief 删除对象，对象不存在时返回 false。
+     */
+    bool remove(uint64_t id) {
+        auto &shard = shards_[shard_of(id)];
+        std::lock_guard<std::mutex> shard_lock(shard.mutex);
+        auto it = shard.cells.find(id);
+        if (it == shard.cells.end()) {
+            return false;
+        }
+        erase(id, it->second);
+        shard.cells.erase(it);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 查询与中心点距离不超过 `radius` 的对象。
+     *
+     * @param [in] center 查询中心。
+     * @param [in] radius 查询半径，单位与 `distance` 相同（地理坐标下为米）。
+     * @return std::vector<MovingObjectHit> 按距离升序排列的对象。
+     */
+    std::vector<MovingObjectHit> radius_query(const Point &center, double radius) const {
+        std::vector<MovingObjectHit> hits;
+        auto collect = [&](const Entry &entry) {
+            double d = simplegeom::distance(center, Point(entry.x, entry.y));
+            if (d <= radius) {
+                hits.push_back({entry.id, d});
+            }
+        };
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            // 地理坐标下 `create_box` 的边长为圆的直径，且经度可能超出 [-180, 180]
+            auto box = create_box(center, radius * 2);
+            double min_x = bg::get<bg::min_corner, 0>(box), max_x = bg::get<bg::max_corner, 0>(box);
+            double min_y = bg::get<bg::min_corner, 1>(box), max_y = bg::get<bg::max_corner, 1>(box);
+            visit(std::max(min_x, -180.), min_y, std::min(max_x, 180.), max_y, collect);
+            if (min_x < -180.) {
+                visit(std::max(min_x + 360., max_x), min_y, 180., max_y, collect);
+            }
+            if (max_x > 180.) {
+                visit(-180., min_y, std::min(max_x - 360., min_x), max_y, collect);
+            }
+        } else {
+            // 笛卡尔坐标下 `create_box` 的边长参数为半边长
+            auto box = create_box(center, radius);
+            visit(bg::get<bg::min_corner, 0>(box), bg::get<bg::min_corner, 1>(box), bg::get<bg::max_corner, 0>(box),
+                  bg::get<bg::max_corner, 1>(box), collect);
+        }
+        std::sort(hits.begin(), hits.end(), [](const MovingObjectHit &a, const MovingObjectHit &b) {
+            return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+        });
+        // 反子午线两侧的查询范围在边界上重合，同一对象可能被访问两次
+        hits.erase(std::unique(hits.begin(), hits.end(),
+                               [](const MovingObjectHit &a, const MovingObjectHit &b) { return a.id == b.id; }),
+                   hits.end());
+        return hits;
+    }
+
+    /**
+     * @brief 查询距离中心点最近的 `k` 个对象。
+     *
+     * 从一个网格边长对应的半径开始逐步扩大搜索半径，直到找到 `k` 个对象或半径超过 `max_radius`。
+     *
+     * @param [in] center 查询中心。
+     * @param [in] k 对象数量。
+     * @param [in] max_radius 最大搜索半径，单位与 `distance` 相同。
+     * @return std::vector<MovingObjectHit> 按距离升序排列的最多 `k` 个对象。
+     */
+    std::vector<MovingObjectHit> knn(const Point &center, size_t k, double max_radius) const {
+        std::vector<MovingObjectHit> hits;
+        if (k == 0) {
+            return hits;
+        }
+        double radius = std::min(max_radius, initial_radius(center));
+        for (;;) {
+            hits = radius_query(center, radius);
+            if (hits.size() >= k || radius >= max_radius) {
+                break;
+            }
+            radius = std::min(max_radius, radius * 2);
+        }
+        if (hits.size() > k) {
+            hits.resize(k);
+        }
+        return hits;
+    }
+
+private:
+    struct Cell {
+        int64_t x, y;
+        bool operator==(const Cell &other) const { return x == other.x && y == other.y; }
+    };
+
+    struct Entry {
+        uint64_t id;
+        Cell cell;
+        double x, y;
+    };
+
+    struct Bucket {
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, Cell> cells;
+    };
+
+    static constexpr size_t kShards = 64;
+
+    static size_t round_up(size_t n) {
+        size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    Cell cell_of(double x, double y) const {
+        return Cell{static_cast<int64_t>(std::floor(x / cell_size_)), static_cast<int64_t>(std::floor(y / cell_size_))};
+    }
+
+    size_t bucket_of(const Cell &cell) const {
+        uint64_t h = static_cast<uint64_t>(cell.x) * 0x9e3779b97f4a7c15ULL ^
+                     static_cast<uint64_t>(cell.y) * 0xc2b2ae3d27d4eb4fULL;
+        return static_cast<size_t>(h ^ (h >> 29)) & mask_;
+    }
+
+    static size_t shard_of(uint64_t id) { return static_cast<size_t>((id * 0x9e3779b97f4a7c15ULL) >> 58) % kShards; }
+
+    // 从桶中删除对象，调用方需要持有对象所在分片的锁
+    void erase(uint64_t id, const Cell &cell) {
+        auto &bucket = buckets_[bucket_of(cell)];
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        auto &entries = bucket.entries;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].id == id) {
+                entries[i] = entries.back();
+                entries.pop_back();
+                break;
+            }
+        }
+    }
+
+    // 访问边界框覆盖的网格单元中位于边界框内的对象，覆盖的网格单元多于桶数时直接扫描全部桶
+    template <typename Func>
+    void visit(double min_x, double min_y, double max_x, double max_y, Func &func) const {
+        if (min_x > max_x || min_y > max_y) {
+            return;
+        }
+        auto inside = [&](const Entry &entry) {
+            return entry.x >= min_x && entry.x <= max_x && entry.y >= min_y && entry.y <= max_y;
+        };
+        Cell lo = cell_of(min_x, min_y), hi = cell_of(max_x, max_y);
+        if (static_cast<double>(hi.x - lo.x + 1) * static_cast<double>(hi.y - lo.y + 1) > buckets_.size()) {
+            for (const auto &bucket : buckets_) {
+                std::lock_guard<std::mutex> lock(bucket.mutex);
+                for (const auto &entry : bucket.entries) {
+                    if (inside(entry)) {
+                        func(entry);
+                    }
+                }
+            }
+            return;
+        }
+        for (int64_t cx = lo.x; cx <= hi.x; ++cx) {
+            for (int64_t cy = lo.y; cy <= hi.y; ++cy) {
+                Cell cell{cx, cy};
+                const auto &bucket = buckets_[bucket_of(cell)];
+                std::lock_guard<std::mutex> lock(bucket.mutex);
+                for (const auto &entry : bucket.entries) {
+                    if (entry.cell == cell && inside(entry)) {
+                        func(entry);
+                    }
+                }
+            }
+        }
+    }
+
+    // 一个网格边长在查询中心处对应的距离
+    double initial_radius(const Point &center) const {
+        Point other(bg::get<0>(center), bg::get<1>(center) + cell_size_);
+        return std::max(simplegeom::distance(center, other), 1e-9);
+    }
+
+    double cell_size_;
+    std::vector<Bucket> buckets_;
+    size_t mask_;
+    Shard shards_[kShards];
+    std::atomic<size_t> size_{0};
+};
+
+}  // namespace simplegeom
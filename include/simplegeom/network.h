@@ -0,0 +1,159 @@
+#pragma once
+
+#include <boost/geometry/index/rtree.hpp>
+#include <limits>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+namespace bgi = boost::geometry::index;
+
+// 点在线网上的投影结果
+struct NetworkProjection {
+    static constexpr size_t kInvalidLine = std::numeric_limits<size_t>::max();
+
+    size_t line_id = kInvalidLine;  // 最近折线的编号，`kInvalidLine` 表示搜索范围内没有折线
+    double distance = -1.;          // 点到最近折线的距离
+    double project_distance = 0.;   // 投影距离，含义取决于投影模式
+
+    bool valid() const { return line_id != kInvalidLine; }
+};
+
+namespace network_detail {
+
+/**
+ * @brief 计算点到单条折线的距离和投影距离，累积模式下使用预计算的累积长度。
+ *
+ * @param [in] first,last 折线顶点区间，至少包含一个点。
+ * @param [in] cumulative_lengths 与顶点一一对应的累积长度。
+ * @return std::pair<double, double> 点到折线的距离以及投影距离。
+ */
+template <typename Point, typename Iterator>
+std::pair<double, double> project_line(const Point &point, Iterator first, Iterator last,
+                                       const double *cumulative_lengths, ProjectionMode mode) {
+    if (last - first < 2) {
+        return std::make_pair(distance(point, *first), 0.);
+    }
+    auto projection = project(point, first, last);
+    double project_distance = projection.segment_offset;
+    if (mode == ProjectionMode::kAccumulate) {
+        project_distance += cumulative_lengths[projection.segment_index];
+    }
+    return std::make_pair(projection.distance, project_distance);
+}
+
+}  // namespace network_detail
+
+/**
+ * @brief 折线网络，持有一组折线、每条折线的累积长度以及折线外包框的 R 树索引。
+ *
+ * 构建时一次性计算每条折线各顶点的累积长度，投影时通过索引筛选候选折线，
+ * 在 `ProjectionMode::kAccumulate` 模式下无需再逐段累加长度。
+ *
+ * @tparam Point 点的类型，通常为 `Point2` 或 `PointGeo2`。
+ */
+template <typename Point>
+class LineNetwork {
+public:
+    static constexpr double kDefaultSearchRadius = 2000.;  // 默认搜索框边长
+
+    LineNetwork() = default;
+
+    explicit LineNetwork(std::vector<LineString<Point>> lines) : lines_(std::move(lines)) {
+        cumulative_lengths_.resize(lines_.size());
+        std::vector<IndexValue> values;
+        values.reserve(lines_.size());
+        for (size_t id = 0; id < lines_.size(); ++id) {
+            const auto &line = lines_[id];
+            auto &lengths = cumulative_lengths_[id];
+            lengths.resize(line.size(), 0.);
+            for (size_t i = 1; i < line.size(); ++i) {
+                lengths[i] = lengths[i - 1] + distance(line[i - 1], line[i]);
+            }
+            if (!line.empty()) {
+                values.emplace_back(bg::return_envelope<Box<Point>>(line), id);
+            }
+        }
+        // 使用打包构建（packing）算法一次性构建索引
+        rtree_ = RTree(values.begin(), values.end());
+    }
+
+    size_t size() const { return lines_.size(); }
+    bool empty() const { return lines_.empty(); }
+
+    const std::vector<LineString<Point>> &lines() const { return lines_; }
+    const LineString<Point> &line(size_t id) const { return lines_.at(id); }
+
+    /**
+     * @brief 获取折线各顶点的累积长度，第 i 个值为起点到第 i 个顶点沿线的距离。
+     */
+    const std::vector<double> &cumulative_lengths(size_t id) const { return cumulative_lengths_.at(id); }
+
+    /**
+     * @brief 计算点在线网上的投影。
+     *
+     * 先用以点为中心、边长为 `search_radius` 的边界框查询索引得到候选折线，再对每条候选折线调用 `project`，
+     * 取距离最小者。累积模式下的投影距离由预计算的累积长度直接得到。
+     *
+     * @param [in] point 要投影的点。
+     * @param [in] mode 投影模式。
+     * @param [in] search_radius 候选折线的搜索框边长，语义与 `create_box` 相同。
+     * @return NetworkProjection 投影结果，搜索范围内没有折线时返回无效结果。
+     */
+    NetworkProjection project(const Point &point, ProjectionMode mode,
+                              double search_radius = kDefaultSearchRadius) const {
+        NetworkProjection result;
+        auto query_box = create_box(point, search_radius);
+        for (auto it = rtree_.qbegin(bgi::intersects(query_box)); it != rtree_.qend(); ++it) {
+            size_t id = it->second;
+            const auto &line = lines_[id];
+            auto [d, project_distance] =
+                network_detail::project_line(point, line.begin(), line.end(), cumulative_lengths_[id].data(), mode);
+            if (!result.valid() || d < result.distance) {
+                result.line_id = id;
+                result.distance = d;
+                result.project_distance = project_distance;
+            }
+        }
+        return result;
+    }
+
+private:
+    using IndexValue = std::pair<Box<Point>, size_t>;
+    using RTree = bgi::rtree<IndexValue, bgi::quadratic<16>>;
+
+    std::vector<LineString<Point>> lines_;
+    std::vector<std::vector<double>> cumulative_lengths_;
+    RTree rtree_;
+};
+
+/**
+ * @brief 批量计算多个点在线网上的投影。
+ *
+ * 点集会被划分为若干块并在线程池上并行计算，结果顺序与输入顺序一致。
+ *
+ * @tparam Point 点的类型。
+ * @param [in] network 折线网络。
+ * @param [in] points 要投影的点集。
+ * @param [in] mode 投影模式。
+ * @param [in] pool 线程池，为空时在当前线程中顺序计算。
+ * @param [in] search_radius 候选折线的搜索框边长。
+ * @return std::vector<NetworkProjection> 与输入一一对应的投影结果。
+ */
+template <typename Point>
+std::vector<NetworkProjection> project_batch(const LineNetwork<Point> &network, const std::vector<Point> &points,
+                                             ProjectionMode mode, ThreadPool *pool = nullptr,
+                                             double search_radius = LineNetwork<Point>::kDefaultSearchRadius) {
+    std::vector<NetworkProjection> results(points.size());
+    parallel_for(pool, points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = network.project(points[i], mode, search_radius);
+        }
+    });
+    return results;
+}
+
+}  // namespace simplegeom
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/network.h"
+
+namespace simplegeom {
+
+// 空间分区的配置项
+struct PartitionOptions {
+    size_t partitions = 4;  // 分区数
+    double halo = 2000.;    // 重叠边带的宽度，语义与 `create_box` 的边长相同（即边带向外延伸 `halo / 2`）
+};
+
+// 单个分区
+template <typename Point>
+struct Partition {
+    Box<Point> core;               // 分区负责的区域，所有分区的 `core` 恰好铺满全部折线的外包框
+    Box<Point> extent;             // `core` 向外扩展边带后的区域，外包框与之相交的折线都属于该分区
+    std::vector<size_t> line_ids;  // 属于该分区的折线在原始集合中的编号，升序排列
+    size_t vertices = 0;           // 分区内（含边带）的顶点总数
+};
+
+namespace partition_detail {
+
+template <typename Point>
+bool intersects(const Box<Point> &a, const Box<Point> &b) {
+    return !(bg::get<bg::max_corner, 0>(a) < bg::get<bg::min_corner, 0>(b) ||
+             bg::get<bg::min_corner, 0>(a) > bg::get<bg::max_corner, 0>(b) ||
+             bg::get<bg::max_corner, 1>(a) < bg::get<bg::min_corner, 1>(b) ||
+             bg::get<bg::min_corner, 1>(a) > bg::get<bg::max_corner, 1>(b));
+}
+
+template <typename Point>
+bool covers(const Box<Point> &outer, const Box<Point> &inner) {
+    return bg::get<bg::min_corner, 0>(outer) <= bg::get<bg::min_corner, 0>(inner) &&
+           bg::get<bg::min_corner, 1>(outer) <= bg::get<bg::min_corner, 1>(inner) &&
+           bg::get<bg::max_corner, 0>(outer) >= bg::get<bg::max_corner, 0>(inner) &&
+           bg::get<bg::max_corner, 1>(outer) >= bg::get<bg::max_corner, 1>(inner);
+}
+
+// 将 `box` 扩展到包含 `other`
+template <typename Point>
+void expand(Box<Point> &box, const Box<Point> &other) {
+    bg::set<bg::min_corner, 0>(box, std::min(bg::get<bg::min_corner, 0>(box), bg::get<bg::min_corner, 0>(other)));
+    bg::set<bg::min_corner, 1>(box, std::min(bg::get<bg::min_corner, 1>(box), bg::get<bg::min_corner, 1>(other)));
+    bg::set<bg::max_corner, 0>(box, std::max(bg::get<bg::max_corner, 0>(box), bg::get<bg::max_corner, 0>(other)));
+    bg::set<bg::max_corner, 1>(box, std::max(bg::get<bg::max_corner, 1>(box), bg::get<bg::max_corner, 1>(other)));
+}
+
+/**
+ * @brief 用 `create_box` 在四个角点上的边界框扩展分区区域。地理坐标下经度方向的放大倍数在纬度绝对值最大的角点处
+ * 最大，因此扩展结果覆盖区域内任意一点处的边界框。
+ */
+template <typename Point>
+Box<Point> expand_by(const Box<Point> &core, double edge_length) {
+    Box<Point> result = core;
+    for (double x : {bg::get<bg::min_corner, 0>(core), bg::get<bg::max_corner, 0>(core)}) {
+        for (double y : {bg::get<bg::min_corner, 1>(core), bg::get<bg::max_corner, 1>(core)}) {
+            expand(result, create_box(Point(x, y), edge_length));
+        }
+    }
+    return result;
+}
+
+struct Item {
+    double x, y;    // 折线外包框的中心
+    size_t weight;  // 折线的顶点数
+};
+
+// 递归二分：沿区域较长的一边按顶点数加权切分，直到得到 `parts` 个区域
+template <typename Point>
+void bisect(std::vector<Item> &items, size_t begin, size_t end, const Box<Point> &region, size_t parts,
+            std::vector<Box<Point>> &cores) {
+    if (parts == 1) {
+        cores.push_back(region);
+        return;
+    }
+    bool split_x = bg::get<bg::max_corner, 0>(region) - bg::get<bg::min_corner, 0>(region) >=
+                   bg::get<bg::max_corner, 1>(region) - bg::get<bg::min_corner, 1>(region);
+    auto key = [split_x](const Item &item) { return split_x ? item.x : item.y; };
+    std::sort(items.begin() + begin, items.begin() + end,
+              [&key](const Item &a, const Item &b) { return key(a) < key(b); });
+
+    size_t left_parts = parts / 2;
+    size_t total = 0;
+    for (size_t i = begin; i < end; ++i) {
+        total += items[i].weight;
+    }
+    size_t target = total * left_parts / parts, acc = 0, mid = begin;
+    while (mid < end && acc + items[mid].weight <= target) {
+        acc += items[mid++].weight;
+    }
+
+    // 切分坐标取两侧相邻中心点的中点，没有折线的一侧取区域的中点
+    int axis = split_x ? 0 : 1;
+    double lo = axis == 0 ? bg::get<bg::min_corner, 0>(region) : bg::get<bg::min_corner, 1>(region);
+    double hi = axis == 0 ? bg::get<bg::max_corner, 0>(region) : bg::get<bg::max_corner, 1>(region);
+    double split = (lo + hi) / 2.;
+    if (mid > begin && mid < end) {
+        split = (key(items[mid - 1]) + key(items[mid])) / 2.;
+    } else if (mid > begin) {
+        split = std::min(hi, key(items[mid - 1]));
+    } else if (mid < end) {
+        split = std::max(lo, key(items[mid]));
+    }
+
+    Box<Point> left = region, right = region;
+    if (axis == 0) {
+        bg::set<bg::max_corner, 0>(left, split);
+        bg::set<bg::min_corner, 0>(right, split);
+    } else {
+        bg::set<bg::max_corner, 1>(left, split);
+        bg::set<bg::min_corner, 1>(right, split);
+    }
+    bisect(items, begin, mid, left, left_parts, cores);
+    bisect(items, mid, end, right, parts - left_parts, cores);
+}
+
+}  // namespace partition_detail
+
+/**
+ * @brief 将折线集合划分为若干空间分区，用于多进程横向扩展。
+ *
+ * 分区通过对折线外包框中心的递归二分得到，切分时按顶点数加权，使各分区的顶点数大致相等；所有分区的
+ * `core` 恰好铺满全部折线的外包框。每个分区再向外扩展 `halo` 的边带，外包框与扩展区域相交的折线都
+ * 属于该分区，因此靠近分区边界的折线会同时属于多个分区。
+ *
+ * 查询时 `route` 给出必须访问的分区：查询点所在分区的扩展区域覆盖整个搜索框时只访问该分区，否则访问
+ * `core` 与搜索框相交的所有分区。两种情况下访问的分区都包含所有外包框与搜索框相交的折线，
+ * 因此合并后的结果与在完整线网上查询的结果相同。
+ *
+ * @note 分区在原始坐标空间中计算，不处理跨越反子午线的折线。
+ *
+ * @tparam Point 二维点类型。
+ */
+template <typename Point>
+class SpatialPartitioning {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    SpatialPartitioning() = default;
+
+    /**
+     * @brief 计算折线集合的分区。
+     *
+     * @param [in] lines 折线集合。
+     * @param [in] options 分区配置。
+     */
+    SpatialPartitioning(const std::vector<LineString<Point>> &lines, const PartitionOptions &options)
+        : halo_(options.halo) {
+        if (options.partitions == 0) {
+            throw std::invalid_argument("partitions must be positive");
+        }
+        std::vector<Box<Point>> envelopes;
+        std::vector<partition_detail::Item> items;
+        Box<Point> bounds;
+        bg::assign_inverse(bounds);
+        for (const auto &line : lines) {
+            Box<Point> envelope;
+            bg::assign_inverse(envelope);
+            if (!line.empty()) {
+                envelope = bg::return_envelope<Box<Point>>(line);
+                partition_detail::expand(bounds, envelope);
+                items.push_back({(bg::get<bg::min_corner, 0>(envelope) + bg::get<bg::max_corner, 0>(envelope)) / 2.,
+                                 (bg::get<bg::min_corner, 1>(envelope) + bg::get<bg::max_corner, 1>(envelope)) / 2.,
+                                 line.size()});
+            }
+            envelopes.push_back(envelope);
+        }
+        if (items.empty()) {
+            bounds = Box<Point>(Point(0., 0.), Point(0., 0.));
+        }
+
+        std::vector<Box<Point>> cores;
+        partition_detail::bisect(items, 0, items.size(), bounds, options.partitions, cores);
+        partitions_.resize(cores.size());
+        for (size_t p = 0; p < cores.size(); ++p) {
+            auto &partition = partitions_[p];
+            partition.core = cores[p];
+            partition.extent = partition_detail::expand_by(cores[p], halo_);
+            for (size_t id = 0; id < lines.size(); ++id) {
+                if (!lines[id].empty() && partition_detail::intersects(envelopes[id], partition.extent)) {
+                    partition.line_ids.push_back(id);
+                    partition.vertices += lines[id].size();
+                }
+            }
+        }
+    }
+
+    size_t size() const { return partitions_.size(); }
+    double halo() const { return halo_; }
+    const Partition<Point> &partition(size_t p) const { return partitions_.at(p); }
+    const std::vector<Partition<Point>> &partitions() const { return partitions_; }
+
+    /**
+     * @brief 给出查询必须访问的分区。
+     *
+     * @param [in] point 查询点。
+     * @param [in] search_radius 搜索框边长，语义与 `create_box` 相同。
+     * @return std::vector<size_t> 分区编号，升序排列；查询点远离所有折线时为空。
+     */
+    std::vector<size_t> route(const Point &point, double search_radius) const {
+        auto box = create_box(point, search_radius);
+        std::vector<size_t> result;
+        for (size_t p = 0; p < partitions_.size(); ++p) {
+            const auto &partition = partitions_[p];
+            if (bg::covered_by(point, partition.core) && partition_detail::covers(partition.extent, box)) {
+                return {p};
+            }
+            if (partition_detail::intersects(partition.core, box)) {
+                result.push_back(p);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief 提取分区内的折线，顺序与 `line_ids` 一致，分区内的局部编号即为在该数组中的下标。
+     */
+    std::vector<LineString<Point>> extract(const std::vector<LineString<Point>> &lines, size_t p) const {
+        std::vector<LineString<Point>> result;
+        for (size_t id : partitions_.at(p).line_ids) {
+            result.push_back(lines.at(id));
+        }
+        return result;
+    }
+
+    /**
+     * @brief 以文本格式保存分区信息，每个分区一行：core 与 extent 的坐标、折线数量以及折线编号。
+     */
+    void save(std::ostream &out) const {
+        out.precision(17);
+        out << partitions_.size() << " " << halo_ << "\n";
+        for (const auto &partition : partitions_) {
+            for (const auto *box : {&partition.core, &partition.extent}) {
+                out << bg::get<bg::min_corner, 0>(*box) << " " << bg::get<bg::min_corner, 1>(*box) << " "
+                    << bg::get<bg::max_corner, 0>(*box) << " " << bg::get<bg::max_corner, 1>(*box) << " ";
+            }
+            out << partition.vertices << " " << partition.line_ids.size();
+            for (size_t id : partition.line_ids) {
+                out << " " << id;
+            }
+            out << "\n";
+        }
+    }
+
+    static SpatialPartitioning load(std::istream &in) {
+        SpatialPartitioning result;
+        size_t count = 0;
+        if (!(in >> count >> result.halo_)) {
+            throw std::runtime_error("invalid partition file");
+        }
+        result.partitions_.resize(count);
+        for (auto &partition : result.partitions_) {
+            for (auto *box : {&partition.core, &partition.extent}) {
+                double min_x, min_y, max_x, max_y;
+                in >> min_x >> min_y >> max_x >> max_y;
+                *box = Box<Point>(Point(min_x, min_y), Point(max_x, max_y));
+            }
+            size_t n = 0;
+            in >> partition.vertices >> n;
+            partition.line_ids.resize(n);
+            for (auto &id : partition.line_ids) {
+                in >> id;
+            }
+            if (!in) {
+                throw std::runtime_error("invalid partition file");
+            }
+        }
+        return result;
+    }
+
+private:
+    double halo_ = 0.;
+    std::vector<Partition<Point>> partitions_;
+};
+
+/**
+ * @brief 合并各分区的投影结果：取距离最小者，距离相同时取全局编号较小的折线。
+ *
+ * @param [in] results 各分区的投影结果，`line_id` 为分区内的局部编号。
+ * @param [in] line_ids 与 `results` 对应的各分区局部编号到全局编号的映射（即 `Partition::line_ids`）。
+ * @return NetworkProjection 全局编号表示的投影结果。
+ */
+inline NetworkProjection merge_projections(const std::vector<NetworkProjection> &results,
+                                           const std::vector<const std::vector<size_t> *> &line_ids) {
+    NetworkProjection merged;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto &r = results[i];
+        if (!r.valid()) {
+            continue;
+        }
+        size_t id = (*line_ids[i])[r.line_id];
+        if (!merged.valid() || r.distance < merged.distance || (r.distance == merged.distance && id < merged.line_id)) {
+            merged = r;
+            merged.line_id = id;
+        }
+    }
+    return merged;
+}
+
+/**
+ * @brief 进程内的分区线网，每个分区持有自己的 `LineNetwork`，查询时按 `route` 访问分区并合并结果。
+ *
+ * 与多进程部署的查询路径相同，便于在单个进程中验证分区、路由与合并的正确性。
+ *
+ * @tparam Point 二维点类型。
+ */
+template <typename Point>
+class PartitionedNetwork {
+public:
+    PartitionedNetwork(const std::vector<LineString<Point>> &lines, const PartitionOptions &options)
+        : partitioning_(lines, options) {
+        for (size_t p = 0; p < partitioning_.size(); ++p) {
+            networks_.emplace_back(partitioning_.extract(lines, p));
+        }
+    }
+
+    const SpatialPartitioning<Point> &partitioning() const { return partitioning_; }
+    const LineNetwork<Point> &network(size_t p) const { return networks_.at(p); }
+
+    NetworkProjection project(const Point &point, ProjectionMode mode,
+                              double search_radius = LineNetwork<Point>::kDefaultSearchRadius) const {
+        std::vector<NetworkProjection> results;
+        std::vector<const std::vector<size_t> *> line_ids;
+        for (size_t p : partitioning_.route(point, search_radius)) {
+            results.push_back(networks_[p].project(point, mode, search_radius));
+            line_ids.push_back(&partitioning_.partition(p).line_ids);
+        }
+        return merge_projections(results, line_ids);
+    }
+
+private:
+    SpatialPartitioning<Point> partitioning_;
+    std::vector<LineNetwork<Point>> networks_;
+};
+
+}  // namespace simplegeom
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+// 多边形的面积、周长与质心
+template <typename Point>
+struct PolygonMetrics {
+    double area = 0.;       // 面积，符号约定与 `bg::area` 相同（外环按多边形类型的方向时为正），地理坐标下为平方米
+    double perimeter = 0.;  // 外环与所有内环的长度之和，单位与 `distance` 相同
+    Point centroid;         // 面积加权的质心，面积为 0 时为外环的第一个点
+};
+
+namespace polygon_detail {
+
+// WGS84 椭球
+static constexpr double kA = kWgs84SemiMajorAxis;
+static constexpr double kF = kWgs84Flattening;
+static constexpr double kE2 = kF * (2. - kF);
+static constexpr double kRad = M_PI / 180.;
+static constexpr double kMaxEdge = 10000.;        // 局部平面近似计算边长的最大边长（米），超过时改用 `distance`
+static constexpr double kMaxConvergence = 0.002;  // 经度差（弧度）与纬度正弦之积的上限，超过时改用 `distance`
+
+/**
+ * @brief 等面积圆柱投影的纵坐标：赤道到纬度 φ 之间、经度跨度为 1 弧度的椭球带的面积。
+ *
+ * 即 a²q(φ)/2，q 为计算 authalic 纬度所用的函数。其中 atanh(e sinφ)/e 按 e² 展开到第 5 项，截断误差
+ * 小于 1e-12，整个计算只有乘加运算。
+ *
+ * @param [in] s 纬度的正弦。
+ */
+inline double zone_area(double s) {
+    double t = kE2 * s * s;
+    double atanh_series = s * (1. + t * (1. / 3. + t * (1. / 5. + t * (1. / 7. + t / 9.))));
+    return kA * kA * (1. - kE2) * 0.5 * (s / (1. - t) + atanh_series);
+}
+
+// `zone_area` 的反函数（返回纬度，单位为度）：先由 q 得到 authalic 纬度 β，按级数得到纬度，再做一次牛顿迭代
+// 消除级数截断的误差（约 1e-9 弧度）
+inline double latitude_of_zone_area(double area) {
+    static const double kZonePole = zone_area(1.);
+    double beta = std::asin(std::clamp(area / kZonePole, -1., 1.));
+    double e4 = kE2 * kE2, e6 = e4 * kE2;
+    double phi = beta + (kE2 / 3. + 31. * e4 / 180. + 517. * e6 / 5040.) * std::sin(2. * beta) +
+                 (23. * e4 / 360. + 251. * e6 / 3780.) * std::sin(4. * beta) +
+                 (761. * e6 / 45360.) * std::sin(6. * beta);
+    double s = std::sin(phi), w2 = 1. - kE2 * s * s;
+    double slope = kA * kA * (1. - kE2) * std::cos(phi) / (w2 * w2);  // d zone_area / dφ
+    if (slope > 0.) {
+        phi -= (zone_area(s) - area) / slope;
+    }
+    return phi / kRad;
+}
+
+// 投影后的一个顶点
+struct Vertex {
+    double x, y;         // 投影坐标，相对于外环的第一个点
+    double lat;          // 纬度（弧度），仅地理坐标使用
+    double s;            // 纬度的正弦，仅地理坐标使用
+    double meridian;     // 每弧度纬度对应的距离，仅地理坐标使用
+    double parallel;     // 每弧度经度对应的距离，仅地理坐标使用
+};
+
+// 环上各条边的累加量
+struct Sums {
+    double cross = 0.;     // 各边叉积之和，等于有向面积（逆时针为正）的 2 倍
+    double moment_x = 0.;  // 各边 (x1 + x2) 与叉积之积的和
+    double moment_y = 0.;  // 各边 (y1 + y2) 与叉积之积的和
+    double perimeter = 0.;
+};
+
+/**
+ * @brief 将顶点投影到以 `origin` 为原点的平面。
+ *
+ * 地理坐标使用等面积圆柱投影：横坐标为经度差（弧度，沿较短的方向），纵坐标为 `zone_area`，投影平面中的
+ * 鞋带公式即为以投影平面中的直线为边的面积，`add_edge` 再按测地线的曲率补上每条边的三次项。同时计算局部平面
+ * 近似边长所需的曲率半径，每个顶点只有一次三角函数调用。
+ */
+template <typename Point>
+Vertex project(const Point &p, double origin_x, double origin_y) {
+    Vertex v{};
+    if constexpr (std::is_same_v<Point, PointGeo2>) {
+        double d = bg::get<0>(p) - origin_x;
+        v.x = (d > 180. ? d - 360. : (d < -180. ? d + 360. : d)) * kRad;
+        v.lat = bg::get<1>(p) * kRad;
+        v.s = std::sin(v.lat);
+        v.y = zone_area(v.s) - origin_y;
+        double w2 = 1. - kE2 * v.s * v.s, w = std::sqrt(w2);
+        v.meridian = kA * (1. - kE2) / (w2 * w);
+        v.parallel = kA * std::sqrt(std::max(0., 1. - v.s * v.s)) / w;
+    } else {
+        v.x = bg::get<0>(p) - origin_x;
+        v.y = bg::get<1>(p) - origin_y;
+    }
+    return v;
+}
+
+// 累加一条边，`p1`、`p2` 为边的端点，仅在局部平面近似不适用时使用
+template <typename Point>
+void add_edge(const Vertex &a, const Vertex &b, const Point &p1, const Point &p2, Sums &sums) {
+    double c = a.x * b.y - b.x * a.y;
+    sums.cross += c;
+    sums.moment_x += (a.x + b.x) * c;
+    sums.moment_y += (a.y + b.y) * c;
+    if constexpr (std::is_same_v<Point, PointGeo2>) {
+        double dlon = b.x - a.x, dlat = b.lat - a.lat;
+        dlon = dlon > M_PI ? dlon - 2 * M_PI : (dlon < -M_PI ? dlon + 2 * M_PI : dlon);
+        // 测地线在投影平面中向极点方向弯曲，按球面上大圆弧的曲率修正边与直线之间的面积（边长的三次项），
+        // 修正量的一阶矩按边的中点计算
+        double s = (a.s + b.s) * 0.5;
+        double bulge = -kA * kA * s * ((1. - s * s) * dlon * dlon + 3. * dlat * dlat) * dlon / 6.;
+        sums.cross += bulge;
+        sums.moment_x += 1.5 * (a.x + b.x) * bulge;
+        sums.moment_y += 1.5 * (a.y + b.y) * bulge;
+
+        double dx = (a.parallel + b.parallel) * 0.5 * dlon;
+        double dy = (a.meridian + b.meridian) * 0.5 * dlat;
+        double d = std::sqrt(dx * dx + dy * dy);
+        if (d > kMaxEdge || std::abs(dlon) * std::max(std::abs(a.s), std::abs(b.s)) > kMaxConvergence) {
+            d = simplegeom::distance(p1, p2);
+        }
+        sums.perimeter += d;
+    } else {
+        double dx = b.x - a.x, dy = b.y - a.y;
+        sums.perimeter += std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+// 一次遍历环上的所有顶点，每个顶点只投影一次
+template <typename Point, typename Ring>
+void accumulate(const Ring &ring, double origin_x, double origin_y, Sums &sums) {
+    if (ring.size() < 2) {
+        return;
+    }
+    Vertex prev = project(ring[0], origin_x, origin_y);
+    for (size_t i = 1; i < ring.size(); ++i) {
+        Vertex cur = project(ring[i], origin_x, origin_y);
+        add_edge(prev, cur, ring[i - 1], ring[i], sums);
+        prev = cur;
+    }
+}
+
+}  // namespace polygon_detail
+
+/**
+ * @brief 一次遍历计算多边形的面积、周长与质心。
+ *
+ * 笛卡尔坐标使用鞋带公式。地理坐标将顶点投影到等面积圆柱投影（authalic 纬度）后使用鞋带公式并修正测地线的弯曲，
+ * 每个顶点只需要一次 `sin`，不需要逐边的反三角函数与级数；周长使用每个顶点处的曲率半径在局部平面中
+ * 计算，长边与高纬度地区跨越较大经度差的边改用 `distance`。质心在投影平面中计算后换算回经纬度。边长数十公里
+ * 以内时，面积与周长的相对误差约为 1e-5，质心误差约为多边形尺度的 5e-5。
+ *
+ * 与 Boost 相同，多边形的环应当闭合，内环的方向与外环相反；地理坐标下多边形不能包含极点，经度跨度应小于 180 度。
+ *
+ * @tparam Point 二维点类型，`Point2` 或 `PointGeo2`。
+ * @param [in] polygon 多边形。
+ * @return PolygonMetrics<Point> 面积、周长与质心。
+ */
+template <typename Point>
+PolygonMetrics<Point> polygon_metrics(const Polygon<Point> &polygon) {
+    PolygonMetrics<Point> metrics;
+    const auto &outer = polygon.outer();
+    if (outer.empty()) {
+        return metrics;
+    }
+    double origin_x = bg::get<0>(outer[0]), origin_y = bg::get<1>(outer[0]);
+    double projected_origin_y = origin_y;
+    if constexpr (std::is_same_v<Point, PointGeo2>) {
+        projected_origin_y = polygon_detail::zone_area(std::sin(origin_y * polygon_detail::kRad));
+    }
+
+    polygon_detail::Sums sums;
+    polygon_detail::accumulate<Point>(outer, origin_x, projected_origin_y, sums);
+    for (const auto &inner : polygon.inners()) {
+        polygon_detail::accumulate<Point>(inner, origin_x, projected_origin_y, sums);
+    }
+
+    // 叉积之和为逆时针方向的 2 倍有向面积
+    constexpr bool kClockwise = bg::point_order<Polygon<Point>>::value == bg::clockwise;
+    metrics.area = (kClockwise ? -0.5 : 0.5) * sums.cross;
+    metrics.perimeter = sums.perimeter;
+    metrics.centroid = outer[0];
+    if (sums.cross != 0.) {
+        double cx = sums.moment_x / (3. * sums.cross), cy = sums.moment_y / (3. * sums.cross);
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            double lon = origin_x + cx / polygon_detail::kRad;
+            lon = lon > 180. ? lon - 360. : (lon < -180. ? lon + 360. : lon);
+            metrics.centroid = Point(lon, polygon_detail::latitude_of_zone_area(projected_origin_y + cy));
+        } else {
+            metrics.centroid = Point(origin_x + cx, origin_y + cy);
+        }
+    }
+    return metrics;
+}
+
+/**
+ * @brief 批量计算多边形的面积、周长与质心。
+ *
+ * @param [in] polygons 多边形集合。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<PolygonMetrics<Point>> 与 `polygons` 一一对应的结果。
+ */
+template <typename Point>
+std::vector<PolygonMetrics<Point>> polygon_metrics_batch(const std::vector<Polygon<Point>> &polygons,
+                                                         ThreadPool *pool = nullptr) {
+    std::vector<PolygonMetrics<Point>> results(polygons.size());
+    parallel_for(pool, polygons.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = polygon_metrics(polygons[i]);
+        }
+    });
+    return results;
+}
+
+}  // namespace simplegeom
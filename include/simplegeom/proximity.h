@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+// 一对距离不超过阈值的对象，`a < b` 为对象在批次中的序号
+struct ProximityPair {
+    uint32_t a;
+    uint32_t b;
+    double distance;
+    double timestamp;
+};
+
+/**
+ * @brief 大量移动点之间的邻近（碰撞）检测。
+ *
+ * 每个时刻输入一批点，输出所有距离不超过 `threshold` 的点对。粗筛阶段将点放入边长不小于阈值的均匀网格，
+ * 按网格单元的 Morton 码排序，同一单元的点在排序后连续存放，只需比较同一单元以及右侧、上方四个相邻单元中的点；
+ * 精筛阶段使用 `distance` 计算精确距离。
+ *
+ * 检测器在两个时刻之间保留排序结果：点的数量不变时，只有跨越网格的点需要重新排序并归并回原有顺序，
+ * 代价为 O(n + k log k)，k 为跨越网格的点数。地理坐标下网格的经度方向首尾相接，跨越反子午线的点对也能被检测到。
+ *
+ * @tparam Point 二维点类型，`Point2` 或 `PointGeo2`。
+ */
+template <typename Point>
+class ProximityDetector {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    /**
+     * @param [in] threshold 距离阈值，单位与 `distance` 相同（地理坐标下为米）。
+     * @param [in] pool 用于并行精筛的线程池，可以为空。
+     */
+    explicit ProximityDetector(double threshold, ThreadPool *pool = nullptr) : threshold_(threshold), pool_(pool) {}
+
+    /**
+     * @brief 检测一个时刻中所有距离不超过阈值的点对。
+     *
+     * @param [in] points 该时刻所有对象的位置，序号即对象编号。
+     * @param [in] timestamp 时刻，原样写入结果。
+     * @return std::vector<ProximityPair> 按 `(a, b)` 排序的点对。
+     */
+    std::vector<ProximityPair> detect(const std::vector<Point> &points, double timestamp) {
+        update_grid(points);
+
+        // 连续的同一网格单元的点组成一个分组
+        groups_.clear();
+        for (size_t i = 0; i < order_.size();) {
+            size_t j = i + 1;
+            while (j < order_.size() && keys_[order_[j]] == keys_[order_[i]]) {
+                ++j;
+            }
+            groups_.push_back({keys_[order_[i]], static_cast<uint32_t>(i), static_cast<uint32_t>(j)});
+            i = j;
+        }
+
+        // 按网格顺序复制坐标，精筛时相邻单元的点在内存中也相邻
+        sorted_.resize(order_.size());
+        for (size_t i = 0; i < order_.size(); ++i) {
+            sorted_[i] = points[order_[i]];
+        }
+
+        std::vector<ProximityPair> pairs;
+        std::mutex mutex;
+        parallel_for(
+            pool_, groups_.size(),
+            [&](size_t begin, size_t end) {
+                std::vector<ProximityPair> local;
+                for (size_t g = begin; g < end; ++g) {
+                    collect(g, timestamp, local);
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                pairs.insert(pairs.end(), local.begin(), local.end());
+            },
+            64);
+
+        std::sort(pairs.begin(), pairs.end(), [](const ProximityPair &x, const ProximityPair &y) {
+            return x.a < y.a || (x.a == y.a && x.b < y.b);
+        });
+        // 经度方向只有两个网格单元时，首尾相接的相邻单元会被访问两次
+        auto same = [](const ProximityPair &x, const ProximityPair &y) { return x.a == y.a && x.b == y.b; };
+        pairs.erase(std::unique(pairs.begin(), pairs.end(), same), pairs.end());
+        return pairs;
+    }
+
+    // 上一次检测中跨越网格单元的点数，全量重建时等于点数
+    size_t moved() const { return moved_; }
+
+private:
+    struct Group {
+        uint64_t key;
+        uint32_t begin, end;
+    };
+
+    static uint64_t spread(uint32_t v) {
+        uint64_t x = v;
+        x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+        x = (x | (x << 8)) & 0x00ff00ff00ff00ffULL;
+        x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        x = (x | (x << 2)) & 0x3333333333333333ULL;
+        x = (x | (x << 1)) & 0x5555555555555555ULL;
+        return x;
+    }
+
+    static uint32_t compact(uint64_t x) {
+        x &= 0x5555555555555555ULL;
+        x = (x | (x >> 1)) & 0x3333333333333333ULL;
+        x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0fULL;
+        x = (x | (x >> 4)) & 0x00ff00ff00ff00ffULL;
+        x = (x | (x >> 8)) & 0x0000ffff0000ffffULL;
+        x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+        return static_cast<uint32_t>(x);
+    }
+
+    static uint64_t morton(uint32_t cx, uint32_t cy) { return spread(cx) | (spread(cy) << 1); }
+
+    uint64_t key_of(const Point &p) const {
+        double x = bg::get<0>(p), y = bg::get<1>(p);
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            auto cx = std::min(static_cast<uint32_t>(std::max(0., std::floor((x + 180.) / cell_x_))), columns_ - 1);
+            return morton(cx, static_cast<uint32_t>(std::max(0., std::floor((y + 90.) / cell_y_))));
+        } else {
+            // 平面坐标偏移 2^31 个网格单元，使负坐标也映射为无符号整数
+            auto cx = static_cast<int64_t>(std::floor(x / cell_x_)) + (int64_t(1) << 31);
+            auto cy = static_cast<int64_t>(std::floor(y / cell_y_)) + (int64_t(1) << 31);
+            return morton(static_cast<uint32_t>(cx), static_cast<uint32_t>(cy));
+        }
+    }
+
+    // 根据本批次的纬度范围确定网格大小，网格变化时返回 true
+    bool update_cell_size(const std::vector<Point> &points) {
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            double max_lat = 0.;
+            for (const auto &p : points) {
+                max_lat = std::max(max_lat, std::abs(bg::get<1>(p)));
+            }
+            if (cell_x_ > 0. && max_lat <= cell_lat_) {
+                return false;
+            }
+            // 预留 1 度的余量，避免纬度小幅增大时反复重建
+            cell_lat_ = std::min(90., max_lat + 1.);
+            cell_y_ = threshold_ / kMinMetersPerDegree;
+            // 经度方向按网格覆盖的最高纬度（含测地线向极点方向的偏移）放大，靠近极点时整行只有一个网格单元
+            double cos_lat = std::cos(std::min(cell_lat_ + cell_y_, 90.) * M_PI / 180.);
+            cell_x_ = std::min(360., threshold_ / (kMinMetersPerDegree * std::max(cos_lat, 1e-12)));
+            columns_ = std::max<uint32_t>(1, static_cast<uint32_t>(360. / cell_x_));
+            return true;
+        } else {
+            if (cell_x_ > 0.) {
+                return false;
+            }
+            cell_x_ = cell_y_ = threshold_;
+            return true;
+        }
+    }
+
+    void update_grid(const std::vector<Point> &points) {
+        size_t n = points.size();
+        bool rebuild = update_cell_size(points) || n != keys_.size();
+        if (rebuild) {
+            keys_.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                keys_[i] = key_of(points[i]);
+            }
+            order_.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                order_[i] = static_cast<uint32_t>(i);
+            }
+            std::sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) { return less(a, b); });
+            moved_ = n;
+            return;
+        }
+
+        // 增量更新：从原有顺序中取出跨越网格的点，单独排序后归并回去
+        changed_.clear();
+        flags_.assign(n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t key = key_of(points[i]);
+            if (key != keys_[i]) {
+                keys_[i] = key;
+                flags_[i] = 1;
+                changed_.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        moved_ = changed_.size();
+        if (changed_.empty()) {
+            return;
+        }
+        stable_.clear();
+        for (uint32_t i : order_) {
+            if (!flags_[i]) {
+                stable_.push_back(i);
+            }
+        }
+        std::sort(changed_.begin(), changed_.end(), [this](uint32_t a, uint32_t b) { return less(a, b); });
+        std::merge(stable_.begin(), stable_.end(), changed_.begin(), changed_.end(), order_.begin(),
+                   [this](uint32_t a, uint32_t b) { return less(a, b); });
+    }
+
+    // 从第 `g` 个分组出发倍增步长查找网格单元，Morton 码相邻的单元在排序后通常也相距不远
+    const Group *find_group(size_t g, uint64_t key) const {
+        size_t lo, hi;
+        if (key > groups_[g].key) {
+            size_t step = 1;
+            lo = g + 1;
+            while (lo + step - 1 < groups_.size() && groups_[lo + step - 1].key < key) {
+                step <<= 1;
+            }
+            hi = std::min(groups_.size(), lo + step);
+        } else {
+            size_t step = 1;
+            hi = g;
+            while (step <= hi && groups_[hi - step].key > key) {
+                step <<= 1;
+            }
+            lo = step <= hi ? hi - step : 0;
+        }
+        auto it = std::lower_bound(groups_.begin() + lo, groups_.begin() + hi, key,
+                                   [](const Group &x, uint64_t k) { return x.key < k; });
+        return it != groups_.begin() + hi && it->key == key ? &*it : nullptr;
+    }
+
+    // 按网格单元排序，同一单元内按序号排序，保证结果与增量过程无关
+    bool less(uint32_t a, uint32_t b) const { return keys_[a] < keys_[b] || (keys_[a] == keys_[b] && a < b); }
+
+    // 比较排序后的第 i 个与第 j 个点，距离不超过阈值时加入结果
+    void test(uint32_t i, uint32_t j, double timestamp, std::vector<ProximityPair> &out) const {
+        double d = simplegeom::distance(sorted_[i], sorted_[j]);
+        if (d <= threshold_) {
+            out.push_back({std::min(order_[i], order_[j]), std::max(order_[i], order_[j]), d, timestamp});
+        }
+    }
+
+    // 第 `g` 个分组内部以及与右侧、上方相邻分组之间的点对
+    void collect(size_t g, double timestamp, std::vector<ProximityPair> &out) const {
+        const auto &group = groups_[g];
+        for (uint32_t i = group.begin; i < group.end; ++i) {
+            for (uint32_t j = i + 1; j < group.end; ++j) {
+                test(i, j, timestamp, out);
+            }
+        }
+
+        uint32_t cx = compact(group.key), cy = compact(group.key >> 1);
+        const std::pair<int, int> kNeighbors[] = {{1, -1}, {1, 0}, {1, 1}, {0, 1}};
+        for (auto [dx, dy] : kNeighbors) {
+            uint32_t nx = cx + dx, ny = cy + dy;
+            if constexpr (std::is_same_v<Point, PointGeo2>) {
+                // 经度方向首尾相接
+                if (nx == columns_) {
+                    nx = 0;
+                }
+            }
+            uint64_t key = morton(nx, ny);
+            if (key == group.key) {
+                continue;
+            }
+            const Group *neighbor = find_group(g, key);
+            if (neighbor == nullptr) {
+                continue;
+            }
+            for (uint32_t i = group.begin; i < group.end; ++i) {
+                for (uint32_t j = neighbor->begin; j < neighbor->end; ++j) {
+                    test(i, j, timestamp, out);
+                }
+            }
+        }
+    }
+
+    double threshold_;
+    ThreadPool *pool_;
+    double cell_x_ = 0., cell_y_ = 0., cell_lat_ = 0.;
+    uint32_t columns_ = 1;
+    std::vector<uint64_t> keys_;
+    std::vector<Point> sorted_;
+    std::vector<uint32_t> order_, changed_, stable_;
+    std::vector<uint8_t> flags_;
+    std::vector<Group> groups_;
+    size_t moved_ = 0;
+};
+
+}  // namespace simplegeom
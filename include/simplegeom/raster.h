@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+// 折线的栅格化方式
+enum class LineRasterMode {
+    kCoverage,  // 每个像素累加权重乘以折线在像素内的长度（以像素为单位），总量与折线的像素长度成正比
+    kCount,     // 折线经过的每个像素累加一次权重，相邻线段在共享顶点处的同一像素不重复计数
+};
+
+/**
+ * @brief 覆盖 `Box` 的规则栅格，用于累加点与折线的密度（热力图）。
+ *
+ * 栅格按行存放，第 0 行对应外包框的上边（y 最大），第 0 列对应外包框的左边。点落入所在的像素，落在外包框
+ * 右边或上边上的点归入最后一列或第 0 行，外包框之外的点被忽略。折线先裁剪到外包框，再沿像素边界逐格遍历
+ * （Amanatides-Woo 网格遍历，DDA 的一种），不会遗漏折线穿过像素角附近的像素。
+ *
+ * 地理坐标按经纬度线性映射到像素（等距圆柱投影）。外包框的经度范围可以超出 [-180, 180]（如 [170, 190]
+ * 表示跨越反子午线的范围），点的经度会平移 360 度以落入外包框；折线的每条线段沿较短的方向绘制，
+ * 跨越反子午线的线段在两侧都会绘制。
+ *
+ * @tparam Point 二维点类型，`Point2` 或 `PointGeo2`。
+ */
+template <typename Point>
+class Heatmap {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    /**
+     * @param [in] extent 栅格覆盖的范围，不能为空。
+     * @param [in] width 列数。
+     * @param [in] height 行数。
+     */
+    Heatmap(const Box<Point> &extent, size_t width, size_t height)
+        : extent_(extent)
+        , width_(width)
+        , height_(height)
+        , min_x_(bg::get<bg::min_corner, 0>(extent))
+        , max_x_(bg::get<bg::max_corner, 0>(extent))
+        , min_y_(bg::get<bg::min_corner, 1>(extent))
+        , max_y_(bg::get<bg::max_corner, 1>(extent))
+        , cells_(width * height, 0.) {
+        if (width == 0 || height == 0 || !(max_x_ > min_x_) || !(max_y_ > min_y_)) {
+            throw std::invalid_argument("Heatmap: empty extent or size");
+        }
+        scale_x_ = static_cast<double>(width) / (max_x_ - min_x_);
+        scale_y_ = static_cast<double>(height) / (max_y_ - min_y_);
+    }
+
+    const Box<Point> &extent() const { return extent_; }
+    size_t width() const { return width_; }
+    size_t height() const { return height_; }
+
+    // 按行存放的像素值
+    const std::vector<double> &cells() const { return cells_; }
+    double at(size_t column, size_t row) const { return cells_[row * width_ + column]; }
+
+    double total() const {
+        double sum = 0.;
+        for (double v : cells_) {
+            sum += v;
+        }
+        return sum;
+    }
+
+    void clear() { std::fill(cells_.begin(), cells_.end(), 0.); }
+
+    /**
+     * @brief 累加一个点的权重。
+     */
+    void add(const Point &point, double weight = 1.) {
+        double x = bg::get<0>(point);
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            x = x < min_x_ ? x + 360. : (x > max_x_ ? x - 360. : x);
+        }
+        double fx = (x - min_x_) * scale_x_, fy = (max_y_ - bg::get<1>(point)) * scale_y_;
+        // 取反的比较同时排除 NaN
+        if (!(fx >= 0. && fx <= static_cast<double>(width_) && fy >= 0. && fy <= static_cast<double>(height_))) {
+            return;
+        }
+        size_t column = std::min(static_cast<size_t>(fx), width_ - 1);
+        size_t row = std::min(static_cast<size_t>(fy), height_ - 1);
+        cells_[row * width_ + column] += weight;
+    }
+
+    /**
+     * @brief 累加一条折线的权重。
+     *
+     * @param [in] line 折线。
+     * @param [in] weight 权重，例如折线上的交通量。
+     * @param [in] mode 栅格化方式。
+     */
+    void add(const LineString<Point> &line, double weight = 1., LineRasterMode mode = LineRasterMode::kCoverage) {
+        size_t last = cells_.size();  // 上一条线段经过的最后一个像素，用于 `kCount` 去重
+        for (size_t i = 0; i + 1 < line.size(); ++i) {
+            double x0 = bg::get<0>(line[i]), y0 = bg::get<1>(line[i]);
+            double x1 = bg::get<0>(line[i + 1]), y1 = bg::get<1>(line[i + 1]);
+            if constexpr (std::is_same_v<Point, PointGeo2>) {
+                double d = x1 - x0;
+                x1 = x0 + (d > 180. ? d - 360. : (d < -180. ? d + 360. : d));
+                // 线段可能位于外包框的经度范围之外 360 度，三个平移中至多两个与外包框相交
+                for (double shift : {-360., 0., 360.}) {
+                    if (std::max(x0, x1) + shift >= min_x_ && std::min(x0, x1) + shift <= max_x_) {
+                        segment(x0 + shift, y0, x1 + shift, y1, weight, mode, last);
+                    }
+                }
+            } else {
+                segment(x0, y0, x1, y1, weight, mode, last);
+            }
+        }
+        if (line.size() == 1 && mode == LineRasterMode::kCount) {
+            add(line.front(), weight);
+        }
+    }
+
+    /**
+     * @brief 将另一个相同范围与大小的栅格累加到当前栅格。
+     */
+    void merge(const Heatmap &other) { merge(other, 0, cells_.size()); }
+
+    /**
+     * @brief 只累加按行存放的第 [begin, end) 个像素，用于分块并行合并。
+     */
+    void merge(const Heatmap &other, size_t begin, size_t end) {
+        if (other.width_ != width_ || other.height_ != height_) {
+            throw std::invalid_argument("Heatmap: size mismatch");
+        }
+        for (size_t i = begin; i < end; ++i) {
+            cells_[i] += other.cells_[i];
+        }
+    }
+
+private:
+    // 绘制一条线段（外包框坐标），`last` 为上一条线段经过的最后一个像素
+    void segment(double x0, double y0, double x1, double y1, double weight, LineRasterMode mode, size_t &last) {
+        // 转换到像素坐标，y 轴向下
+        double px0 = (x0 - min_x_) * scale_x_, py0 = (max_y_ - y0) * scale_y_;
+        double px1 = (x1 - min_x_) * scale_x_, py1 = (max_y_ - y1) * scale_y_;
+        double dx = px1 - px0, dy = py1 - py0;
+        double w = static_cast<double>(width_), h = static_cast<double>(height_);
+
+        // Liang-Barsky 裁剪到 [0, w] x [0, h]
+        double t0 = 0., t1 = 1.;
+        auto clip = [&](double p, double q) {
+            if (p == 0.) {
+                return q >= 0.;
+            }
+            double r = q / p;
+            if (p < 0.) {
+                t0 = std::max(t0, r);
+            } else {
+                t1 = std::min(t1, r);
+            }
+            return t0 <= t1;
+        };
+        if (!clip(-dx, px0) || !clip(dx, w - px0) || !clip(-dy, py0) || !clip(dy, h - py0)) {
+            return;
+        }
+
+        double sx = px0 + dx * t0, sy = py0 + dy * t0;
+        auto cx = static_cast<int64_t>(std::clamp(std::floor(sx), 0., w - 1.));
+        auto cy = static_cast<int64_t>(std::clamp(std::floor(sy), 0., h - 1.));
+        // 沿线段方向的下一条像素边界对应的参数，以及跨过一个像素对应的参数增量
+        int64_t step_x = dx > 0. ? 1 : -1, step_y = dy > 0. ? 1 : -1;
+        double inf = std::numeric_limits<double>::infinity();
+        double next_x = dx == 0. ? inf : ((dx > 0. ? cx + 1 : cx) - px0) / dx;
+        double next_y = dy == 0. ? inf : ((dy > 0. ? cy + 1 : cy) - py0) / dy;
+        double delta_x = dx == 0. ? inf : 1. / std::abs(dx), delta_y = dy == 0. ? inf : 1. / std::abs(dy);
+        double length = std::sqrt(dx * dx + dy * dy);
+
+        double t = t0;
+        for (;;) {
+            double t_next = std::min({next_x, next_y, t1});
+            auto index = static_cast<size_t>(cy) * width_ + static_cast<size_t>(cx);
+            if (mode == LineRasterMode::kCoverage) {
+                cells_[index] += weight * (t_next - t) * length;
+            } else if (index != last && t_next > t) {
+                // 只经过像素边界或角点的像素不计数
+                cells_[index] += weight;
+                last = index;
+            }
+            if (t_next >= t1) {
+                break;
+            }
+            if (next_x <= next_y) {
+                cx += step_x;
+                next_x += delta_x;
+            } else {
+                cy += step_y;
+                next_y += delta_y;
+            }
+            if (cx < 0 || cy < 0 || cx >= static_cast<int64_t>(width_) || cy >= static_cast<int64_t>(height_)) {
+                break;
+            }
+            t = t_next;
+        }
+    }
+
+    Box<Point> extent_;
+    size_t width_, height_;
+    double min_x_, max_x_, min_y_, max_y_;
+    double scale_x_ = 0., scale_y_ = 0.;
+    std::vector<double> cells_;
+};
+
+namespace raster_detail {
+
+/**
+ * @brief 将 [0, n) 划分为与线程数相同的若干段并行累加，最后按像素分块并行合并。
+ *
+ * 第一段直接累加到 `heatmap`，其余各段累加到各自独立的栅格中，累加过程不需要同步；合并的代价与像素数成正比，
+ * 与输入规模无关。每段至少包含 `min_slice` 个输入，避免输入较少时分配与合并栅格的代价超过累加本身。
+ */
+template <typename Point, typename Func>
+void accumulate(Heatmap<Point> &heatmap, size_t n, size_t min_slice, ThreadPool *pool, Func &&func) {
+    size_t slices = pool == nullptr ? 1 : std::max<size_t>(1, std::min(pool->size(), n / min_slice));
+    if (slices == 1) {
+        func(heatmap, 0, n);
+        return;
+    }
+
+    std::vector<Heatmap<Point>> tiles;
+    tiles.reserve(slices - 1);
+    for (size_t s = 1; s < slices; ++s) {
+        tiles.emplace_back(heatmap.extent(), heatmap.width(), heatmap.height());
+    }
+    parallel_for(
+        pool, slices,
+        [&](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; ++s) {
+                func(s == 0 ? heatmap : tiles[s - 1], n * s / slices, n * (s + 1) / slices);
+            }
+        },
+        1);
+    parallel_for(pool, heatmap.cells().size(), [&](size_t begin, size_t end) {
+        for (const auto &tile : tiles) {
+            heatmap.merge(tile, begin, end);
+        }
+    });
+}
+
+}  // namespace raster_detail
+
+/**
+ * @brief 将点累加到热力图中。
+ *
+ * @param [in,out] heatmap 热力图，已有的值会保留，多次调用可以累加多批点。
+ * @param [in] points 点集合。
+ * @param [in] weights 各点的权重，为空时每个点的权重为 1。
+ * @param [in] pool 线程池，为空时在当前线程中计算。使用 k 个线程时额外分配 k - 1 个与 `heatmap` 大小相同的栅格。
+ */
+template <typename Point>
+void rasterize_points(Heatmap<Point> &heatmap, const std::vector<Point> &points,
+                      const std::vector<double> &weights = {}, ThreadPool *pool = nullptr) {
+    raster_detail::accumulate(heatmap, points.size(), 65536, pool, [&](Heatmap<Point> &tile, size_t begin, size_t end) {
+        if (weights.empty()) {
+            for (size_t i = begin; i < end; ++i) {
+                tile.add(points[i]);
+            }
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                tile.add(points[i], weights[i]);
+            }
+        }
+    });
+}
+
+/**
+ * @brief 将折线累加到热力图中，参数与 `rasterize_points` 相同。
+ */
+template <typename Point>
+void rasterize_lines(Heatmap<Point> &heatmap, const std::vector<LineString<Point>> &lines,
+                     const std::vector<double> &weights = {}, LineRasterMode mode = LineRasterMode::kCoverage,
+                     ThreadPool *pool = nullptr) {
+    raster_detail::accumulate(heatmap, lines.size(), 256, pool, [&](Heatmap<Point> &tile, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            tile.add(lines[i], weights.empty() ? 1. : weights[i], mode);
+        }
+    });
+}
+
+}  // namespace simplegeom
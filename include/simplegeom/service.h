@@ -0,0 +1,601 @@
+#pragma once
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "simplegeom/network.h"
+#include "simplegeom/trace.h"
+
+namespace simplegeom {
+
+/**
+ * 投影服务的二进制协议（本机字节序，仅用于同一主机上的进程间通信）：
+ *
+ * 请求：`ProjectionRequestHeader` + `count` 个 `double[2]` 坐标。
+ * 响应：`ProjectionResponseHeader` + `count` 个 `ProjectionRecord`，顺序与请求中的点一致。
+ *
+ * 同一连接上可以连续发送多个请求，服务端按请求顺序返回响应。
+ */
+static constexpr uint32_t kProjectionServiceMagic = 0x53475031;  // "SGP1"
+
+struct ProjectionRequestHeader {
+    uint32_t magic = kProjectionServiceMagic;
+    uint32_t count = 0;  // 请求中点的数量
+    uint32_t mode = 0;   // `ProjectionMode` 的取值
+    uint32_t reserved = 0;
+};
+
+struct ProjectionResponseHeader {
+    uint32_t magic = kProjectionServiceMagic;
+    uint32_t count = 0;
+};
+
+struct ProjectionRecord {
+    uint64_t line_id;
+    double distance;
+    double project_distance;
+};
+
+namespace service_detail {
+
+inline std::system_error last_error(const char *what) {
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+// 文件描述符的所有权，析构时关闭
+class FileDescriptor {
+public:
+    FileDescriptor() = default;
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+
+    ~FileDescriptor() { reset(); }
+
+    FileDescriptor(FileDescriptor &&other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+
+    FileDescriptor &operator=(FileDescriptor &&other) noexcept {
+        if (this != &other) {
+            reset();
+            fd_ = std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+
+    void reset() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int get() const { return fd_; }
+
+private:
+    int fd_ = -1;
+};
+
+inline sockaddr_un make_address(const std::string &path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("socket path too long: " + path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+/**
+ * @brief 删除上次运行残留的套接字文件。
+ *
+ * 路径不存在时直接返回；路径不是套接字，或者仍有服务在该套接字上监听时抛出异常，避免删除其他进程的文件。
+ */
+inline void remove_stale_socket(const std::string &path, const sockaddr_un &addr) {
+    struct stat st;
+    if (::lstat(path.c_str(), &st) != 0) {
+        if (errno == ENOENT) {
+            return;
+        }
+        throw last_error("lstat");
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        throw std::runtime_error("socket path exists and is not a socket: " + path);
+    }
+    FileDescriptor probe(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (probe.get() < 0) {
+        throw last_error("socket");
+    }
+    if (::connect(probe.get(), reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) == 0) {
+        throw std::runtime_error("socket path is in use by a running server: " + path);
+    }
+    // 只有确认没有进程在监听（ECONNREFUSED）时才删除
+    if (errno == ENOENT) {
+        return;
+    }
+    if (errno != ECONNREFUSED) {
+        throw last_error("connect");
+    }
+    if (::unlink(path.c_str()) != 0 && errno != ENOENT) {
+        throw last_error("unlink");
+    }
+}
+
+inline void write_all(int fd, const void *data, size_t size) {
+    auto ptr = static_cast<const char *>(data);
+    while (size > 0) {
+        ssize_t n = ::send(fd, ptr, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw last_error("send");
+        }
+        ptr += n;
+        size -= static_cast<size_t>(n);
+    }
+}
+
+inline void read_all(int fd, void *data, size_t size) {
+    auto ptr = static_cast<char *>(data);
+    while (size > 0) {
+        ssize_t n = ::recv(fd, ptr, size, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw last_error("recv");
+        }
+        if (n == 0) {
+            throw std::runtime_error("connection closed by peer");
+        }
+        ptr += n;
+        size -= static_cast<size_t>(n);
+    }
+}
+
+}  // namespace service_detail
+
+// 投影服务的配置项
+struct ProjectionServerOptions {
+    std::string socket_path;                                           // Unix 域套接字路径
+    std::chrono::microseconds batch_window{200};                       // 批处理窗口：首个请求到达后最多等待的时间
+    size_t max_batch_points = 16384;                                   // 累积点数达到该值时立即处理
+    size_t num_threads = 0;                                            // 计算线程数，为 0 时使用硬件并发数
+    double search_radius = LineNetwork<Point2>::kDefaultSearchRadius;  // 候选折线的搜索框边长
+    std::string trace_path;                                            // 非空时将采样的请求点记录到该调用轨迹文件
+    double trace_sample_rate = 0.01;                                   // 调用轨迹的采样率
+    size_t max_request_points = size_t(1) << 20;                       // 单个请求的最大点数，超过时关闭连接
+    size_t max_output_bytes = size_t(64) << 20;                        // 连接待发送的字节数超过该值时暂停读取
+};
+
+/**
+ * @brief 基于 Unix 域套接字的投影服务。
+ *
+ * 一个进程持有线网及其索引，其他进程通过 `ProjectionClient` 发送批量投影请求。服务端在单个 I/O 线程中
+ * 使用 `ppoll` 处理所有连接，将批处理窗口内到达的请求合并为一次 `project_batch` 调用并在线程池上并行计算。
+ * `batch_window` 越大，合并后的批次越大、吞吐越高，但单个请求的延迟也越大。
+ *
+ * 客户端关闭写方向（或关闭连接）后，服务端仍会处理已经完整收到的请求并发送响应，然后再关闭连接。
+ * 某个连接待发送的响应超过 `max_output_bytes` 时暂停读取该连接，直到客户端取走响应。
+ *
+ * @tparam Point 二维点类型，通常为 `PointGeo2`。
+ */
+template <typename Point>
+class ProjectionServer {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    ProjectionServer(const LineNetwork<Point> &network, ProjectionServerOptions options)
+        : network_(network), options_(std::move(options)), pool_(options_.num_threads) {
+        // 文件描述符由 `FileDescriptor` 持有，构造函数中途抛出异常时已经打开的描述符会被关闭
+        int wake[2];
+        if (::pipe(wake) != 0) {
+            throw service_detail::last_error("pipe");
+        }
+        wake_read_ = service_detail::FileDescriptor(wake[0]);
+        wake_write_ = service_detail::FileDescriptor(wake[1]);
+        set_nonblocking(wake_read_.get());
+
+        auto addr = service_detail::make_address(options_.socket_path);
+        listen_fd_ = service_detail::FileDescriptor(::socket(AF_UNIX, SOCK_STREAM, 0));
+        if (listen_fd_.get() < 0) {
+            throw service_detail::last_error("socket");
+        }
+        service_detail::remove_stale_socket(options_.socket_path, addr);
+        if (::bind(listen_fd_.get(), reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            throw service_detail::last_error("bind");
+        }
+        // 绑定之后失败时删除刚创建的套接字文件，析构函数不会被调用
+        try {
+            if (::listen(listen_fd_.get(), SOMAXCONN) != 0) {
+                throw service_detail::last_error("listen");
+            }
+            set_nonblocking(listen_fd_.get());
+
+            if (!options_.trace_path.empty()) {
+                trace_ = std::make_unique<TraceRecorder>(options_.trace_path, options_.trace_sample_rate);
+            }
+        } catch (...) {
+            ::unlink(options_.socket_path.c_str());
+            throw;
+        }
+    }
+
+    ~ProjectionServer() { ::unlink(options_.socket_path.c_str()); }
+
+    ProjectionServer(const ProjectionServer &) = delete;
+    ProjectionServer &operator=(const ProjectionServer &) = delete;
+
+    /**
+     * @brief 运行事件循环，直到 `stop` 被调用。
+     */
+    void run() {
+        std::vector<pollfd> fds;
+        std::vector<uint64_t> ids;
+        while (!stopped_.load(std::memory_order_acquire)) {
+            fds.clear();
+            ids.clear();
+            fds.push_back({wake_read_.get(), POLLIN, 0});
+            fds.push_back({listen_fd_.get(), POLLIN, 0});
+            for (auto &[id, conn] : connections_) {
+                // 待发送的响应过多时不再读取新的请求，由客户端的接收速度反压
+                short events = 0;
+                if (!conn.eof && conn.out.size() - conn.out_offset <= options_.max_output_bytes) {
+                    events |= POLLIN;
+                }
+                if (conn.out.size() > conn.out_offset) {
+                    events |= POLLOUT;
+                }
+                fds.push_back({conn.fd.get(), events, 0});
+                ids.push_back(id);
+            }
+
+            // 批处理窗口通常为微秒级，使用 `ppoll` 以获得比毫秒更细的超时精度
+            timespec timeout{};
+            timespec *timeout_ptr = nullptr;
+            if (!pending_.empty()) {
+                auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    deadline_ - std::chrono::steady_clock::now());
+                auto ns = std::max<int64_t>(0, remaining.count());
+                timeout.tv_sec = static_cast<time_t>(ns / 1000000000);
+                timeout.tv_nsec = static_cast<long>(ns % 1000000000);
+                timeout_ptr = &timeout;
+            }
+
+            if (::ppoll(fds.data(), fds.size(), timeout_ptr, nullptr) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw service_detail::last_error("ppoll");
+            }
+
+            if (fds[1].revents & POLLIN) {
+                accept_connections();
+            }
+            for (size_t i = 2; i < fds.size(); ++i) {
+                auto it = connections_.find(ids[i - 2]);
+                if ((fds[i].events & POLLIN) && (fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    if (!read_connection(it->first, it->second)) {
+                        connections_.erase(it);
+                        continue;
+                    }
+                }
+                if (fds[i].revents & (POLLOUT | POLLERR)) {
+                    if (!flush_connection(it->second)) {
+                        connections_.erase(it);
+                        continue;
+                    }
+                }
+                if (finished(it->second)) {
+                    connections_.erase(it);
+                }
+            }
+
+            if (!pending_.empty() &&
+                (pending_points_ >= options_.max_batch_points || std::chrono::steady_clock::now() >= deadline_)) {
+                process_batch();
+            }
+        }
+    }
+
+    /**
+     * @brief 请求事件循环退出，可以在其他线程或信号处理函数中调用。
+     */
+    void stop() {
+        stopped_.store(true, std::memory_order_release);
+        char c = 0;
+        [[maybe_unused]] auto n = ::write(wake_write_.get(), &c, 1);
+    }
+
+    // 已处理的批次数和点数，用于观察批处理效果
+    size_t batches() const { return batches_; }
+    size_t points() const { return points_; }
+
+    // 已记录到调用轨迹中的点数，未开启记录时为 0
+    size_t traced() const { return trace_ ? trace_->recorded() : 0; }
+
+private:
+    struct Connection {
+        service_detail::FileDescriptor fd;
+        std::vector<char> in;
+        std::vector<char> out;
+        size_t out_offset = 0;
+        size_t pending = 0;  // 已解析、尚未生成响应的请求数
+        bool eof = false;    // 客户端已关闭写方向
+    };
+
+    struct PendingRequest {
+        uint64_t connection_id;
+        ProjectionMode mode;
+        size_t offset;  // 在 `pending_coords_` 中的起始点下标
+        size_t count;
+    };
+
+    static void set_nonblocking(int fd) {
+        int flags = ::fcntl(fd, F_GETFL, 0);
+        if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) {
+            throw service_detail::last_error("fcntl");
+        }
+    }
+
+    void accept_connections() {
+        for (;;) {
+            service_detail::FileDescriptor fd(::accept(listen_fd_.get(), nullptr, nullptr));
+            if (fd.get() < 0) {
+                return;
+            }
+            set_nonblocking(fd.get());
+            connections_[next_connection_id_++].fd = std::move(fd);
+        }
+    }
+
+    // 客户端已关闭写方向，并且所有请求的响应都已发送完毕
+    static bool finished(const Connection &conn) {
+        return conn.eof && conn.pending == 0 && conn.out_offset == conn.out.size();
+    }
+
+    bool read_connection(uint64_t connection_id, Connection &conn) {
+        // 缓冲区中已经可以容纳一个最大的请求时先解析，剩余数据留到下一轮读取
+        size_t limit = sizeof(ProjectionRequestHeader) + options_.max_request_points * 2 * sizeof(double);
+        char buffer[65536];
+        while (conn.in.size() < limit) {
+            ssize_t n = ::recv(conn.fd.get(), buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                conn.in.insert(conn.in.end(), buffer, buffer + n);
+                continue;
+            }
+            if (n == 0) {
+                // 对端关闭写方向：先处理已经完整收到的请求，响应发送完毕后再关闭连接
+                conn.eof = true;
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return false;
+        }
+        return parse_requests(connection_id, conn);
+    }
+
+    bool parse_requests(uint64_t connection_id, Connection &conn) {
+        size_t offset = 0;
+        while (conn.in.size() - offset >= sizeof(ProjectionRequestHeader)) {
+            ProjectionRequestHeader header;
+            std::memcpy(&header, conn.in.data() + offset, sizeof(header));
+            if (header.magic != kProjectionServiceMagic ||
+                header.mode > static_cast<uint32_t>(ProjectionMode::kAccumulate) ||
+                header.count > options_.max_request_points) {
+                return false;
+            }
+            size_t body = size_t(header.count) * 2 * sizeof(double);
+            if (conn.in.size() - offset - sizeof(header) < body) {
+                break;
+            }
+            const char *coords = conn.in.data() + offset + sizeof(header);
+            if (pending_.empty()) {
+                deadline_ = std::chrono::steady_clock::now() + options_.batch_window;
+            }
+            pending_.push_back({connection_id, static_cast<ProjectionMode>(header.mode), pending_coords_.size(),
+                                header.count});
+            for (size_t i = 0; i < header.count; ++i) {
+                double xy[2];
+                std::memcpy(xy, coords + i * sizeof(xy), sizeof(xy));
+                pending_coords_.emplace_back(xy[0], xy[1]);
+                if (trace_) {
+                    trace_->record_projection(pending_coords_.back(), static_cast<ProjectionMode>(header.mode));
+                }
+            }
+            pending_points_ += header.count;
+            ++conn.pending;
+            offset += sizeof(header) + body;
+        }
+        conn.in.erase(conn.in.begin(), conn.in.begin() + offset);
+        return true;
+    }
+
+    bool flush_connection(Connection &conn) {
+        while (conn.out_offset < conn.out.size()) {
+            ssize_t n = ::send(conn.fd.get(), conn.out.data() + conn.out_offset, conn.out.size() - conn.out_offset,
+                               MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            conn.out_offset += static_cast<size_t>(n);
+        }
+        conn.out.clear();
+        conn.out_offset = 0;
+        return true;
+    }
+
+    void process_batch() {
+        // 同一批次内的请求可能使用不同的投影模式，按模式分别计算
+        std::vector<NetworkProjection> results(pending_coords_.size());
+        for (auto mode : {ProjectionMode::kSimple, ProjectionMode::kAccumulate}) {
+            std::vector<size_t> indices;
+            for (const auto &request : pending_) {
+                if (request.mode == mode) {
+                    for (size_t i = 0; i < request.count; ++i) {
+                        indices.push_back(request.offset + i);
+                    }
+                }
+            }
+            parallel_for(&pool_, indices.size(), [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    size_t k = indices[i];
+                    results[k] = network_.project(pending_coords_[k], mode, options_.search_radius);
+                }
+            });
+        }
+
+        for (const auto &request : pending_) {
+            auto it = connections_.find(request.connection_id);
+            if (it == connections_.end()) {
+                continue;
+            }
+            --it->second.pending;
+            auto &out = it->second.out;
+            ProjectionResponseHeader header;
+            header.count = static_cast<uint32_t>(request.count);
+            append(out, &header, sizeof(header));
+            for (size_t i = 0; i < request.count; ++i) {
+                const auto &r = results[request.offset + i];
+                ProjectionRecord record{static_cast<uint64_t>(r.line_id), r.distance, r.project_distance};
+                append(out, &record, sizeof(record));
+            }
+        }
+        for (auto it = connections_.begin(); it != connections_.end();) {
+            auto current = it++;
+            if (!flush_connection(current->second) || finished(current->second)) {
+                connections_.erase(current);
+            }
+        }
+
+        ++batches_;
+        points_ += pending_points_;
+        pending_.clear();
+        pending_coords_.clear();
+        pending_points_ = 0;
+    }
+
+    static void append(std::vector<char> &out, const void *data, size_t size) {
+        auto ptr = static_cast<const char *>(data);
+        out.insert(out.end(), ptr, ptr + size);
+    }
+
+    const LineNetwork<Point> &network_;
+    ProjectionServerOptions options_;
+    ThreadPool pool_;
+    std::unique_ptr<TraceRecorder> trace_;
+
+    service_detail::FileDescriptor listen_fd_;
+    service_detail::FileDescriptor wake_read_;
+    service_detail::FileDescriptor wake_write_;
+    std::atomic<bool> stopped_{false};
+
+    std::map<uint64_t, Connection> connections_;
+    uint64_t next_connection_id_ = 0;
+
+    std::vector<PendingRequest> pending_;
+    std::vector<Point> pending_coords_;
+    size_t pending_points_ = 0;
+    std::chrono::steady_clock::time_point deadline_;
+
+    size_t batches_ = 0;
+    size_t points_ = 0;
+};
+
+/**
+ * @brief 投影服务的客户端，每个实例持有一个连接，不是线程安全的。
+ *
+ * @tparam Point 二维点类型，需要与服务端一致。
+ */
+template <typename Point>
+class ProjectionClient {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    explicit ProjectionClient(const std::string &socket_path) {
+        auto addr = service_detail::make_address(socket_path);
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd_ < 0) {
+            throw service_detail::last_error("socket");
+        }
+        if (::connect(fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            ::close(fd_);
+            throw service_detail::last_error("connect");
+        }
+    }
+
+    ~ProjectionClient() { ::close(fd_); }
+
+    ProjectionClient(const ProjectionClient &) = delete;
+    ProjectionClient &operator=(const ProjectionClient &) = delete;
+
+    /**
+     * @brief 发送一批点并等待投影结果。
+     *
+     * @param [in] points 要投影的点集。
+     * @param [in] mode 投影模式。
+     * @return std::vector<NetworkProjection> 与输入一一对应的投影结果。
+     */
+    std::vector<NetworkProjection> project(const std::vector<Point> &points, ProjectionMode mode) {
+        if (points.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::invalid_argument("too many points in one projection request");
+        }
+        ProjectionRequestHeader header;
+        header.count = static_cast<uint32_t>(points.size());
+        header.mode = static_cast<uint32_t>(mode);
+
+        buffer_.resize(sizeof(header) + points.size() * 2 * sizeof(double));
+        std::memcpy(buffer_.data(), &header, sizeof(header));
+        auto coords = reinterpret_cast<double *>(buffer_.data() + sizeof(header));
+        for (size_t i = 0; i < points.size(); ++i) {
+            coords[2 * i] = bg::get<0>(points[i]);
+            coords[2 * i + 1] = bg::get<1>(points[i]);
+        }
+        service_detail::write_all(fd_, buffer_.data(), buffer_.size());
+
+        ProjectionResponseHeader response;
+        service_detail::read_all(fd_, &response, sizeof(response));
+        if (response.magic != kProjectionServiceMagic || response.count != header.count) {
+            throw std::runtime_error("malformed projection response");
+        }
+        std::vector<ProjectionRecord> records(response.count);
+        service_detail::read_all(fd_, records.data(), records.size() * sizeof(ProjectionRecord));
+
+        std::vector<NetworkProjection> results(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            results[i].line_id = static_cast<size_t>(records[i].line_id);
+            results[i].distance = records[i].distance;
+            results[i].project_distance = records[i].project_distance;
+        }
+        return results;
+    }
+
+private:
+    int fd_ = -1;
+    std::vector<char> buffer_;
+};
+
+}  // namespace simplegeom
@@ -0,0 +1,527 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "simplegeom/network.h"
+
+namespace simplegeom {
+
+/**
+ * 共享内存线网的布局。
+ *
+ * 每个主机上的线网只存放一份：控制段 `<name>` 记录当前版本号，数据段 `<name>.<version>` 保存某个版本的全部数据。
+ * 数据段中的所有结构只使用相对于段起始地址的偏移量，不包含任何指针，因此可以被映射到任意进程的任意地址。
+ *
+ * 数据段布局（每个数组按 64 字节对齐）：
+ *   SharedNetworkHeader
+ *   uint64_t  line_offsets[num_lines + 1]     第 i 条折线的顶点区间为 [line_offsets[i], line_offsets[i + 1])
+ *   Point     points[num_points]              所有折线的顶点
+ *   double    cumulative_lengths[num_points]  与顶点一一对应的累积长度
+ *   Box<Point> envelopes[num_lines]           每条折线的外包框
+ *   uint64_t  cell_offsets[grid_x * grid_y + 1]  网格索引：第 c 个单元格的折线区间
+ *   uint32_t  cell_lines[...]                 网格索引：各单元格覆盖的折线编号
+ *
+ * 地理坐标的网格在经度方向按 360 度周期取模：跨越反子午线的外包框与查询框会同时落到网格两端的单元格。
+ */
+struct SharedNetworkHeader {
+    static constexpr uint64_t kMagic = 0x534750534e455431;  // "SGPSNET1"
+
+    uint64_t magic;
+    uint32_t point_size;  // sizeof(Point)，用于校验读写双方的点类型一致
+    uint32_t dimension;
+    uint64_t version;
+    uint64_t total_size;
+
+    uint64_t num_lines;
+    uint64_t num_points;
+
+    uint64_t line_offsets_offset;
+    uint64_t points_offset;
+    uint64_t cumulative_lengths_offset;
+    uint64_t envelopes_offset;
+
+    double grid_min_x;
+    double grid_min_y;
+    double grid_cell_width;
+    double grid_cell_height;
+    uint32_t grid_x;
+    uint32_t grid_y;
+    uint64_t cell_offsets_offset;
+    uint64_t cell_lines_offset;
+};
+
+namespace shared_detail {
+
+static constexpr uint64_t kControlMagic = 0x53475053434e5431;  // "SGPSCNT1"
+
+// 控制段，只保存版本信息
+struct ControlBlock {
+    std::atomic<uint64_t> magic;
+    std::atomic<uint64_t> current_version;  // 当前生效的版本，0 表示尚未发布
+    std::atomic<uint64_t> next_version;     // 用于分配新版本号
+};
+
+inline std::system_error last_error(const std::string &what) {
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+inline size_t align_up(size_t n) { return (n + 63) & ~size_t(63); }
+
+inline std::string data_segment_name(const std::string &name, uint64_t version) {
+    return name + "." + std::to_string(version);
+}
+
+/**
+ * @brief 计算坐标区间 [lo, hi] 在一个方向上覆盖的单元格区间，对每一段调用 `visit(first, last)`。
+ *
+ * 网格从 `origin` 开始，共 `n` 个边长为 `size` 的单元格。`periodic` 为真时（地理坐标的经度）坐标按 360 度
+ * 取模，跨越反子午线的区间最多产生两段，完全落在网格之外的区间不产生单元格；否则超出网格的部分截断到边缘的
+ * 单元格。
+ */
+template <typename Visit>
+void for_each_cell_span(double lo, double hi, double origin, double size, uint32_t n, bool periodic, Visit &&visit) {
+    auto cell = [&](double v) { return static_cast<uint32_t>(std::clamp(v / size, 0., static_cast<double>(n - 1))); };
+    if (!periodic) {
+        visit(cell(lo - origin), cell(hi - origin));
+        return;
+    }
+    if (hi - lo >= 360.) {
+        visit(0, n - 1);
+        return;
+    }
+    double extent = size * n;
+    double begin = lo - origin;
+    begin -= 360. * std::floor(begin / 360.);
+    double end = begin + (hi - lo);
+    // [begin, end] 与网格的两个周期 [0, extent]、[360, 360 + extent] 的交集
+    bool first = begin <= extent, second = end >= 360.;
+    if (first && second && cell(end - 360.) + 1 >= cell(begin)) {
+        visit(0, n - 1);
+        return;
+    }
+    if (first) {
+        visit(cell(begin), cell(end));
+    }
+    if (second) {
+        visit(0, cell(end - 360.));
+    }
+}
+
+// 对外包框覆盖的每个单元格调用 `visit(cell)`，发布与查询使用同一套规则
+template <typename Point, typename Visit>
+void for_each_cell(const SharedNetworkHeader &h, const Box<Point> &box, Visit &&visit) {
+    uint32_t y0 = 0, y1 = 0;
+    for_each_cell_span(bg::get<bg::min_corner, 1>(box), bg::get<bg::max_corner, 1>(box), h.grid_min_y,
+                       h.grid_cell_height, h.grid_y, false, [&](uint32_t first, uint32_t last) {
+                           y0 = first;
+                           y1 = last;
+                       });
+    auto visit_columns = [&](uint32_t x0, uint32_t x1) {
+        for (uint32_t y = y0; y <= y1; ++y) {
+            for (uint32_t x = x0; x <= x1; ++x) {
+                visit(size_t(y) * h.grid_x + x);
+            }
+        }
+    };
+    for_each_cell_span(bg::get<bg::min_corner, 0>(box), bg::get<bg::max_corner, 0>(box), h.grid_min_x,
+                       h.grid_cell_width, h.grid_x, std::is_same_v<Point, PointGeo2>, visit_columns);
+}
+
+// 共享内存段的映射，析构时解除映射
+class Mapping {
+public:
+    Mapping() = default;
+
+    Mapping(const std::string &name, bool writable, bool create, size_t size = 0) {
+        int flags = writable ? O_RDWR : O_RDONLY;
+        if (create) {
+            flags |= O_CREAT;
+        }
+        int fd = ::shm_open(name.c_str(), flags, 0644);
+        if (fd < 0) {
+            throw last_error("shm_open " + name);
+        }
+        if (create && ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            throw last_error("ftruncate " + name);
+        }
+        if (!create) {
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw last_error("fstat " + name);
+            }
+            size = static_cast<size_t>(st.st_size);
+        }
+        int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *addr = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            throw last_error("mmap " + name);
+        }
+        addr_ = addr;
+        size_ = size;
+    }
+
+    ~Mapping() { reset(); }
+
+    Mapping(Mapping &&other) noexcept : addr_(other.addr_), size_(other.size_) {
+        other.addr_ = nullptr;
+        other.size_ = 0;
+    }
+
+    Mapping &operator=(Mapping &&other) noexcept {
+        if (this != &other) {
+            reset();
+            std::swap(addr_, other.addr_);
+            std::swap(size_, other.size_);
+        }
+        return *this;
+    }
+
+    void reset() {
+        if (addr_ != nullptr) {
+            ::munmap(addr_, size_);
+            addr_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    char *data() const { return static_cast<char *>(addr_); }
+    size_t size() const { return size_; }
+
+private:
+    void *addr_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief 打开或创建控制段。新建的段由 `ftruncate` 清零，版本号为 0。
+ */
+inline Mapping open_control(const std::string &name, bool create) {
+    Mapping control(name, create, create, sizeof(ControlBlock));
+    if (control.size() < sizeof(ControlBlock)) {
+        throw std::runtime_error("invalid shared network control segment: " + name);
+    }
+    auto block = reinterpret_cast<ControlBlock *>(control.data());
+    if (create) {
+        uint64_t expected = 0;
+        // 多个发布者同时创建时只有一个会写入魔数
+        block->magic.compare_exchange_strong(expected, kControlMagic);
+    }
+    if (block->magic.load(std::memory_order_acquire) != kControlMagic) {
+        throw std::runtime_error("invalid shared network control segment: " + name);
+    }
+    return control;
+}
+
+}  // namespace shared_detail
+
+/**
+ * @brief 将线网发布到命名的 POSIX 共享内存中，并切换为当前版本。
+ *
+ * 函数会创建新的数据段 `<name>.<version>`，写入全部数据后原子地更新控制段中的版本号，
+ * 然后删除上一个版本的数据段名称。已经映射旧版本的进程仍可以继续使用旧数据，直到它们调用 `refresh`。
+ * 多个进程并发发布时版本号只会增大：版本号更大的发布先生效时，本次发布的数据段直接删除，不会覆盖更新的版本。
+ *
+ * @tparam Point 二维点类型，需要是平凡可复制的类型。
+ * @param [in] name 共享内存名称，需要以 `/` 开头，例如 `/simplegeom_roads`。
+ * @param [in] network 要发布的线网。
+ * @return uint64_t 新发布的版本号。
+ */
+template <typename Point>
+uint64_t publish_shared_network(const std::string &name, const LineNetwork<Point> &network) {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+    static_assert(std::is_trivially_copyable_v<Point>, "Point must be trivially copyable");
+
+    size_t num_lines = network.size();
+    size_t num_points = 0;
+    for (const auto &line : network.lines()) {
+        num_points += line.size();
+    }
+
+    // 网格索引：按折线数量确定分辨率，使每个单元格平均覆盖少量折线
+    std::vector<Box<Point>> envelopes(num_lines);
+    double min_x = std::numeric_limits<double>::max(), min_y = std::numeric_limits<double>::max();
+    double max_x = std::numeric_limits<double>::lowest(), max_y = std::numeric_limits<double>::lowest();
+    for (size_t id = 0; id < num_lines; ++id) {
+        if (!network.line(id).empty()) {
+            bg::envelope(network.line(id), envelopes[id]);
+            min_x = std::min(min_x, bg::get<bg::min_corner, 0>(envelopes[id]));
+            min_y = std::min(min_y, bg::get<bg::min_corner, 1>(envelopes[id]));
+            max_x = std::max(max_x, bg::get<bg::max_corner, 0>(envelopes[id]));
+            max_y = std::max(max_y, bg::get<bg::max_corner, 1>(envelopes[id]));
+        }
+    }
+    uint32_t grid_x = 1, grid_y = 1;
+    double cell_width = 1., cell_height = 1.;
+    if (num_points > 0) {
+        auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(num_lines))));
+        grid_x = grid_y = std::clamp<uint32_t>(side, 1, 4096);
+        cell_width = std::max(max_x - min_x, 1e-9) / grid_x;
+        cell_height = std::max(max_y - min_y, 1e-9) / grid_y;
+    } else {
+        min_x = min_y = 0.;
+    }
+
+    SharedNetworkHeader header{};
+    header.magic = SharedNetworkHeader::kMagic;
+    header.point_size = sizeof(Point);
+    header.dimension = bg::dimension<Point>::value;
+    header.num_lines = num_lines;
+    header.num_points = num_points;
+    header.grid_min_x = min_x;
+    header.grid_min_y = min_y;
+    header.grid_cell_width = cell_width;
+    header.grid_cell_height = cell_height;
+    header.grid_x = grid_x;
+    header.grid_y = grid_y;
+
+    std::vector<uint64_t> cell_offsets(size_t(grid_x) * grid_y + 1, 0);
+    for (size_t id = 0; id < num_lines; ++id) {
+        if (network.line(id).empty()) {
+            continue;
+        }
+        shared_detail::for_each_cell(header, envelopes[id], [&](size_t c) { ++cell_offsets[c + 1]; });
+    }
+    for (size_t c = 1; c < cell_offsets.size(); ++c) {
+        cell_offsets[c] += cell_offsets[c - 1];
+    }
+    std::vector<uint32_t> cell_lines(cell_offsets.back());
+    std::vector<uint64_t> cursor(cell_offsets.begin(), cell_offsets.end() - 1);
+    for (size_t id = 0; id < num_lines; ++id) {
+        if (network.line(id).empty()) {
+            continue;
+        }
+        shared_detail::for_each_cell(header, envelopes[id],
+                                     [&](size_t c) { cell_lines[cursor[c]++] = static_cast<uint32_t>(id); });
+    }
+
+    size_t offset = shared_detail::align_up(sizeof(SharedNetworkHeader));
+    auto place = [&offset](uint64_t &field, size_t bytes) {
+        field = offset;
+        offset = shared_detail::align_up(offset + bytes);
+    };
+    place(header.line_offsets_offset, (num_lines + 1) * sizeof(uint64_t));
+    place(header.points_offset, num_points * sizeof(Point));
+    place(header.cumulative_lengths_offset, num_points * sizeof(double));
+    place(header.envelopes_offset, num_lines * sizeof(Box<Point>));
+    place(header.cell_offsets_offset, cell_offsets.size() * sizeof(uint64_t));
+    place(header.cell_lines_offset, cell_lines.size() * sizeof(uint32_t));
+    header.total_size = offset;
+
+    auto control = shared_detail::open_control(name, true);
+    auto block = reinterpret_cast<shared_detail::ControlBlock *>(control.data());
+    header.version = block->next_version.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    auto segment_name = shared_detail::data_segment_name(name, header.version);
+    shared_detail::Mapping segment(segment_name, true, true, header.total_size);
+    char *base = segment.data();
+
+    auto line_offsets = reinterpret_cast<uint64_t *>(base + header.line_offsets_offset);
+    auto points = reinterpret_cast<Point *>(base + header.points_offset);
+    auto lengths = reinterpret_cast<double *>(base + header.cumulative_lengths_offset);
+    size_t k = 0;
+    for (size_t id = 0; id < num_lines; ++id) {
+        line_offsets[id] = k;
+        const auto &line = network.line(id);
+        std::copy(line.begin(), line.end(), points + k);
+        const auto &cumulative = network.cumulative_lengths(id);
+        std::copy(cumulative.begin(), cumulative.end(), lengths + k);
+        k += line.size();
+    }
+    line_offsets[num_lines] = k;
+    std::memcpy(base + header.envelopes_offset, envelopes.data(), envelopes.size() * sizeof(Box<Point>));
+    std::memcpy(base + header.cell_offsets_offset, cell_offsets.data(), cell_offsets.size() * sizeof(uint64_t));
+    std::memcpy(base + header.cell_lines_offset, cell_lines.data(), cell_lines.size() * sizeof(uint32_t));
+    std::memcpy(base, &header, sizeof(header));
+
+    // 数据写入完成后再切换版本，读取方看到新版本号时数据一定已经完整
+    // 只删除被本次发布替换掉的版本，并发的发布者各自负责删除自己替换掉的版本
+    uint64_t previous = block->current_version.load(std::memory_order_acquire);
+    do {
+        if (previous > header.version) {
+            ::shm_unlink(segment_name.c_str());
+            return header.version;
+        }
+    } while (!block->current_version.compare_exchange_weak(previous, header.version, std::memory_order_acq_rel,
+                                                           std::memory_order_acquire));
+    if (previous != 0) {
+        ::shm_unlink(shared_detail::data_segment_name(name, previous).c_str());
+    }
+    return header.version;
+}
+
+/**
+ * @brief 删除共享内存线网的控制段和当前版本的数据段名称。已映射的进程不受影响。
+ *
+ * @param [in] name 共享内存名称。
+ */
+inline void remove_shared_network(const std::string &name) {
+    try {
+        auto control = shared_detail::open_control(name, false);
+        auto block = reinterpret_cast<shared_detail::ControlBlock *>(control.data());
+        uint64_t version = block->current_version.load(std::memory_order_acquire);
+        if (version != 0) {
+            ::shm_unlink(shared_detail::data_segment_name(name, version).c_str());
+        }
+    } catch (const std::system_error &) {
+    }
+    ::shm_unlink(name.c_str());
+}
+
+/**
+ * @brief 映射到当前进程的共享内存线网（只读）。
+ *
+ * 所有数据直接在共享内存中访问，不做任何拷贝，同一主机上的所有进程共享一份物理内存。
+ * 投影接口与 `LineNetwork::project` 语义一致，但使用共享内存中的网格索引筛选候选折线。
+ *
+ * @tparam Point 二维点类型，需要与发布方一致。
+ *
+ * @note `project` 可以被多个线程并发调用；`refresh` 会替换映射，不能与 `project` 并发调用。
+ */
+template <typename Point>
+class SharedNetwork {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+    static_assert(std::is_trivially_copyable_v<Point>, "Point must be trivially copyable");
+
+public:
+    /**
+     * @brief 打开命名的共享内存线网，并映射其当前版本。
+     *
+     * @param [in] name 共享内存名称，与 `publish_shared_network` 一致。
+     */
+    explicit SharedNetwork(std::string name) : name_(std::move(name)) {
+        control_ = shared_detail::open_control(name_, false);
+        if (!refresh()) {
+            throw std::runtime_error("shared network has not been published: " + name_);
+        }
+    }
+
+    /**
+     * @brief 检查控制段中的版本号，如果发布了新版本则重新映射。
+     *
+     * @return bool 当前是否映射了有效版本。
+     */
+    bool refresh() {
+        auto block = reinterpret_cast<const shared_detail::ControlBlock *>(control_.data());
+        uint64_t version = block->current_version.load(std::memory_order_acquire);
+        shared_detail::Mapping segment;
+        for (;;) {
+            if (version == 0) {
+                return false;
+            }
+            if (version == version_) {
+                return true;
+            }
+            try {
+                segment = shared_detail::Mapping(shared_detail::data_segment_name(name_, version), false, false);
+                break;
+            } catch (const std::system_error &e) {
+                // 读取版本号之后、打开数据段之前有新版本发布，旧版本的数据段已被删除，重新读取版本号
+                uint64_t latest = block->current_version.load(std::memory_order_acquire);
+                if (e.code() != std::errc::no_such_file_or_directory || latest == version) {
+                    throw;
+                }
+                version = latest;
+            }
+        }
+        if (segment.size() < sizeof(SharedNetworkHeader)) {
+            throw std::runtime_error("invalid shared network segment: " + name_);
+        }
+        auto header = reinterpret_cast<const SharedNetworkHeader *>(segment.data());
+        if (header->magic != SharedNetworkHeader::kMagic || header->point_size != sizeof(Point) ||
+            header->dimension != bg::dimension<Point>::value || header->total_size > segment.size()) {
+            throw std::runtime_error("incompatible shared network segment: " + name_);
+        }
+
+        segment_ = std::move(segment);
+        header_ = reinterpret_cast<const SharedNetworkHeader *>(segment_.data());
+        version_ = version;
+        return true;
+    }
+
+    uint64_t version() const { return version_; }
+    size_t size() const { return header_->num_lines; }
+    size_t num_points() const { return header_->num_points; }
+
+    // 第 id 条折线的顶点区间
+    const Point *line_begin(size_t id) const { return points() + line_offsets()[id]; }
+    const Point *line_end(size_t id) const { return points() + line_offsets()[id + 1]; }
+
+    // 第 id 条折线各顶点的累积长度
+    const double *cumulative_lengths(size_t id) const { return lengths() + line_offsets()[id]; }
+
+    /**
+     * @brief 计算点在共享线网上的投影。
+     *
+     * @param [in] point 要投影的点。
+     * @param [in] mode 投影模式。
+     * @param [in] search_radius 候选折线的搜索框边长，语义与 `create_box` 相同。
+     * @return NetworkProjection 投影结果，搜索范围内没有折线时返回无效结果。
+     */
+    NetworkProjection project(const Point &point, ProjectionMode mode,
+                              double search_radius = LineNetwork<Point>::kDefaultSearchRadius) const {
+        NetworkProjection result;
+        auto query_box = create_box(point, search_radius);
+
+        const auto &h = *header_;
+
+        // 跨越多个单元格的折线会被重复收集，排序去重后再计算
+        std::vector<uint32_t> candidates;
+        auto cell_offsets = reinterpret_cast<const uint64_t *>(segment_.data() + h.cell_offsets_offset);
+        auto cell_lines = reinterpret_cast<const uint32_t *>(segment_.data() + h.cell_lines_offset);
+        shared_detail::for_each_cell(h, query_box, [&](size_t c) {
+            candidates.insert(candidates.end(), cell_lines + cell_offsets[c], cell_lines + cell_offsets[c + 1]);
+        });
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        auto envelopes = reinterpret_cast<const Box<Point> *>(segment_.data() + h.envelopes_offset);
+        for (auto id : candidates) {
+            if (!bg::intersects(envelopes[id], query_box)) {
+                continue;
+            }
+            auto [d, project_distance] =
+                network_detail::project_line(point, line_begin(id), line_end(id), cumulative_lengths(id), mode);
+            if (!result.valid() || d < result.distance) {
+                result.line_id = id;
+                result.distance = d;
+                result.project_distance = project_distance;
+            }
+        }
+        return result;
+    }
+
+private:
+    const uint64_t *line_offsets() const {
+        return reinterpret_cast<const uint64_t *>(segment_.data() + header_->line_offsets_offset);
+    }
+    const Point *points() const { return reinterpret_cast<const Point *>(segment_.data() + header_->points_offset); }
+    const double *lengths() const {
+        return reinterpret_cast<const double *>(segment_.data() + header_->cumulative_lengths_offset);
+    }
+
+    std::string name_;
+    shared_detail::Mapping control_;
+    shared_detail::Mapping segment_;
+    const SharedNetworkHeader *header_ = nullptr;
+    uint64_t version_ = 0;
+};
+
+}  // namespace simplegeom
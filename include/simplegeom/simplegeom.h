@@ -14,4 +14,9 @@
 
 #include "simplegeom/algorithm.h"
 #include "simplegeom/common.h"
-#include "simplegeom/io.h"
\ No newline at end of file
+#include "simplegeom/io.h"
+#include "simplegeom/line_file.h"
+#include "simplegeom/line_handle.h"
+#include "simplegeom/network.h"
+#include "simplegeom/thread_pool.h"
+#include "simplegeom/view.h"
\ No newline at end of file
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+#include "simplegeom/trajectory.h"
+
+namespace simplegeom {
+
+// 停留点检测的参数
+struct StayPointOptions {
+    double distance = 200.;      // 停留范围，单位与 `distance` 相同（地理坐标下为米）
+    double min_duration = 300.;  // 最短停留时间（秒）
+};
+
+// 基于密度的停留检测参数
+struct DensityStopOptions {
+    double eps = 50.;           // 邻域沿轨迹向前、向后各延伸的路程，单位与 `distance` 相同
+    double min_duration = 60.;  // 邻域的最短持续时间（秒），达到该值的点为核心点
+};
+
+// 一次停留
+template <typename Point>
+struct StayPoint {
+    Point center;           // 停留期间各点的中心
+    double arrival = 0.;    // 到达时刻
+    double departure = 0.;  // 离开时刻
+    double radius = 0.;     // 停留期间的点到中心的最大距离
+    size_t first = 0;       // 第一个点在轨迹中的序号
+    size_t last = 0;        // 最后一个点在轨迹中的序号（含）
+
+    double duration() const { return departure - arrival; }
+};
+
+namespace stay_point_detail {
+
+// 以第一个点为参考的坐标累加器，地理坐标下经度相对参考点展开，避免跨越反子午线时求平均出错
+template <typename Point>
+struct Centroid {
+    double ref_x = 0., sum_x = 0., sum_y = 0.;
+    size_t count = 0;
+
+    void add(const Point &p) {
+        double x = bg::get<0>(p);
+        if (count == 0) {
+            ref_x = x;
+        }
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            x = ref_x + wrap_lon(x - ref_x);
+        }
+        sum_x += x;
+        sum_y += bg::get<1>(p);
+        ++count;
+    }
+
+    Point get() const {
+        double x = sum_x / count, y = sum_y / count;
+        if constexpr (std::is_same_v<Point, PointGeo2>) {
+            x = x > 180. ? x - 360. : (x < -180. ? x + 360. : x);
+        }
+        return Point(x, y);
+    }
+};
+
+// 由轨迹中连续的一段点生成停留。半径是到最终中心的最大距离，中心随新点移动，无法随点增量维护，
+// 因此在输出时再遍历一次；每个点只属于一次停留，总代价仍为 O(n)
+template <typename Point, typename Points>
+StayPoint<Point> make_stay(const Points &points, const std::vector<double> &timestamps, size_t first, size_t last) {
+    Centroid<Point> centroid;
+    for (size_t i = first; i <= last; ++i) {
+        centroid.add(points[i]);
+    }
+    StayPoint<Point> stay;
+    stay.center = centroid.get();
+    stay.arrival = timestamps[first];
+    stay.departure = timestamps[last];
+    stay.first = first;
+    stay.last = last;
+    for (size_t i = first; i <= last; ++i) {
+        stay.radius = std::max(stay.radius, simplegeom::distance(stay.center, points[i]));
+    }
+    return stay;
+}
+
+}  // namespace stay_point_detail
+
+/**
+ * @brief 流式停留点检测器。
+ *
+ * 维护当前候选停留的中心（坐标的增量平均）：新点到中心的距离不超过 `distance` 时并入候选停留，否则结束
+ * 候选停留——持续时间不少于 `min_duration` 时输出一次停留——并以新点开始新的候选停留。每个点只与中心
+ * 比较一次 `distance`，输出停留时再计算一次半径，总代价为 O(n)。
+ *
+ * @tparam Point 二维点类型，`Point2` 或 `PointGeo2`。
+ */
+template <typename Point>
+class StayPointDetector {
+public:
+    explicit StayPointDetector(StayPointOptions options = {}) : options_(options) {}
+
+    /**
+     * @brief 输入下一个点，时间戳应当非递减。
+     *
+     * @param [in] point 点。
+     * @param [in] timestamp 时间戳（秒）。
+     * @param [out] stay 完成的停留。
+     * @return bool 是否有停留在该点之前结束。
+     */
+    bool push(const Point &point, double timestamp, StayPoint<Point> &stay) {
+        bool emitted = false;
+        if (!points_.empty() && simplegeom::distance(centroid_.get(), point) > options_.distance) {
+            emitted = emit(stay);
+            reset();
+        }
+        points_.push_back(point);
+        timestamps_.push_back(timestamp);
+        centroid_.add(point);
+        ++index_;
+        return emitted;
+    }
+
+    /**
+     * @brief 结束输入，输出最后一个候选停留。
+     *
+     * @return bool 最后一个候选停留是否构成停留。
+     */
+    bool finish(StayPoint<Point> &stay) {
+        bool emitted = emit(stay);
+        reset();
+        index_ = 0;
+        return emitted;
+    }
+
+private:
+    bool emit(StayPoint<Point> &stay) const {
+        if (points_.empty() || timestamps_.back() - timestamps_.front() < options_.min_duration) {
+            return false;
+        }
+        stay = stay_point_detail::make_stay<Point>(points_, timestamps_, 0, points_.size() - 1);
+        // 候选停留内的序号换算为输入序列中的序号
+        stay.first = index_ - points_.size();
+        stay.last = index_ - 1;
+        return true;
+    }
+
+    void reset() {
+        points_.clear();
+        timestamps_.clear();
+        centroid_ = stay_point_detail::Centroid<Point>();
+    }
+
+    StayPointOptions options_;
+    std::vector<Point> points_;  // 当前候选停留的点
+    std::vector<double> timestamps_;
+    stay_point_detail::Centroid<Point> centroid_;
+    size_t index_ = 0;  // 已输入的点数
+};
+
+/**
+ * @brief 检测轨迹中的停留点，语义与 `StayPointDetector` 相同。
+ */
+template <typename Point>
+std::vector<StayPoint<Point>> detect_stay_points(const Trajectory<Point> &line, const StayPointOptions &options = {}) {
+    std::vector<StayPoint<Point>> stays;
+    StayPointDetector<Point> detector(options);
+    StayPoint<Point> stay;
+    for (size_t i = 0; i < line.size(); ++i) {
+        if (detector.push(line.points[i], line.timestamps[i], stay)) {
+            stays.push_back(stay);
+        }
+    }
+    if (detector.finish(stay)) {
+        stays.push_back(stay);
+    }
+    return stays;
+}
+
+/**
+ * @brief 基于密度的停留检测（CB-SMoT）。
+ *
+ * 第 i 个点的邻域为沿轨迹向前、向后路程都不超过 `eps` 的连续一段点，邻域持续时间不少于 `min_duration`
+ * 的点为核心点，连续的核心点合并为一次停留。邻域的两端随 i 单调移动，用累积路程与双指针维护，
+ * 每段路程只计算一次 `distance`，总代价为 O(n)。与 `detect_stay_points` 相比，对缓慢移动（如拥堵）
+ * 与 GPS 漂移更稳健。
+ */
+template <typename Point>
+std::vector<StayPoint<Point>> detect_stops_density(const Trajectory<Point> &line,
+                                                   const DensityStopOptions &options = {}) {
+    std::vector<StayPoint<Point>> stays;
+    size_t n = line.size();
+    if (n == 0) {
+        return stays;
+    }
+    std::vector<double> lengths(n, 0.);
+    for (size_t i = 1; i < n; ++i) {
+        lengths[i] = lengths[i - 1] + simplegeom::distance(line.points[i - 1], line.points[i]);
+    }
+
+    size_t lo = 0, hi = 0, run = n;  // `run` 为当前连续核心点的起点，n 表示没有
+    for (size_t i = 0; i < n; ++i) {
+        while (lengths[i] - lengths[lo] > options.eps) {
+            ++lo;
+        }
+        hi = std::max(hi, i);
+        while (hi + 1 < n && lengths[hi + 1] - lengths[i] <= options.eps) {
+            ++hi;
+        }
+        bool core = line.timestamps[hi] - line.timestamps[lo] >= options.min_duration;
+        if (core && run == n) {
+            run = i;
+        } else if (!core && run != n) {
+            stays.push_back(stay_point_detail::make_stay<Point>(line.points, line.timestamps, run, i - 1));
+            run = n;
+        }
+    }
+    if (run != n) {
+        stays.push_back(stay_point_detail::make_stay<Point>(line.points, line.timestamps, run, n - 1));
+    }
+    return stays;
+}
+
+/**
+ * @brief 批量检测多条轨迹的停留点。
+ *
+ * @param [in] lines 轨迹集合。
+ * @param [in] options 检测参数。
+ * @param [in] pool 线程池，为空时在当前线程中计算。
+ * @return std::vector<std::vector<StayPoint<Point>>> 与 `lines` 一一对应的停留点。
+ */
+template <typename Point>
+std::vector<std::vector<StayPoint<Point>>> detect_stay_points_batch(const std::vector<Trajectory<Point>> &lines,
+                                                                    const StayPointOptions &options = {},
+                                                                    ThreadPool *pool = nullptr) {
+    std::vector<std::vector<StayPoint<Point>>> results(lines.size());
+    parallel_for(
+        pool, lines.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = detect_stay_points(lines[i], options);
+            }
+        },
+        16);
+    return results;
+}
+
+/**
+ * @brief 批量进行基于密度的停留检测。
+ */
+template <typename Point>
+std::vector<std::vector<StayPoint<Point>>> detect_stops_density_batch(const std::vector<Trajectory<Point>> &lines,
+                                                                      const DensityStopOptions &options = {},
+                                                                      ThreadPool *pool = nullptr) {
+    std::vector<std::vector<StayPoint<Point>>> results(lines.size());
+    parallel_for(
+        pool, lines.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = detect_stops_density(lines[i], options);
+            }
+        },
+        16);
+    return results;
+}
+
+}  // namespace simplegeom
@@ -0,0 +1,532 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+/**
+ * 合成数据生成器：生成可复现的道路网络与 GPS 轨迹，供基准测试与正确性校验使用。
+ *
+ * 所有随机数都由 `seed` 和对象序号共同决定（每条道路、每条轨迹使用独立的随机数流），
+ * 因此无论是否并行生成、线程数是多少，相同参数总是得到完全相同的数据。随机分布不使用标准库的实现，
+ * 不同的标准库也得到相同的数据。
+ */
+
+// 道路网络的生成参数
+struct RoadNetworkOptions {
+    uint64_t seed = 42;
+    PointGeo2 origin{116.3, 39.9};       // 区域西南角
+    double width_meters = 10000.;        // 区域东西向宽度
+    double height_meters = 10000.;       // 区域南北向高度
+    double block_meters = 250.;          // 网格道路的间距
+    double keep_ratio = 0.9;             // 网格道路中每条折线被保留的概率，用于模拟不完整的路网
+    double road_density = 8.;            // 有机路网的道路密度，单位为每平方公里的道路公里数
+    double mean_road_meters = 1500.;     // 有机路网中单条道路的平均长度
+    double vertex_spacing_meters = 30.;  // 相邻顶点的平均间距
+    double spacing_jitter = 0.5;         // 顶点间距的随机扰动比例，取值 [0, 1)
+    double curvature = 0.05;             // 每个顶点航向变化的标准差（弧度）
+    double max_line_meters = 2000.;      // 单条折线的最大长度，更长的道路会被切分为多条折线
+};
+
+// GPS 轨迹的生成参数
+struct TraceOptions {
+    uint64_t seed = 7;
+    double sample_interval = 1.;   // 采样间隔（秒）
+    double speed = 12.;            // 平均速度（米/秒）
+    double speed_jitter = 0.3;     // 速度的随机扰动比例
+    double noise_meters = 5.;      // 定位误差的标准差（米）
+    double outlier_ratio = 0.;     // 离群点比例，离群点的误差为 `outlier_meters`
+    double outlier_meters = 200.;  // 离群点误差（米）
+    double dropout_ratio = 0.;     // 丢点比例
+    size_t max_points = 600;       // 每条轨迹的最大点数
+};
+
+// 行政区划式覆盖（相邻多边形共享边界）的生成参数
+struct CoverageOptions {
+    uint64_t seed = 11;
+    PointGeo2 origin{116.3, 39.9};       // 区域西南角
+    size_t columns = 16;                 // 东西向的区划个数
+    size_t rows = 16;                    // 南北向的区划个数
+    double cell_meters = 2000.;          // 区划的平均边长
+    double vertex_spacing_meters = 20.;  // 边界上相邻顶点的平均间距
+    double roughness = 0.05;             // 边界偏离两端连线的幅度与边长之比
+    double enclave_ratio = 0.1;          // 含飞地（内部的另一个区划，作为内环）的区划比例
+};
+
+// GPS 轨迹，`points` 为带噪声的观测点，`truth` 为对应的真实位置
+struct GpsTrace {
+    size_t line_id = 0;              // 轨迹所沿的折线编号
+    LineString<PointGeo2> points;    // 观测点
+    LineString<PointGeo2> truth;     // 真实位置
+    std::vector<double> timestamps;  // 时间戳（秒）
+    std::vector<double> measures;    // 真实位置沿折线的累积距离（米）
+};
+
+namespace synthetic_detail {
+
+// 为第 index 个对象派生独立的随机数种子（SplitMix64）
+inline uint64_t derive_seed(uint64_t seed, uint64_t index) {
+    uint64_t z = seed + 0x9e3779b97f4a7c15ull * (index + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * 可移植的随机分布。`std::mt19937_64` 的输出序列由标准规定，但 `std::uniform_real_distribution` 等分布的算法由
+ * 各标准库自行实现，同一种子在 libstdc++ 与 libc++ 上会得到不同的数据。这里直接由 64 位输出构造样本，
+ * 生成的数据只依赖 `std::log`、`std::cos` 等数学函数的精度。
+ */
+
+// [0, 1) 上的均匀分布：取 64 位输出的高 53 位
+inline double unit_interval(std::mt19937_64 &rng) { return static_cast<double>(rng() >> 11) * 0x1p-53; }
+
+// [a, b) 上的均匀分布
+struct UniformReal {
+    double a, b;
+    double operator()(std::mt19937_64 &rng) const { return a + (b - a) * unit_interval(rng); }
+};
+
+// 正态分布，使用 Box-Muller 变换，每个样本消耗两个随机数
+struct Normal {
+    double mean, stddev;
+    double operator()(std::mt19937_64 &rng) const {
+        double u = 1. - unit_interval(rng);  // (0, 1]，避免 log(0)
+        double v = unit_interval(rng);
+        return mean + stddev * std::sqrt(-2. * std::log(u)) * std::cos(2. * M_PI * v);
+    }
+};
+
+// 指数分布，`rate` 为均值的倒数
+struct Exponential {
+    double rate;
+    double operator()(std::mt19937_64 &rng) const { return -std::log(1. - unit_interval(rng)) / rate; }
+};
+
+// 将一条道路（局部平面坐标）按最大长度切分为多条折线并追加到结果中
+inline void emit_road(const LocalFrame<PointGeo2> &frame, const std::vector<std::pair<double, double>> &xy,
+                      double max_line_meters, std::vector<LineString<PointGeo2>> &out) {
+    if (xy.size() < 2) {
+        return;
+    }
+    LineString<PointGeo2> line;
+    line.emplace_back(frame.unproject(xy[0].first, xy[0].second));
+    double length = 0.;
+    for (size_t i = 1; i < xy.size(); ++i) {
+        length += std::hypot(xy[i].first - xy[i - 1].first, xy[i].second - xy[i - 1].second);
+        line.emplace_back(frame.unproject(xy[i].first, xy[i].second));
+        if (length >= max_line_meters && i + 1 < xy.size()) {
+            out.push_back(std::move(line));
+            line = LineString<PointGeo2>();
+            line.emplace_back(frame.unproject(xy[i].first, xy[i].second));
+            length = 0.;
+        }
+    }
+    if (line.size() >= 2) {
+        out.push_back(std::move(line));
+    }
+}
+
+// 并行生成 n 个对象，每个对象由 `make(index, out)` 追加到独立的结果中，最后按序号顺序合并
+template <typename T, typename Make>
+std::vector<T> generate_ordered(size_t n, ThreadPool *pool, Make &&make) {
+    std::vector<std::vector<T>> parts(n);
+    parallel_for(
+        pool, n,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                make(i, parts[i]);
+            }
+        },
+        16);
+    std::vector<T> result;
+    size_t total = 0;
+    for (const auto &part : parts) {
+        total += part.size();
+    }
+    result.reserve(total);
+    for (auto &part : parts) {
+        std::move(part.begin(), part.end(), std::back_inserter(result));
+    }
+    return result;
+}
+
+// 从 `a` 到 `b` 的一段区划边界（局部平面坐标，包含两端）：两端连线上叠加几个振幅递减的正弦波，再叠加顶点级的
+// 小幅噪声，沿连线方向单调，两端与相邻边界精确相接
+inline std::vector<std::pair<double, double>> coverage_border(std::pair<double, double> a, std::pair<double, double> b,
+                                                              const CoverageOptions &options, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    synthetic_detail::UniformReal unit{0., 1.};
+    double dx = b.first - a.first, dy = b.second - a.second, length = std::hypot(dx, dy);
+    double weights[4];
+    for (size_t k = 0; k < 4; ++k) {
+        weights[k] = (2. * unit(rng) - 1.) / static_cast<double>((k + 1) * (k + 1));
+    }
+    auto n = static_cast<size_t>(std::max(2., std::round(length / options.vertex_spacing_meters)));
+    std::vector<std::pair<double, double>> xy{a};
+    for (size_t i = 1; i < n; ++i) {
+        double t = (static_cast<double>(i) + 0.6 * (unit(rng) - 0.5)) / static_cast<double>(n);
+        double offset = 0.;
+        for (size_t k = 0; k < 4; ++k) {
+            offset += weights[k] * std::sin(static_cast<double>(k + 1) * M_PI * t);
+        }
+        offset = offset * options.roughness * length + 0.1 * options.vertex_spacing_meters * (unit(rng) - 0.5);
+        xy.emplace_back(a.first + t * dx - offset * dy / length, a.second + t * dy + offset * dx / length);
+    }
+    xy.push_back(b);
+    return xy;
+}
+
+}  // namespace synthetic_detail
+
+/**
+ * @brief 生成网格状道路网络。
+ *
+ * 在区域内按 `block_meters` 间距生成东西向和南北向的道路，每条道路的顶点间距带随机扰动，
+ * 并按 `curvature` 产生横向的缓慢摆动，道路按 `max_line_meters` 切分后以 `keep_ratio` 的概率保留。
+ *
+ * @param [in] options 生成参数。
+ * @param [in] pool 线程池，为空时在当前线程中生成。
+ * @return std::vector<LineString<PointGeo2>> 道路折线。
+ */
+inline std::vector<LineString<PointGeo2>> generate_grid_network(const RoadNetworkOptions &options,
+                                                                 ThreadPool *pool = nullptr) {
+    LocalFrame<PointGeo2> frame(options.origin);
+    size_t columns = static_cast<size_t>(options.width_meters / options.block_meters) + 1;
+    size_t rows = static_cast<size_t>(options.height_meters / options.block_meters) + 1;
+
+    return synthetic_detail::generate_ordered<LineString<PointGeo2>>(
+        columns + rows, pool, [&](size_t index, std::vector<LineString<PointGeo2>> &out) {
+            std::mt19937_64 rng(synthetic_detail::derive_seed(options.seed, index));
+            synthetic_detail::UniformReal jitter{1. - options.spacing_jitter, 1. + options.spacing_jitter};
+            synthetic_detail::Normal turn{0., options.curvature};
+            synthetic_detail::UniformReal unit{0., 1.};
+
+            bool vertical = index < columns;
+            double fixed = (vertical ? index : index - columns) * options.block_meters;
+            double length = vertical ? options.height_meters : options.width_meters;
+
+            // 横向偏移按航向积分得到，并向道路中心线回拉，避免偏离过远
+            std::vector<std::pair<double, double>> xy;
+            double along = 0., offset = 0., heading = 0.;
+            while (true) {
+                xy.emplace_back(vertical ? fixed + offset : along, vertical ? along : fixed + offset);
+                if (along >= length) {
+                    break;
+                }
+                double step = options.vertex_spacing_meters * jitter(rng);
+                along = std::min(length, along + step);
+                heading = 0.8 * heading + turn(rng);
+                offset += step * std::sin(heading) - 0.05 * offset;
+            }
+
+            std::vector<LineString<PointGeo2>> pieces;
+            synthetic_detail::emit_road(frame, xy, options.max_line_meters, pieces);
+            for (auto &piece : pieces) {
+                if (unit(rng) < options.keep_ratio) {
+                    out.push_back(std::move(piece));
+                }
+            }
+        });
+}
+
+/**
+ * @brief 生成有机（非规则）道路网络。
+ *
+ * 每条道路从区域内的随机位置、随机航向出发做带惯性的随机游走，顶点间距和航向变化分别由
+ * `vertex_spacing_meters`、`spacing_jitter` 和 `curvature` 控制，碰到区域边界时反射。
+ * 道路条数由 `road_density` 与 `mean_road_meters` 推算，道路长度服从指数分布。
+ *
+ * @param [in] options 生成参数。
+ * @param [in] pool 线程池，为空时在当前线程中生成。
+ * @return std::vector<LineString<PointGeo2>> 道路折线。
+ */
+inline std::vector<LineString<PointGeo2>> generate_organic_network(const RoadNetworkOptions &options,
+                                                                    ThreadPool *pool = nullptr) {
+    LocalFrame<PointGeo2> frame(options.origin);
+    double area_km2 = options.width_meters * options.height_meters / 1e6;
+    size_t roads = static_cast<size_t>(std::ceil(area_km2 * options.road_density * 1000. / options.mean_road_meters));
+
+    return synthetic_detail::generate_ordered<LineString<PointGeo2>>(
+        roads, pool, [&](size_t index, std::vector<LineString<PointGeo2>> &out) {
+            std::mt19937_64 rng(synthetic_detail::derive_seed(options.seed, index));
+            synthetic_detail::UniformReal unit{0., 1.};
+            synthetic_detail::UniformReal jitter{1. - options.spacing_jitter, 1. + options.spacing_jitter};
+            synthetic_detail::Normal turn{0., options.curvature};
+            synthetic_detail::Exponential road_length{1. / options.mean_road_meters};
+
+            double x = unit(rng) * options.width_meters;
+            double y = unit(rng) * options.height_meters;
+            double heading = unit(rng) * 2. * M_PI;
+            double length = std::max(2. * options.vertex_spacing_meters, road_length(rng));
+
+            std::vector<std::pair<double, double>> xy{{x, y}};
+            for (double walked = 0.; walked < length;) {
+                double step = options.vertex_spacing_meters * jitter(rng);
+                heading += turn(rng);
+                double nx = x + step * std::cos(heading);
+                double ny = y + step * std::sin(heading);
+                if (nx < 0. || nx > options.width_meters) {
+                    heading = M_PI - heading;
+                    nx = std::clamp(nx, 0., options.width_meters);
+                }
+                if (ny < 0. || ny > options.height_meters) {
+                    heading = -heading;
+                    ny = std::clamp(ny, 0., options.height_meters);
+                }
+                x = nx;
+                y = ny;
+                walked += step;
+                xy.emplace_back(x, y);
+            }
+            synthetic_detail::emit_road(frame, xy, options.max_line_meters, out);
+        });
+}
+
+/**
+ * @brief 生成一条沿给定折线行驶的 GPS 轨迹。
+ *
+ * 从折线上的随机位置出发，按带扰动的速度和固定采样间隔前进，到达终点或点数达到上限时结束。
+ * 每个观测点在真实位置上叠加高斯噪声，并按比例产生离群点和丢点。
+ *
+ * @param [in] line 轨迹所沿的折线。
+ * @param [in] options 轨迹生成参数。
+ * @param [in] index 轨迹序号，与 `options.seed` 共同决定随机数流。
+ * @return GpsTrace 生成的轨迹，折线少于两个点时返回空轨迹。
+ */
+inline GpsTrace generate_trace(const LineString<PointGeo2> &line, const TraceOptions &options, uint64_t index = 0) {
+    GpsTrace trace;
+    if (line.size() < 2) {
+        return trace;
+    }
+
+    std::mt19937_64 rng(synthetic_detail::derive_seed(options.seed, index));
+    synthetic_detail::UniformReal unit{0., 1.};
+    synthetic_detail::Normal noise{0., options.noise_meters};
+
+    // 在局部平面中计算各顶点的累积长度
+    LocalFrame<PointGeo2> frame(line.front());
+    std::vector<LocalPoint> local(line.size());
+    std::vector<double> lengths(line.size(), 0.);
+    for (size_t i = 0; i < line.size(); ++i) {
+        local[i] = frame.to_local(line[i], i);
+        if (i > 0) {
+            lengths[i] = lengths[i - 1] + std::hypot(local[i].x - local[i - 1].x, local[i].y - local[i - 1].y);
+        }
+    }
+
+    double measure = unit(rng) * lengths.back() * 0.5;
+    double time = 0.;
+    size_t segment = 0;
+    while (measure <= lengths.back() && trace.truth.size() < options.max_points) {
+        while (segment + 2 < line.size() && lengths[segment + 1] < measure) {
+            ++segment;
+        }
+        double span = lengths[segment + 1] - lengths[segment];
+        double t = span > 0. ? (measure - lengths[segment]) / span : 0.;
+        double x = local[segment].x + t * (local[segment + 1].x - local[segment].x);
+        double y = local[segment].y + t * (local[segment + 1].y - local[segment].y);
+
+        if (unit(rng) >= options.dropout_ratio) {
+            double dx = noise(rng), dy = noise(rng);
+            if (unit(rng) < options.outlier_ratio) {
+                double angle = unit(rng) * 2. * M_PI;
+                dx = options.outlier_meters * std::cos(angle);
+                dy = options.outlier_meters * std::sin(angle);
+            }
+            trace.truth.push_back(frame.unproject(x, y));
+            trace.points.push_back(frame.unproject(x + dx, y + dy));
+            trace.timestamps.push_back(time);
+            trace.measures.push_back(measure);
+        }
+
+        double speed = options.speed * (1. + options.speed_jitter * (2. * unit(rng) - 1.));
+        measure += std::max(0., speed) * options.sample_interval;
+        time += options.sample_interval;
+    }
+    return trace;
+}
+
+/**
+ * @brief 在道路网络上批量生成 GPS 轨迹，每条轨迹沿随机选取的一条折线行驶。
+ *
+ * @param [in] network 道路折线。
+ * @param [in] count 轨迹条数。
+ * @param [in] options 轨迹生成参数。
+ * @param [in] pool 线程池，为空时在当前线程中生成。
+ * @return std::vector<GpsTrace> 生成的轨迹。
+ */
+inline std::vector<GpsTrace> generate_traces(const std::vector<LineString<PointGeo2>> &network, size_t count,
+                                             const TraceOptions &options, ThreadPool *pool = nullptr) {
+    std::vector<GpsTrace> traces(network.empty() ? 0 : count);
+    parallel_for(
+        pool, traces.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t line_id = synthetic_detail::derive_seed(options.seed ^ 0x5bd1e995, i) % network.size();
+                traces[i] = generate_trace(network[line_id], options, i);
+                traces[i].line_id = line_id;
+            }
+        },
+        16);
+    return traces;
+}
+
+/**
+ * @brief 生成行政区划式的多边形覆盖：相邻多边形共享完全相同的边界顶点，没有缝隙与重叠。
+ *
+ * 区域划分为 `columns` × `rows` 个区划，网格节点带随机扰动（区域外框上的节点只沿外框移动），每段边界由
+ * `synthetic_detail::coverage_border` 生成并由两侧的区划共用。按 `enclave_ratio` 的比例，区划内部另有一个
+ * 星形的飞地，飞地作为单独的多边形输出，并作为所在区划的内环。
+ *
+ * @param [in] options 生成参数。
+ * @return std::vector<Polygon<PointGeo2>> 先按行输出各区划，再输出各飞地。
+ */
+inline std::vector<Polygon<PointGeo2>> generate_coverage(const CoverageOptions &options) {
+    using XY = std::pair<double, double>;
+    LocalFrame<PointGeo2> frame(options.origin);
+    size_t columns = std::max<size_t>(options.columns, 1), rows = std::max<size_t>(options.rows, 1);
+    double cell = options.cell_meters;
+
+    std::vector<XY> nodes((columns + 1) * (rows + 1));
+    for (size_t r = 0; r <= rows; ++r) {
+        for (size_t c = 0; c <= columns; ++c) {
+            std::mt19937_64 rng(synthetic_detail::derive_seed(options.seed, r * (columns + 1) + c));
+            synthetic_detail::UniformReal jitter{-0.15 * cell, 0.15 * cell};
+            double jx = jitter(rng), jy = jitter(rng);
+            nodes[r * (columns + 1) + c] = {static_cast<double>(c) * cell + (c == 0 || c == columns ? 0. : jx),
+                                            static_cast<double>(r) * cell + (r == 0 || r == rows ? 0. : jy)};
+        }
+    }
+    auto node = [&](size_t c, size_t r) { return nodes[r * (columns + 1) + c]; };
+
+    // 横向边界 (c, r)→(c + 1, r) 与纵向边界 (c, r)→(c, r + 1)
+    uint64_t border_seed = options.seed ^ 0x2545f4914f6cdd1dull;
+    std::vector<std::vector<XY>> horizontal(columns * (rows + 1)), vertical((columns + 1) * rows);
+    for (size_t r = 0; r <= rows; ++r) {
+        for (size_t c = 0; c < columns; ++c) {
+            size_t index = r * columns + c;
+            horizontal[index] = synthetic_detail::coverage_border(
+                node(c, r), node(c + 1, r), options, synthetic_detail::derive_seed(border_seed, index));
+        }
+    }
+    for (size_t c = 0; c <= columns; ++c) {
+        for (size_t r = 0; r < rows; ++r) {
+            size_t index = c * rows + r;
+            vertical[index] = synthetic_detail::coverage_border(
+                node(c, r), node(c, r + 1), options,
+                synthetic_detail::derive_seed(border_seed, horizontal.size() + index));
+        }
+    }
+
+    // 环按逆时针拼接后反转为多边形类型要求的顺时针
+    auto to_ring = [&](const std::vector<XY> &xy, bool reverse) {
+        Polygon<PointGeo2>::ring_type ring;
+        for (const auto &p : xy) {
+            ring.push_back(frame.unproject(p.first, p.second));
+        }
+        if (reverse) {
+            std::reverse(ring.begin(), ring.end());
+        }
+        ring.push_back(ring.front());
+        return ring;
+    };
+    auto append = [](std::vector<XY> &ring, const std::vector<XY> &border, bool forward) {
+        if (forward) {
+            ring.insert(ring.end(), border.begin(), border.end() - 1);
+        } else {
+            ring.insert(ring.end(), border.rbegin(), border.rend() - 1);
+        }
+    };
+
+    std::vector<Polygon<PointGeo2>> cells, enclaves;
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < columns; ++c) {
+            std::vector<XY> xy;
+            append(xy, horizontal[r * columns + c], true);
+            append(xy, vertical[(c + 1) * rows + r], true);
+            append(xy, horizontal[(r + 1) * columns + c], false);
+            append(xy, vertical[c * rows + r], false);
+            Polygon<PointGeo2> polygon;
+            polygon.outer() = to_ring(xy, true);
+
+            std::mt19937_64 rng(synthetic_detail::derive_seed(options.seed ^ 0x9e3779b9ull, r * columns + c));
+            synthetic_detail::UniformReal unit{0., 1.};
+            if (unit(rng) < options.enclave_ratio) {
+                XY corners[4] = {node(c, r), node(c + 1, r), node(c + 1, r + 1), node(c, r + 1)};
+                XY center{0., 0.};
+                for (const auto &corner : corners) {
+                    center.first += corner.first / 4.;
+                    center.second += corner.second / 4.;
+                }
+                double radius = 0.1 * cell * (0.8 + 0.4 * unit(rng)), phase = unit(rng) * 2. * M_PI;
+                auto n = static_cast<size_t>(std::max(8., 2. * M_PI * radius / options.vertex_spacing_meters));
+                std::vector<XY> island;
+                for (size_t k = 0; k < n; ++k) {
+                    double angle = 2. * M_PI * static_cast<double>(k) / static_cast<double>(n);
+                    double rho = radius * (1. + 0.15 * std::sin(3. * angle + phase) + 0.02 * (unit(rng) - 0.5));
+                    island.emplace_back(center.first + rho * std::cos(angle), center.second + rho * std::sin(angle));
+                }
+                polygon.inners().push_back(to_ring(island, false));
+                Polygon<PointGeo2> enclave;
+                enclave.outer() = to_ring(island, true);
+                enclaves.push_back(std::move(enclave));
+            }
+            cells.push_back(std::move(polygon));
+        }
+    }
+    cells.insert(cells.end(), std::make_move_iterator(enclaves.begin()), std::make_move_iterator(enclaves.end()));
+    return cells;
+}
+
+/**
+ * @brief 在道路附近生成随机查询点：随机选取折线上的位置，再叠加至多 `max_offset_meters` 的随机偏移。
+ *
+ * @param [in] network 道路折线。
+ * @param [in] count 点数。
+ * @param [in] max_offset_meters 偏离道路的最大距离（米）。
+ * @param [in] seed 随机数种子。
+ * @return std::vector<PointGeo2> 查询点。
+ */
+inline std::vector<PointGeo2> generate_query_points(const std::vector<LineString<PointGeo2>> &network, size_t count,
+                                                    double max_offset_meters, uint64_t seed = 1) {
+    std::vector<PointGeo2> points;
+    // 空折线上没有可以选取的位置，只从非空折线中选取
+    std::vector<size_t> candidates;
+    for (size_t id = 0; id < network.size(); ++id) {
+        if (!network[id].empty()) {
+            candidates.push_back(id);
+        }
+    }
+    if (candidates.empty()) {
+        return points;
+    }
+    points.reserve(count);
+    std::mt19937_64 rng(seed);
+    synthetic_detail::UniformReal unit{0., 1.};
+    for (size_t i = 0; i < count; ++i) {
+        const auto &line = network[candidates[rng() % candidates.size()]];
+        if (line.size() < 2) {
+            points.push_back(line.front());
+            continue;
+        }
+        size_t k = rng() % (line.size() - 1);
+        double t = unit(rng);
+        LocalFrame<PointGeo2> frame(line[k]);
+        auto next = frame.to_local(line[k + 1]);
+        double x = t * next.x + (2. * unit(rng) - 1.) * max_offset_meters;
+        double y = t * next.y + (2. * unit(rng) - 1.) * max_offset_meters;
+        points.push_back(frame.unproject(x, y));
+    }
+    return points;
+}
+
+}  // namespace simplegeom
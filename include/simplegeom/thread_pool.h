@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace simplegeom {
+
+/**
+ * @brief 固定大小的线程池。
+ *
+ * 线程池在构造时启动固定数量的工作线程，通过 `submit` 提交任务并返回 `std::future`。
+ * 析构时会等待队列中已提交的任务全部执行完毕后再退出。
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 构造线程池。
+     *
+     * @param [in] num_threads 工作线程数量，为 0 时使用 `std::thread::hardware_concurrency()`。
+     */
+    explicit ThreadPool(size_t num_threads = 0) {
+        if (num_threads == 0) {
+            num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this] { run(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    /**
+     * @brief 提交一个任务。
+     *
+     * @tparam Func 可调用对象类型，不接受参数。
+     * @param [in] func 要执行的任务。
+     * @return std::future 任务的返回值。
+     */
+    template <typename Func>
+    auto submit(Func &&func) -> std::future<decltype(func())> {
+        using Result = decltype(func());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace([task] { (*task)(); });
+        }
+        cv_.notify_one();
+        return future;
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopped_ = false;
+};
+
+/**
+ * @brief 将区间 [0, n) 划分为若干块并在线程池上并行执行。
+ *
+ * 每个块调用一次 `func(begin, end)`。如果 `pool` 为空或 `n` 较小，则在当前线程中直接执行。
+ * 函数会阻塞直到所有块执行完毕，任务中抛出的异常会在当前线程重新抛出。
+ *
+ * @tparam Func 可调用对象类型，签名为 `void(size_t begin, size_t end)`。
+ * @param [in] pool 线程池，可以为空。
+ * @param [in] n 区间长度。
+ * @param [in] func 对每个块执行的函数。
+ * @param [in] min_chunk 每个块的最小长度，避免任务过小导致调度开销过大。
+ *
+ * @note 不要在同一线程池的任务中嵌套调用该函数，否则所有工作线程可能都在等待子任务而导致死锁。
+ */
+template <typename Func>
+void parallel_for(ThreadPool *pool, size_t n, Func &&func, size_t min_chunk = 256) {
+    if (n == 0) {
+        return;
+    }
+    if (pool == nullptr || pool->size() < 2 || n <= min_chunk) {
+        func(size_t(0), n);
+        return;
+    }
+
+    size_t num_chunks = std::min(pool->size() * 4, (n + min_chunk - 1) / min_chunk);
+    size_t chunk = (n + num_chunks - 1) / num_chunks;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(num_chunks);
+    for (size_t begin = 0; begin < n; begin += chunk) {
+        size_t end = std::min(n, begin + chunk);
+        futures.emplace_back(pool->submit([&func, begin, end] { func(begin, end); }));
+    }
+    // 先等待全部任务结束，再获取结果，避免异常提前返回时任务仍引用 `func`
+    for (auto &future : futures) {
+        future.wait();
+    }
+    for (auto &future : futures) {
+        future.get();
+    }
+}
+
+}  // namespace simplegeom
@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simplegeom/network.h"
+#include "simplegeom/thread_pool.h"
+
+namespace simplegeom {
+
+/**
+ * 调用轨迹文件的二进制格式（本机字节序）：
+ *
+ * 文件头 `TraceFileHeader`，随后是若干定长的 `TraceEvent`，按记录顺序排列。
+ * 定长记录便于直接按下标定位，也便于截断损坏的文件尾部。
+ */
+static constexpr uint32_t kTraceMagic = 0x53475431;  // "SGT1"
+
+// 轨迹中记录的调用类型
+enum class TraceOp : uint32_t {
+    kNetworkProject = 0,  // 线网投影：`LineNetwork::project(point, mode)`
+    kLineDistance = 1,    // 点到折线距离：`distance(point, lines[line_id], mode)`
+    kPointDistance = 2,   // 点到点距离：`distance(point, other)`
+};
+
+struct TraceFileHeader {
+    uint32_t magic = kTraceMagic;
+    uint32_t event_size = 0;  // 单条记录的字节数，用于检查格式版本
+};
+
+struct TraceEvent {
+    uint64_t timestamp_ns = 0;  // 相对于开始记录时刻的纳秒数
+    uint32_t op = 0;            // `TraceOp` 的取值
+    uint32_t mode = 0;          // `ProjectionMode` 的取值
+    uint64_t line_id = 0;       // `kLineDistance` 中折线在线网中的编号
+    double x = 0., y = 0.;      // 查询点
+    double x2 = 0., y2 = 0.;    // `kPointDistance` 中的另一个点
+};
+
+static_assert(sizeof(TraceEvent) == 56, "trace event layout is part of the file format");
+
+/**
+ * @brief 调用轨迹的记录器，以固定采样率将投影与距离计算的参数写入二进制文件。
+ *
+ * 采样由调用序号的哈希决定，不需要加锁；被采样的记录先写入内存缓冲区，缓冲区满或析构时批量写入文件。
+ * 可以在多个线程中同时调用。
+ */
+class TraceRecorder {
+public:
+    /**
+     * @brief 创建记录器并写入文件头。
+     *
+     * @param [in] path 输出文件路径，已存在时会被覆盖。
+     * @param [in] sample_rate 采样率，取值范围 [0, 1]。
+     */
+    explicit TraceRecorder(const std::string &path, double sample_rate = 1.)
+        : out_(path, std::ios::binary | std::ios::trunc), start_(std::chrono::steady_clock::now()) {
+        if (!out_) {
+            throw std::runtime_error("failed to open trace file: " + path);
+        }
+        double rate = std::clamp(sample_rate, 0., 1.);
+        threshold_ = rate >= 1. ? UINT64_MAX : static_cast<uint64_t>(rate * 18446744073709551615.);
+        TraceFileHeader header;
+        header.event_size = sizeof(TraceEvent);
+        out_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        buffer_.reserve(kBufferEvents);
+    }
+
+    ~TraceRecorder() { flush(); }
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+    template <typename Point>
+    void record_projection(const Point &point, ProjectionMode mode) {
+        if (sample()) {
+            TraceEvent event = make_event(TraceOp::kNetworkProject, point);
+            event.mode = static_cast<uint32_t>(mode);
+            append(event);
+        }
+    }
+
+    template <typename Point>
+    void record_line_distance(const Point &point, size_t line_id, ProjectionMode mode) {
+        if (sample()) {
+            TraceEvent event = make_event(TraceOp::kLineDistance, point);
+            event.mode = static_cast<uint32_t>(mode);
+            event.line_id = line_id;
+            append(event);
+        }
+    }
+
+    template <typename Point>
+    void record_point_distance(const Point &point, const Point &other) {
+        if (sample()) {
+            TraceEvent event = make_event(TraceOp::kPointDistance, point);
+            event.x2 = bg::get<0>(other);
+            event.y2 = bg::get<1>(other);
+            append(event);
+        }
+    }
+
+    // 将缓冲区中的记录写入文件
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        write_buffer();
+        out_.flush();
+    }
+
+    // 已经记录（被采样）的调用数量
+    size_t recorded() const { return recorded_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kBufferEvents = 4096;
+
+    bool sample() {
+        if (threshold_ == 0) {
+            return false;
+        }
+        // SplitMix64 打散调用序号，使采样在时间上均匀且结果可复现
+        uint64_t z = calls_.fetch_add(1, std::memory_order_relaxed) + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return (z ^ (z >> 31)) <= threshold_;
+    }
+
+    template <typename Point>
+    TraceEvent make_event(TraceOp op, const Point &point) const {
+        static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+        TraceEvent event;
+        event.timestamp_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+        event.op = static_cast<uint32_t>(op);
+        event.x = bg::get<0>(point);
+        event.y = bg::get<1>(point);
+        return event;
+    }
+
+    void append(const TraceEvent &event) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer_.push_back(event);
+        recorded_.fetch_add(1, std::memory_order_relaxed);
+        if (buffer_.size() >= kBufferEvents) {
+            write_buffer();
+        }
+    }
+
+    void write_buffer() {
+        out_.write(reinterpret_cast<const char *>(buffer_.data()),
+                   static_cast<std::streamsize>(buffer_.size() * sizeof(TraceEvent)));
+        buffer_.clear();
+    }
+
+    std::ofstream out_;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t threshold_ = UINT64_MAX;
+    std::atomic<uint64_t> calls_{0};
+    std::atomic<size_t> recorded_{0};
+    std::mutex mutex_;
+    std::vector<TraceEvent> buffer_;
+};
+
+/**
+ * @brief 带调用轨迹记录的线网查询入口。
+ *
+ * 投影、点到线网中折线的距离以及点到点的距离在计算前按记录器的采样率写入轨迹，记录的调用可以由
+ * `replay_trace` 在同一线网上原样回放。需要记录的调用方持有该对象代替直接调用 `LineNetwork` 与 `distance`。
+ *
+ * @tparam Point 二维点类型。
+ */
+template <typename Point>
+class TracedNetwork {
+public:
+    TracedNetwork(const LineNetwork<Point> &network, TraceRecorder &recorder)
+        : network_(&network), recorder_(&recorder) {}
+
+    const LineNetwork<Point> &network() const { return *network_; }
+
+    NetworkProjection project(const Point &point, ProjectionMode mode,
+                              double search_radius = LineNetwork<Point>::kDefaultSearchRadius) const {
+        recorder_->record_projection(point, mode);
+        return network_->project(point, mode, search_radius);
+    }
+
+    /**
+     * @brief 点到线网中第 `line_id` 条折线的距离，语义与 `distance(point, line, mode)` 相同。
+     *
+     * @throw std::out_of_range 折线编号超出线网范围，此时调用仍会被记录，回放时计为无效调用。
+     */
+    std::pair<double, double> distance(const Point &point, size_t line_id, ProjectionMode mode) const {
+        recorder_->record_line_distance(point, line_id, mode);
+        return simplegeom::distance(point, network_->line(line_id), mode);
+    }
+
+    double distance(const Point &point, const Point &other) const {
+        recorder_->record_point_distance(point, other);
+        return simplegeom::distance(point, other);
+    }
+
+private:
+    const LineNetwork<Point> *network_;
+    TraceRecorder *recorder_;
+};
+
+/**
+ * @brief 读取调用轨迹文件，文件尾部不完整的记录会被忽略。
+ *
+ * @param [in] path 轨迹文件路径。
+ * @return std::vector<TraceEvent> 按记录顺序排列的调用。
+ */
+inline std::vector<TraceEvent> read_trace(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("failed to open trace file: " + path);
+    }
+    TraceFileHeader header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != kTraceMagic ||
+        header.event_size != sizeof(TraceEvent)) {
+        throw std::runtime_error("invalid trace file: " + path);
+    }
+    std::vector<TraceEvent> events;
+    TraceEvent event;
+    while (in.read(reinterpret_cast<char *>(&event), sizeof(event))) {
+        if (event.op > static_cast<uint32_t>(TraceOp::kPointDistance) ||
+            event.mode > static_cast<uint32_t>(ProjectionMode::kAccumulate)) {
+            throw std::runtime_error("invalid trace event in " + path);
+        }
+        events.push_back(event);
+    }
+    return events;
+}
+
+// 轨迹回放的配置项
+struct TraceReplayOptions {
+    bool original_timing = false;  // 为 true 时按记录的时间间隔发起调用，否则全速回放
+    double speed = 1.;             // 按原始时间回放时的加速倍数
+    size_t num_threads = 1;        // 并发回放的线程数
+    double search_radius = LineNetwork<Point2>::kDefaultSearchRadius;
+};
+
+// 轨迹回放的统计结果
+struct TraceReplayStats {
+    size_t events = 0;
+    size_t invalid = 0;                // 折线编号超出线网范围而跳过的调用
+    double seconds = 0.;               // 回放总耗时
+    std::vector<double> latencies_us;  // 每次调用的延迟（微秒），升序排列
+
+    double throughput() const { return seconds > 0. ? events / seconds : 0.; }
+
+    // 延迟的分位数，`q` 取值范围 [0, 1]
+    double percentile(double q) const {
+        if (latencies_us.empty()) {
+            return 0.;
+        }
+        return latencies_us[std::min(latencies_us.size() - 1, static_cast<size_t>(q * latencies_us.size()))];
+    }
+};
+
+/**
+ * @brief 将调用轨迹回放到线网上，统计吞吐量和延迟分布。
+ *
+ * 全速回放时延迟为单次调用的耗时；按原始时间回放时延迟从记录的发起时刻开始计算，
+ * 包含回放线程忙碌导致的排队时间，避免只统计已发起调用而低估高负载下的延迟。
+ *
+ * @tparam Point 二维点类型，需要与记录时一致。
+ * @param [in] network 线网，`kLineDistance` 中的折线编号指向其中的折线。
+ * @param [in] events 调用轨迹。
+ * @param [in] options 回放配置。
+ * @param [in] pool 可选，回放线程所在的线程池，为空时使用内部线程池。
+ * @return TraceReplayStats 回放统计。
+ */
+template <typename Point>
+TraceReplayStats replay_trace(const LineNetwork<Point> &network, const std::vector<TraceEvent> &events,
+                              const TraceReplayOptions &options = TraceReplayOptions(), ThreadPool *pool = nullptr) {
+    TraceReplayStats stats;
+    stats.events = events.size();
+    stats.latencies_us.resize(events.size());
+    if (events.empty()) {
+        return stats;
+    }
+
+    size_t threads = std::max<size_t>(1, options.num_threads);
+    std::unique_ptr<ThreadPool> own_pool;
+    if (pool == nullptr) {
+        own_pool = std::make_unique<ThreadPool>(threads);
+        pool = own_pool.get();
+    }
+
+    uint64_t first_ns = events.front().timestamp_ns;
+    double speed = options.speed > 0. ? options.speed : 1.;
+    std::atomic<size_t> next{0}, invalid{0};
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&] {
+        for (size_t i = next.fetch_add(1); i < events.size(); i = next.fetch_add(1)) {
+            const auto &event = events[i];
+            auto issued = std::chrono::steady_clock::now();
+            if (options.original_timing) {
+                auto offset = std::chrono::nanoseconds(
+                    static_cast<int64_t>((event.timestamp_ns - std::min(event.timestamp_ns, first_ns)) / speed));
+                auto scheduled = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset);
+                std::this_thread::sleep_until(scheduled);
+                issued = scheduled;
+            }
+
+            Point point(event.x, event.y);
+            auto mode = static_cast<ProjectionMode>(event.mode);
+            volatile double sink = 0.;  // 防止调用结果被优化掉
+            switch (static_cast<TraceOp>(event.op)) {
+                case TraceOp::kNetworkProject:
+                    sink = network.project(point, mode, options.search_radius).distance;
+                    break;
+                case TraceOp::kLineDistance:
+                    if (event.line_id < network.size()) {
+                        sink = simplegeom::distance(point, network.line(event.line_id), mode).first;
+                    } else {
+                        invalid.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                case TraceOp::kPointDistance:
+                    sink = simplegeom::distance(point, Point(event.x2, event.y2));
+                    break;
+            }
+            (void)sink;
+            stats.latencies_us[i] =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - issued).count();
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (size_t t = 0; t < threads; ++t) {
+        futures.push_back(pool->submit(worker));
+    }
+    for (auto &f : futures) {
+        f.wait();
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto &f : futures) {
+        f.get();
+    }
+
+    stats.invalid = invalid.load();
+    std::sort(stats.latencies_us.begin(), stats.latencies_us.end());
+    return stats;
+}
+
+}  // namespace simplegeom
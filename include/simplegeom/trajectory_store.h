@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "simplegeom/common.h"
+#include "simplegeom/thread_pool.h"
+#include "simplegeom/trajectory.h"
+
+namespace simplegeom {
+
+// 轨迹存储的参数
+struct TrajectoryStoreOptions {
+    size_t block_points = 256;      // 每个压缩块的点数
+    double coordinate_scale = 1e7;  // 坐标量化比例，地理坐标下 1e7 约为 1 厘米
+    double time_scale = 1e3;        // 时间戳量化比例，1e3 为毫秒
+};
+
+// 时空范围查询命中的一个轨迹点
+template <typename Point>
+struct TrajectoryHit {
+    uint64_t object_id;
+    double timestamp;
+    Point point;
+};
+
+/**
+ * @brief 按时间组织的轨迹存储，支持实时追加与“时间窗口 + 外包框”的范围查询。
+ *
+ * 每个对象的新点先进入该对象的写入缓冲区，缓冲区满 `block_points` 个点后封装为一个压缩块：坐标与时间戳
+ * 按比例量化为整数，与前一个点做差分后以 zigzag + varint 编码，通常每个点只占 5～8 字节。每个块记录自己的
+ * 外包框与时间范围，每 64 个相邻的块再合并一个外包框与时间范围（相邻的块通常在相近的时间封装）。查询先跳过
+ * 与查询范围不相交的块组，再只解码与查询范围相交的块，候选块在线程池中并行解码。
+ *
+ * 坐标与时间戳在写入时即量化，查询结果与判断都基于量化后的值。`append` 与查询可以在多个线程中同时调用：
+ * 查询在共享锁下筛选候选块并复制写入缓冲区中的命中点，随后在锁外解码已封装（不再修改）的块。
+ *
+ * @tparam Point 二维点类型，通常为 `PointGeo2`。
+ */
+template <typename Point>
+class TrajectoryStore {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    explicit TrajectoryStore(TrajectoryStoreOptions options = {}) : options_(options) {}
+
+    TrajectoryStore(const TrajectoryStore &) = delete;
+    TrajectoryStore &operator=(const TrajectoryStore &) = delete;
+
+    /**
+     * @brief 追加对象的一个点，同一对象的时间戳应当非递减。
+     */
+    void append(uint64_t object_id, const Point &point, double timestamp) {
+        Sample sample{quantize(bg::get<0>(point), options_.coordinate_scale),
+                      quantize(bg::get<1>(point), options_.coordinate_scale),
+                      quantize(timestamp, options_.time_scale)};
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto &buffer = buffers_[object_id];
+        Envelope point_envelope{sample.x, sample.y, sample.x, sample.y, sample.t, sample.t};
+        if (buffer.samples.empty()) {
+            buffer.envelope = point_envelope;
+        } else {
+            buffer.envelope.expand(point_envelope);
+        }
+        buffer.samples.push_back(sample);
+        ++size_;
+        if (buffer.samples.size() >= options_.block_points) {
+            seal(object_id, buffer);
+        }
+    }
+
+    /**
+     * @brief 追加一段轨迹的全部点。
+     */
+    void append(uint64_t object_id, const Trajectory<Point> &trajectory) {
+        for (size_t i = 0; i < trajectory.size(); ++i) {
+            append(object_id, trajectory.points[i], trajectory.timestamps[i]);
+        }
+    }
+
+    /**
+     * @brief 将所有写入缓冲区封装为压缩块，例如在一天的数据写入完成后调用。
+     */
+    void flush() {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto &[object_id, buffer] : buffers_) {
+            if (!buffer.samples.empty()) {
+                seal(object_id, buffer);
+            }
+        }
+    }
+
+    /**
+     * @brief 查询在时间窗口 [t0, t1] 内位于外包框中的所有轨迹点。
+     *
+     * @param [in] box 查询范围（含边界）。
+     * @param [in] t0 时间窗口起点（含）。
+     * @param [in] t1 时间窗口终点（含）。
+     * @param [in] pool 用于并行解码的线程池，可以为空。
+     * @return std::vector<TrajectoryHit<Point>> 按对象编号与时间戳排序的命中点。
+     */
+    std::vector<TrajectoryHit<Point>> query(const Box<Point> &box, double t0, double t1,
+                                            ThreadPool *pool = nullptr) const {
+        Range range{quantize(bg::get<bg::min_corner, 0>(box), options_.coordinate_scale),
+                    quantize(bg::get<bg::min_corner, 1>(box), options_.coordinate_scale),
+                    quantize(bg::get<bg::max_corner, 0>(box), options_.coordinate_scale),
+                    quantize(bg::get<bg::max_corner, 1>(box), options_.coordinate_scale),
+                    quantize(t0, options_.time_scale), quantize(t1, options_.time_scale)};
+
+        std::vector<TrajectoryHit<Point>> hits;
+        std::vector<const Block *> candidates;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            for (size_t g = 0; g < groups_.size(); ++g) {
+                if (!range.intersects(groups_[g])) {
+                    continue;
+                }
+                size_t end = std::min(blocks_.size(), (g + 1) * kGroupBlocks);
+                for (size_t i = g * kGroupBlocks; i < end; ++i) {
+                    if (range.intersects(*blocks_[i])) {
+                        candidates.push_back(blocks_[i].get());
+                    }
+                }
+            }
+            for (const auto &[object_id, buffer] : buffers_) {
+                if (buffer.samples.empty() || !range.intersects(buffer.envelope)) {
+                    continue;
+                }
+                for (const auto &sample : buffer.samples) {
+                    if (range.contains(sample)) {
+                        hits.push_back(hit(object_id, sample));
+                    }
+                }
+            }
+        }
+
+        std::mutex mutex;
+        parallel_for(
+            pool, candidates.size(),
+            [&](size_t begin, size_t end) {
+                std::vector<TrajectoryHit<Point>> local;
+                for (size_t i = begin; i < end; ++i) {
+                    decode(*candidates[i], [&](const Sample &sample) {
+                        if (range.contains(sample)) {
+                            local.push_back(hit(candidates[i]->object_id, sample));
+                        }
+                    });
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                hits.insert(hits.end(), local.begin(), local.end());
+            },
+            4);
+
+        std::sort(hits.begin(), hits.end(), [](const TrajectoryHit<Point> &a, const TrajectoryHit<Point> &b) {
+            if (a.object_id != b.object_id) {
+                return a.object_id < b.object_id;
+            }
+            if (a.timestamp != b.timestamp) {
+                return a.timestamp < b.timestamp;
+            }
+            return bg::get<0>(a.point) < bg::get<0>(b.point) ||
+                   (bg::get<0>(a.point) == bg::get<0>(b.point) && bg::get<1>(a.point) < bg::get<1>(b.point));
+        });
+        return hits;
+    }
+
+    /**
+     * @brief 查询在时间窗口 [t0, t1] 内至少有一个定位点落在外包框内的对象编号，按编号升序排列。
+     *
+     * 只检查定位点，不检查相邻定位点之间的连线：两次定位之间穿过外包框而两端都在框外的对象不会返回。
+     */
+    std::vector<uint64_t> query_objects(const Box<Point> &box, double t0, double t1, ThreadPool *pool = nullptr) const {
+        std::vector<uint64_t> ids;
+        for (const auto &hit : query(box, t0, t1, pool)) {
+            if (ids.empty() || ids.back() != hit.object_id) {
+                ids.push_back(hit.object_id);
+            }
+        }
+        return ids;
+    }
+
+    // 已写入的点数
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return size_;
+    }
+
+    // 已封装的压缩块数量
+    size_t block_count() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return blocks_.size();
+    }
+
+    // 已封装的压缩块的编码字节数
+    size_t compressed_bytes() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return compressed_bytes_;
+    }
+
+private:
+    struct Sample {
+        int64_t x, y, t;
+    };
+
+    // 量化坐标下的外包框与时间范围
+    struct Envelope {
+        int64_t min_x, min_y, max_x, max_y, min_t, max_t;
+
+        void expand(const Envelope &e) {
+            min_x = std::min(min_x, e.min_x);
+            min_y = std::min(min_y, e.min_y);
+            max_x = std::max(max_x, e.max_x);
+            max_y = std::max(max_y, e.max_y);
+            min_t = std::min(min_t, e.min_t);
+            max_t = std::max(max_t, e.max_t);
+        }
+    };
+
+    struct Block : Envelope {
+        uint64_t object_id;
+        uint32_t count;
+        std::vector<uint8_t> data;
+    };
+
+    // 对象的写入缓冲区
+    struct OpenBuffer {
+        Envelope envelope;
+        std::vector<Sample> samples;
+    };
+
+    static constexpr size_t kGroupBlocks = 64;
+
+    struct Range {
+        int64_t min_x, min_y, max_x, max_y, t0, t1;
+
+        bool intersects(const Envelope &b) const {
+            return b.min_t <= t1 && b.max_t >= t0 && b.min_x <= max_x && b.max_x >= min_x && b.min_y <= max_y &&
+                   b.max_y >= min_y;
+        }
+        bool contains(const Sample &s) const {
+            return s.t >= t0 && s.t <= t1 && s.x >= min_x && s.x <= max_x && s.y >= min_y && s.y <= max_y;
+        }
+    };
+
+    // 超出 int64 范围的值（例如表示“不限”的极大时间窗口）截断到 ±9e18
+    static int64_t quantize(double v, double scale) { return std::llround(std::clamp(v * scale, -9e18, 9e18)); }
+
+    static void put_varint(std::vector<uint8_t> &out, int64_t v) {
+        uint64_t z = (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);  // zigzag
+        while (z >= 0x80) {
+            out.push_back(static_cast<uint8_t>(z | 0x80));
+            z >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(z));
+    }
+
+    static int64_t get_varint(const uint8_t *&p) {
+        uint64_t z = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t byte = *p++;
+            z |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                break;
+            }
+        }
+        return static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+    }
+
+    // 将写入缓冲区编码为压缩块并清空缓冲区，调用方需要持有写锁
+    void seal(uint64_t object_id, OpenBuffer &buffer) {
+        auto block = std::make_unique<Block>();
+        block->object_id = object_id;
+        block->count = static_cast<uint32_t>(buffer.samples.size());
+        static_cast<Envelope &>(*block) = buffer.envelope;
+        block->data.reserve(buffer.samples.size() * 6);
+        Sample prev{0, 0, 0};
+        for (const auto &s : buffer.samples) {
+            put_varint(block->data, s.x - prev.x);
+            put_varint(block->data, s.y - prev.y);
+            put_varint(block->data, s.t - prev.t);
+            prev = s;
+        }
+        block->data.shrink_to_fit();
+        compressed_bytes_ += block->data.size();
+        if (blocks_.size() % kGroupBlocks == 0) {
+            groups_.push_back(*block);
+        } else {
+            groups_.back().expand(*block);
+        }
+        blocks_.push_back(std::move(block));
+        buffer.samples.clear();
+    }
+
+    template <typename Func>
+    static void decode(const Block &block, Func &&func) {
+        const uint8_t *p = block.data.data();
+        Sample s{0, 0, 0};
+        for (uint32_t i = 0; i < block.count; ++i) {
+            s.x += get_varint(p);
+            s.y += get_varint(p);
+            s.t += get_varint(p);
+            func(s);
+        }
+    }
+
+    TrajectoryHit<Point> hit(uint64_t object_id, const Sample &s) const {
+        return {object_id, static_cast<double>(s.t) / options_.time_scale,
+                Point(static_cast<double>(s.x) / options_.coordinate_scale,
+                      static_cast<double>(s.y) / options_.coordinate_scale)};
+    }
+
+    TrajectoryStoreOptions options_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<uint64_t, OpenBuffer> buffers_;
+    std::vector<std::unique_ptr<const Block>> blocks_;
+    std::vector<Envelope> groups_;  // 每 `kGroupBlocks` 个相邻块的合并范围
+    size_t size_ = 0;
+    size_t compressed_bytes_ = 0;
+};
+
+}  // namespace simplegeom
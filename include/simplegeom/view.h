@@ -0,0 +1,172 @@
+#pragma once
+
+#include <iterator>
+#include <vector>
+
+#include "simplegeom/algorithm.h"
+#include "simplegeom/common.h"
+
+namespace simplegeom {
+
+/**
+ * @brief 连续存放的点序列的只读视图（C++17 中 `std::span<const Point>` 的替代）。
+ *
+ * 不持有数据，调用方需要保证视图使用期间底层内存有效。可以直接由 `LineString`、`std::vector<Point>`
+ * 或任意 `const Point *` 与长度构造。
+ *
+ * @tparam Point 点的类型。
+ */
+template <typename Point>
+class PointSpan {
+public:
+    using value_type = Point;
+    using const_iterator = const Point *;
+
+    PointSpan() = default;
+    PointSpan(const Point *data, size_t size) : data_(data), size_(size) {}
+    PointSpan(const LineString<Point> &line) : data_(line.data()), size_(line.size()) {}
+    PointSpan(const std::vector<Point> &points) : data_(points.data()), size_(points.size()) {}
+
+    const Point *data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const Point &operator[](size_t i) const { return data_[i]; }
+    const Point *begin() const { return data_; }
+    const Point *end() const { return data_ + size_; }
+
+    // 从第 `offset` 个点开始、长度为 `count` 的子视图
+    PointSpan subspan(size_t offset, size_t count) const { return PointSpan(data_ + offset, count); }
+
+private:
+    const Point *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief 按步长读取坐标的二维点视图。
+ *
+ * 第 i 个点的坐标为 `(x[i * stride], y[i * stride])`，可以覆盖常见的外部存储布局而无需复制：
+ *   - 交错存放的 `[x0, y0, x1, y1, ...]`（例如 protobuf 的 repeated double）：
+ *     `x = coords, y = coords + 1, stride = 2`；
+ *   - 分列存放的 x、y 数组（例如 Arrow 的两列）：`stride = 1`；
+ *   - 结构体数组中的坐标字段：`stride = sizeof(Record) / sizeof(double)`。
+ *
+ * 迭代器解引用时按值构造 `Point`。
+ *
+ * @tparam Point 二维点类型。
+ */
+template <typename Point>
+class StridedPointView {
+    static_assert(bg::dimension<Point>::value == 2, "Only support 2D point");
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Point;
+
+        const_iterator() = default;
+        const_iterator(const StridedPointView *view, size_t index) : view_(view), index_(index) {}
+
+        Point operator*() const { return (*view_)[index_]; }
+        Point operator[](difference_type n) const { return (*view_)[index_ + n]; }
+
+        const_iterator &operator++() {
+            ++index_;
+            return *this;
+        }
+        const_iterator &operator--() {
+            --index_;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            auto it = *this;
+            ++index_;
+            return it;
+        }
+        const_iterator operator--(int) {
+            auto it = *this;
+            --index_;
+            return it;
+        }
+        const_iterator &operator+=(difference_type n) {
+            index_ += n;
+            return *this;
+        }
+        const_iterator &operator-=(difference_type n) {
+            index_ -= n;
+            return *this;
+        }
+        const_iterator operator+(difference_type n) const { return const_iterator(view_, index_ + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(view_, index_ - n); }
+        difference_type operator-(const const_iterator &other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const const_iterator &other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator &other) const { return index_ != other.index_; }
+        bool operator<(const const_iterator &other) const { return index_ < other.index_; }
+        bool operator>(const const_iterator &other) const { return index_ > other.index_; }
+        bool operator<=(const const_iterator &other) const { return index_ <= other.index_; }
+        bool operator>=(const const_iterator &other) const { return index_ >= other.index_; }
+
+    private:
+        const StridedPointView *view_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    StridedPointView() = default;
+    StridedPointView(const double *x, const double *y, size_t size, size_t stride)
+        : x_(x), y_(y), size_(size), stride_(stride) {}
+
+    // 交错存放的坐标 `[x0, y0, x1, y1, ...]`，`size` 为点数
+    static StridedPointView interleaved(const double *coords, size_t size) {
+        return StridedPointView(coords, coords + 1, size, 2);
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    Point operator[](size_t i) const { return Point(x_[i * stride_], y_[i * stride_]); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    // 复制为 `LineString`，供需要具体几何类型的 Boost.Geometry 算法使用
+    LineString<Point> to_linestring() const { return LineString<Point>(begin(), end()); }
+
+private:
+    const double *x_ = nullptr;
+    const double *y_ = nullptr;
+    size_t size_ = 0;
+    size_t stride_ = 2;
+};
+
+/**
+ * @brief 计算点在点序列视图表示的折线上的投影结果，语义与 `project(point, line)` 相同。
+ */
+template <typename Point>
+LineProjection project(const Point &point, const PointSpan<Point> &line) {
+    return project(point, line.begin(), line.end());
+}
+
+template <typename Point>
+LineProjection project(const Point &point, const StridedPointView<Point> &line) {
+    return project(point, line.begin(), line.end());
+}
+
+/**
+ * @brief 计算点到点序列视图表示的折线的最短距离及投影距离，语义与 `distance(point, line, mode)` 相同。
+ */
+template <typename Point>
+std::pair<double, double> distance(const Point &point, const PointSpan<Point> &line, ProjectionMode mode) {
+    return distance(point, line.begin(), line.end(), mode);
+}
+
+template <typename Point>
+std::pair<double, double> distance(const Point &point, const StridedPointView<Point> &line, ProjectionMode mode) {
+    return distance(point, line.begin(), line.end(), mode);
+}
+
+}  // namespace simplegeom
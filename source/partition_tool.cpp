@@ -0,0 +1,108 @@
+#include <fstream>
+#include <iostream>
+
+#include "simplegeom/partition.h"
+#include "simplegeom/service.h"
+#include "simplegeom/simplegeom.h"
+#include "simplegeom/synthetic.h"
+
+using namespace simplegeom;
+
+namespace {
+
+// 将线网划分为若干分区，分别写出每个分区的折线文件以及分区信息
+int split(const std::string &lines_path, size_t partitions, double halo, const std::string &prefix) {
+    auto lines = read_wkt_file<LineString<PointGeo2>>(lines_path);
+    PartitionOptions options;
+    options.partitions = partitions;
+    options.halo = halo;
+    SpatialPartitioning<PointGeo2> partitioning(lines, options);
+
+    std::ofstream manifest(prefix + ".partitions");
+    partitioning.save(manifest);
+    for (size_t p = 0; p < partitioning.size(); ++p) {
+        std::ofstream out(prefix + "." + std::to_string(p) + ".wkt");
+        for (const auto &line : partitioning.extract(lines, p)) {
+            out << wkt_str(line) << '\n';
+        }
+        const auto &partition = partitioning.partition(p);
+        std::cout << "partition " << p << ": " << partition.line_ids.size() << " lines, " << partition.vertices
+                  << " vertices." << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * 通过各分区的投影服务（套接字为 `<socket_prefix>.<p>`）查询随机点，合并结果并与完整线网的本地查询比较。
+ */
+int verify(const std::string &manifest_path, const std::string &socket_prefix, const std::string &lines_path,
+           size_t count) {
+    std::ifstream manifest(manifest_path);
+    auto partitioning = SpatialPartitioning<PointGeo2>::load(manifest);
+    auto lines = read_wkt_file<LineString<PointGeo2>>(lines_path);
+    LineNetwork<PointGeo2> network(lines);
+    auto queries = generate_query_points(lines, count, 200.);
+
+    std::vector<std::unique_ptr<ProjectionClient<PointGeo2>>> clients;
+    for (size_t p = 0; p < partitioning.size(); ++p) {
+        clients.push_back(std::make_unique<ProjectionClient<PointGeo2>>(socket_prefix + "." + std::to_string(p)));
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    // 按分区分组，每个分区只发送一个请求
+    std::vector<std::vector<size_t>> routed(partitioning.size());
+    size_t visits = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t p : partitioning.route(queries[i], LineNetwork<PointGeo2>::kDefaultSearchRadius)) {
+            routed[p].push_back(i);
+            ++visits;
+        }
+    }
+    std::vector<std::vector<NetworkProjection>> results(queries.size());
+    std::vector<std::vector<const std::vector<size_t> *>> line_ids(queries.size());
+    for (size_t p = 0; p < partitioning.size(); ++p) {
+        std::vector<PointGeo2> points;
+        for (size_t i : routed[p]) {
+            points.push_back(queries[i]);
+        }
+        auto response = points.empty() ? std::vector<NetworkProjection>()
+                                       : clients[p]->project(points, ProjectionMode::kAccumulate);
+        for (size_t k = 0; k < routed[p].size(); ++k) {
+            results[routed[p][k]].push_back(response[k]);
+            line_ids[routed[p][k]].push_back(&partitioning.partition(p).line_ids);
+        }
+    }
+    std::vector<NetworkProjection> merged(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        merged[i] = merge_projections(results[i], line_ids[i]);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto expected = network.project(queries[i], ProjectionMode::kAccumulate);
+        if (expected.valid() != merged[i].valid() || expected.distance != merged[i].distance) {
+            ++mismatches;
+        }
+    }
+    std::cout << "queried " << queries.size() << " points in " << elapsed << "s, " << double(visits) / queries.size()
+              << " partitions per point, " << mismatches << " mismatches." << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+// 空间分区工具：`split` 生成分区，`verify` 通过多个投影服务进程查询并验证合并结果
+int main(int argc, char **argv) {
+    std::string command = argc > 1 ? argv[1] : "";
+    if (command == "split" && argc > 5) {
+        return split(argv[2], std::stoul(argv[3]), std::stod(argv[4]), argv[5]);
+    }
+    if (command == "verify" && argc > 4) {
+        return verify(argv[2], argv[3], argv[4], argc > 5 ? std::stoul(argv[5]) : 1000);
+    }
+    std::cerr << "usage: " << argv[0] << " split <lines.wkt> <partitions> <halo> <out_prefix>\n"
+              << "       " << argv[0] << " verify <prefix.partitions> <socket_prefix> <lines.wkt> [count=1000]"
+              << std::endl;
+    return 1;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "simplegeom/service.h"
+#include "simplegeom/simplegeom.h"
+
+// 投影服务的压测客户端：多个连接并发发送批量请求，统计吞吐量与 p50/p99 延迟
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0]
+                  << " <socket_path> [clients=4] [requests=1000] [batch=64] [min_lon min_lat max_lon max_lat]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string socket_path = argv[1];
+    size_t clients = argc > 2 ? std::stoul(argv[2]) : 4;
+    size_t requests = argc > 3 ? std::stoul(argv[3]) : 1000;
+    size_t batch = argc > 4 ? std::stoul(argv[4]) : 64;
+    double min_lon = 116.3, min_lat = 39.9, max_lon = 116.5, max_lat = 40.0;
+    if (argc > 8) {
+        min_lon = std::stod(argv[5]);
+        min_lat = std::stod(argv[6]);
+        max_lon = std::stod(argv[7]);
+        max_lat = std::stod(argv[8]);
+    }
+
+    std::vector<std::vector<double>> latencies(clients);
+    std::vector<size_t> hits(clients, 0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&, c] {
+            simplegeom::ProjectionClient<simplegeom::PointGeo2> client(socket_path);
+            std::mt19937_64 rng(c + 1);
+            std::uniform_real_distribution<double> lon(min_lon, max_lon);
+            std::uniform_real_distribution<double> lat(min_lat, max_lat);
+
+            std::vector<simplegeom::PointGeo2> points(batch);
+            latencies[c].reserve(requests);
+            for (size_t r = 0; r < requests; ++r) {
+                for (auto &p : points) {
+                    p = simplegeom::PointGeo2(lon(rng), lat(rng));
+                }
+                auto begin = std::chrono::high_resolution_clock::now();
+                auto results = client.project(points, simplegeom::ProjectionMode::kAccumulate);
+                latencies[c].push_back(
+                    std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - begin)
+                        .count());
+                hits[c] += std::count_if(results.begin(), results.end(), [](const auto &x) { return x.valid(); });
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    std::vector<double> all;
+    size_t total_hits = 0;
+    for (size_t c = 0; c < clients; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        total_hits += hits[c];
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&all](double q) {
+        return all.empty() ? 0. : all[std::min(all.size() - 1, size_t(q * all.size()))];
+    };
+
+    size_t total_points = clients * requests * batch;
+    std::cout << "requests: " << all.size() << ", points: " << total_points << ", matched: " << total_hits << std::endl;
+    std::cout << "throughput: " << total_points / elapsed << " points/s, " << all.size() / elapsed << " requests/s"
+              << std::endl;
+    std::cout << "latency p50: " << percentile(0.5) << "us, p99: " << percentile(0.99) << "us, max: "
+              << (all.empty() ? 0. : all.back()) << "us." << std::endl;
+}
@@ -0,0 +1,65 @@
+#include <csignal>
+#include <iostream>
+
+#include "simplegeom/service.h"
+#include "simplegeom/simplegeom.h"
+
+namespace {
+simplegeom::ProjectionServer<simplegeom::PointGeo2> *g_server = nullptr;
+
+void handle_signal(int) {
+    if (g_server != nullptr) {
+        g_server->stop();
+    }
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0]
+                  << " <socket_path> <lines.wkt> [batch_window_us] [threads] [trace.bin] [trace_sample_rate]"
+                  << std::endl;
+        return 1;
+    }
+
+    // 每行一个 LINESTRING
+    auto start = std::chrono::high_resolution_clock::now();
+    simplegeom::LineNetwork<simplegeom::PointGeo2> network(
+        simplegeom::read_wkt_file<simplegeom::LineString<simplegeom::PointGeo2>>(argv[2]));
+    std::cout << "loaded " << network.size() << " lines in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -
+                                                                       start)
+                     .count()
+              << "ms." << std::endl;
+
+    simplegeom::ProjectionServerOptions options;
+    options.socket_path = argv[1];
+    if (argc > 3) {
+        options.batch_window = std::chrono::microseconds(std::stoll(argv[3]));
+    }
+    if (argc > 4) {
+        options.num_threads = std::stoul(argv[4]);
+    }
+    // 可选地将采样的请求记录为调用轨迹，供 trace_replay 离线回放
+    if (argc > 5) {
+        options.trace_path = argv[5];
+    }
+    if (argc > 6) {
+        options.trace_sample_rate = std::stod(argv[6]);
+    }
+
+    simplegeom::ProjectionServer<simplegeom::PointGeo2> server(network, options);
+    g_server = &server;
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    std::cout << "listening on " << options.socket_path << ", batch window " << options.batch_window.count() << "us."
+              << std::endl;
+    server.run();
+    g_server = nullptr;
+
+    std::cout << "served " << server.points() << " points in " << server.batches() << " batches." << std::endl;
+    if (!options.trace_path.empty()) {
+        std::cout << "traced " << server.traced() << " points to " << options.trace_path << "." << std::endl;
+    }
+}
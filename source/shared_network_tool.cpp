@@ -0,0 +1,46 @@
+#include <iostream>
+
+#include "simplegeom/shared_network.h"
+#include "simplegeom/simplegeom.h"
+
+// 共享内存线网的管理工具：发布新版本、删除，以及在已发布的线网上查询投影
+int main(int argc, char **argv) {
+    using simplegeom::PointGeo2;
+
+    std::string command = argc > 2 ? argv[1] : "";
+    if (command == "publish" && argc > 3) {
+        auto start = std::chrono::high_resolution_clock::now();
+        simplegeom::LineNetwork<PointGeo2> network(
+            simplegeom::read_wkt_file<simplegeom::LineString<PointGeo2>>(argv[3]));
+        auto version = simplegeom::publish_shared_network(argv[2], network);
+        std::cout << "published " << network.size() << " lines as " << argv[2] << " version " << version << " in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -
+                                                                           start)
+                         .count()
+                  << "ms." << std::endl;
+        return 0;
+    }
+    if (command == "remove") {
+        simplegeom::remove_shared_network(argv[2]);
+        return 0;
+    }
+    if (command == "query" && argc > 4) {
+        simplegeom::SharedNetwork<PointGeo2> network(argv[2]);
+        PointGeo2 point(std::stod(argv[3]), std::stod(argv[4]));
+        auto result = network.project(point, simplegeom::ProjectionMode::kAccumulate);
+        std::cout << "version " << network.version() << ", " << network.size() << " lines, " << network.num_points()
+                  << " points." << std::endl;
+        if (result.valid()) {
+            std::cout << "line " << result.line_id << ", distance " << result.distance << ", project distance "
+                      << result.project_distance << std::endl;
+        } else {
+            std::cout << "no line within search radius." << std::endl;
+        }
+        return 0;
+    }
+
+    std::cerr << "usage: " << argv[0] << " publish <name> <lines.wkt>\n"
+              << "       " << argv[0] << " remove <name>\n"
+              << "       " << argv[0] << " query <name> <lon> <lat>" << std::endl;
+    return 1;
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+
+#include "simplegeom/simplegeom.h"
+#include "simplegeom/trace.h"
+
+// 离线回放投影服务记录的调用轨迹，报告吞吐量与延迟分布
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <lines.wkt> <trace.bin> [full|original] [threads=1] [speed=1]"
+                  << std::endl;
+        return 1;
+    }
+
+    simplegeom::LineNetwork<simplegeom::PointGeo2> network(
+        simplegeom::read_wkt_file<simplegeom::LineString<simplegeom::PointGeo2>>(argv[1]));
+    auto events = simplegeom::read_trace(argv[2]);
+    std::cout << "loaded " << network.size() << " lines and " << events.size() << " events." << std::endl;
+
+    simplegeom::TraceReplayOptions options;
+    if (argc > 3) {
+        std::string timing = argv[3];
+        if (timing != "full" && timing != "original") {
+            std::cerr << "unknown timing: " << timing << std::endl;
+            return 1;
+        }
+        options.original_timing = timing == "original";
+    }
+    if (argc > 4) {
+        options.num_threads = std::stoul(argv[4]);
+    }
+    if (argc > 5) {
+        options.speed = std::stod(argv[5]);
+    }
+
+    auto stats = simplegeom::replay_trace(network, events, options);
+    std::cout << "replayed " << stats.events << " events in " << stats.seconds << "s, throughput "
+              << stats.throughput() << " calls/s." << std::endl;
+    std::cout << "latency p50: " << stats.percentile(0.5) << "us, p90: " << stats.percentile(0.9)
+              << "us, p99: " << stats.percentile(0.99) << "us, p99.9: " << stats.percentile(0.999)
+              << "us, max: " << stats.percentile(1.) << "us." << std::endl;
+    if (stats.invalid > 0) {
+        std::cout << stats.invalid << " events refer to lines outside the network." << std::endl;
+    }
+}